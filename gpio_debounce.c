@@ -0,0 +1,207 @@
+/**
+ * @file gpio_debounce.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_debounce.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+#include "gpio_timestamp.h"
+
+#if CONFIG_GPIO_DRIVERS_DEBOUNCE
+
+#define GPIO_DEBOUNCE_PERCENTILE CONFIG_GPIO_DRIVERS_DEBOUNCE_PERCENTILE
+
+// Step of the percentile estimate: 1/8 of the estimate plus 1/8 of the
+// shortest window, so it can leave 0
+#define GPIO_DEBOUNCE_STEP_SHIFT 3
+
+// Margin of the window over the percentile: 1/4
+#define GPIO_DEBOUNCE_MARGIN_SHIFT 2
+
+// Debounce of one pin, in CPU cycles. Guarded by s_debounce_lock
+typedef struct
+{
+  uint32_t min;
+  uint32_t max;
+  uint32_t window;
+  uint32_t estimate;    /**< Running percentile of the burst durations */
+  uint64_t accepted;    /**< Timestamp of the last edge passed on */
+  uint64_t burst_start; /**< Timestamp of the first edge of the burst */
+  uint64_t burst_last;  /**< Timestamp of the last edge */
+  uint32_t last_burst;
+  uint32_t max_burst;
+  uint32_t bursts;
+  uint32_t debounced;
+  bool started; /**< An edge was seen */
+} gpio_debounce_pin_t;
+
+static gpio_debounce_pin_t s_debounce[GPIO_NUM_MAX] = {0};
+static uint64_t s_debounce_pins = 0;
+static uint32_t s_debounce_mhz = 0;
+static gpio_drv_lock_t s_debounce_lock = GPIO_DRV_LOCK_INITIALIZER;
+
+// Move the estimate towards the percentile: up by p% of a step when the
+// burst is longer, down by (100 - p)% otherwise, so it settles where p% of
+// the bursts are shorter
+static void IRAM_ATTR gpio_debounce_learn(gpio_debounce_pin_t *db,
+                                         uint32_t burst)
+{
+  uint32_t step = (db->estimate >> GPIO_DEBOUNCE_STEP_SHIFT) +
+                  (db->min >> GPIO_DEBOUNCE_STEP_SHIFT) + 1;
+
+  if (burst > db->estimate)
+  {
+    uint32_t up = step * GPIO_DEBOUNCE_PERCENTILE / 100;
+    db->estimate += up < burst - db->estimate ? up : burst - db->estimate;
+  }
+  else
+  {
+    uint32_t down = step * (100 - GPIO_DEBOUNCE_PERCENTILE) / 100;
+    db->estimate -= down < db->estimate - burst ? down : db->estimate - burst;
+  }
+
+  uint32_t window =
+      db->estimate + (db->estimate >> GPIO_DEBOUNCE_MARGIN_SHIFT);
+  db->window = window < db->min ? db->min
+               : window > db->max ? db->max
+                                  : window;
+
+  db->last_burst = burst;
+  if (burst > db->max_burst)
+    db->max_burst = burst;
+  db->bursts++;
+}
+
+bool IRAM_ATTR gpio_drv_debounce(uint32_t pin)
+{
+  if (!(__atomic_load_n(&s_debounce_pins, __ATOMIC_RELAXED) & (1ULL << pin)))
+    return false;
+
+  uint64_t now = gpio_ts_now();
+  bool drop = false;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_debounce_lock);
+  gpio_debounce_pin_t *db = &s_debounce[pin];
+  bool first = !db->started;
+
+  // A quiet period of max ends the burst
+  if (first || now - db->burst_last >= db->max)
+  {
+    if (!first && db->min != db->max)
+      gpio_debounce_learn(db, (uint32_t)(db->burst_last - db->burst_start));
+    db->burst_start = now;
+    db->started = true;
+  }
+  db->burst_last = now;
+
+  if (!first && now - db->accepted < db->window)
+  {
+    db->debounced++;
+    drop = true;
+  }
+  else
+  {
+    db->accepted = now;
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_debounce_lock);
+
+  return drop;
+}
+
+esp_err_t gpio_set_debounce(gpio_t *self, uint32_t min_us, uint32_t max_us)
+{
+  if (self == NULL || !GPIO_IS_VALID_GPIO(self->pin) || min_us > max_us)
+    return ESP_ERR_INVALID_ARG;
+
+  uint32_t mhz = GPIO_DRV_CPU_MHZ();
+  if ((uint64_t)max_us * mhz > UINT32_MAX / 2)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t bit = 1ULL << self->pin;
+  GPIO_DRV_ENTER_CRITICAL(&s_debounce_lock);
+  s_debounce_mhz = mhz;
+  s_debounce[self->pin] = (gpio_debounce_pin_t){
+      .min = min_us * mhz,
+      .max = max_us * mhz,
+      .window = min_us * mhz,
+  };
+  if (max_us == 0)
+    __atomic_fetch_and(&s_debounce_pins, ~bit, __ATOMIC_RELAXED);
+  else
+    __atomic_fetch_or(&s_debounce_pins, bit, __ATOMIC_RELAXED);
+  GPIO_DRV_EXIT_CRITICAL(&s_debounce_lock);
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_get_debounce(gpio_pinout_t pin, gpio_debounce_stats_t *stats)
+{
+  if (stats == NULL || !GPIO_IS_VALID_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+  if (!(__atomic_load_n(&s_debounce_pins, __ATOMIC_RELAXED) & (1ULL << pin)))
+    return ESP_ERR_INVALID_STATE;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_debounce_lock);
+  gpio_debounce_pin_t db = s_debounce[pin];
+  uint32_t mhz = s_debounce_mhz;
+  GPIO_DRV_EXIT_CRITICAL(&s_debounce_lock);
+
+  *stats = (gpio_debounce_stats_t){
+      .window_us = db.window / mhz,
+      .percentile_us = db.estimate / mhz,
+      .last_burst_us = db.last_burst / mhz,
+      .max_burst_us = db.max_burst / mhz,
+      .bursts = db.bursts,
+      .debounced = db.debounced,
+  };
+
+  return ESP_OK;
+}
+
+uint64_t gpio_get_debounce_saturated(void)
+{
+  uint64_t saturated = 0;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_debounce_lock);
+  for (uint64_t pins = s_debounce_pins; pins; pins &= pins - 1)
+  {
+    const gpio_debounce_pin_t *db = &s_debounce[__builtin_ctzll(pins)];
+    if (db->min != db->max && db->window >= db->max)
+      saturated |= pins & -pins;
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_debounce_lock);
+
+  return saturated;
+}
+
+#else
+
+esp_err_t gpio_set_debounce(gpio_t *self, uint32_t min_us, uint32_t max_us)
+{
+  (void)self;
+  (void)min_us;
+  (void)max_us;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_get_debounce(gpio_pinout_t pin, gpio_debounce_stats_t *stats)
+{
+  (void)pin;
+  (void)stats;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+uint64_t gpio_get_debounce_saturated(void)
+{
+  return 0;
+}
+
+#endif
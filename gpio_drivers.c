@@ -15,103 +15,698 @@
 #include <stdbool.h>
 #include <string.h>
 
-#define GPIO_ISR_SERVICE_DEFAULT_FLAGS 0
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
 
 static const char *TAG = "GPIO";
 
 static bool isr_service_installed = false;
 
-static gpio_t *s_gpio_instance = NULL;
+#if CONFIG_GPIO_DRIVERS_VPINS
+#define GPIO_REGISTRY_SIZE (GPIO_VPIN_BASE + CONFIG_GPIO_DRIVERS_VPIN_COUNT)
+#else
+#define GPIO_REGISTRY_SIZE GPIO_NUM_MAX
+#endif
 
-esp_err_t gpio_set_config_output(gpio_pinout_t pin)
+// Pin registry, indexed by GPIO or virtual pin number and shared by both
+// cores
+static gpio_t *s_gpio_registry[GPIO_REGISTRY_SIZE] = {NULL};
+static gpio_drv_lock_t s_gpio_lock = GPIO_DRV_LOCK_INITIALIZER;
+
+#if CONFIG_GPIO_DRIVERS_METRICS
+// Counters of the registry pins, one copy per core
+gpio_drv_metrics_slot_t gpio_drv_metrics[GPIO_DRV_CORES][GPIO_NUM_MAX] = {0};
+#endif
+
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+static gpio_skew_stats_t s_skew_stats = {0};
+#endif
+
+// Configuration applied by the driver, for the sleep snapshots. Guarded by
+// s_gpio_lock
+static gpio_drv_config_t s_gpio_config = {0};
+
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+// Level of each input at its last interrupt, plus one (0: none yet), the
+// cycle count of its last expected edge, its declared period in cycles, and
+// the checks. Only written by the ISRs, which all run on the ISR service
+// core, and by the resets
+static uint8_t s_edge_level[GPIO_NUM_MAX] = {0};
+static uint32_t s_edge_grid[GPIO_NUM_MAX] = {0};
+static uint32_t s_edge_period[GPIO_NUM_MAX] = {0};
+static gpio_edge_check_t s_edge_check[GPIO_NUM_MAX] = {0};
+static uint64_t s_edge_flags = 0;
+#endif
+
+#ifndef CONFIG_GPIO_DRIVERS_PIN_POOL_SIZE
+#define CONFIG_GPIO_DRIVERS_PIN_POOL_SIZE 0
+#endif
+#define GPIO_PIN_POOL_SIZE CONFIG_GPIO_DRIVERS_PIN_POOL_SIZE
+
+#if GPIO_PIN_POOL_SIZE > 0
+// Pin objects for gpio_alloc(), guarded by s_gpio_lock
+static gpio_t s_gpio_pool[GPIO_PIN_POOL_SIZE];
+static uint64_t s_gpio_pool_used = 0;
+static uint32_t s_gpio_pool_high_water = 0;
+#endif
+
+// Add an ISR handler and track it for the sleep snapshots
+static esp_err_t gpio_attach_isr(gpio_pinout_t pin, void isr_handler(void *),
+                                 void *isr_handler_arg)
+{
+  esp_err_t err = gpio_isr_handler_add(pin, isr_handler, isr_handler_arg);
+  if (err == ESP_OK)
+  {
+    GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+    s_gpio_config.isrs |= 1ULL << pin;
+    GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+  }
+
+  return err;
+}
+
+esp_err_t gpio_drv_config_outputs(uint64_t pin_mask, bool readback)
 {
-  gpio_config_t io_conf = {.pin_bit_mask = (1ULL << pin),
-                           .mode = GPIO_MODE_OUTPUT,
+  gpio_config_t io_conf = {.pin_bit_mask = pin_mask,
+                           .mode = readback ? GPIO_MODE_INPUT_OUTPUT
+                                            : GPIO_MODE_OUTPUT,
                            .pull_up_en = GPIO_PULLUP_DISABLE,
                            .pull_down_en = GPIO_PULLDOWN_DISABLE,
                            .intr_type = GPIO_INTR_DISABLE};
 
-  ESP_ERROR_CHECK(gpio_config(&io_conf));
+  esp_err_t err = gpio_config(&io_conf);
+  if (err != ESP_OK)
+    return err;
 
-  ESP_LOGI(TAG, "Configured pin %d as output", pin);
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  s_gpio_config.outputs |= pin_mask;
+  if (readback)
+    s_gpio_config.inputs |= pin_mask;
+  else
+    s_gpio_config.inputs &= ~pin_mask;
+  s_gpio_config.pull_ups &= ~pin_mask;
+  s_gpio_config.pull_downs &= ~pin_mask;
+  s_gpio_config.isrs &= ~pin_mask;
+  s_gpio_config.latches &= ~pin_mask;
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+    s_gpio_config.intr_type[__builtin_ctzll(pins)] = GPIO_INTR_DISABLE;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+    gpio_drv_metric_inc(__builtin_ctzll(pins), reconfigs);
 
   return ESP_OK;
 }
 
-esp_err_t gpio_set_config_input(gpio_pinout_t pin, void isr_handler(void *),
-                                void *isr_handler_arg)
+esp_err_t gpio_set_config_output_nolog(gpio_pinout_t pin)
 {
+  if (!GPIO_IS_VALID_OUTPUT_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+
+  return gpio_drv_config_outputs(1ULL << pin, false);
+}
+
+esp_err_t gpio_set_config_output(gpio_pinout_t pin)
+{
+  ESP_ERROR_CHECK(gpio_set_config_output_nolog(pin));
+
+  GPIO_DRV_LOGI(TAG, "Configured pin %d as output", pin);
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_config_input_nolog(gpio_pinout_t pin,
+                                      void isr_handler(void *),
+                                      void *isr_handler_arg)
+{
+  if (!GPIO_IS_VALID_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+
   gpio_config_t io_conf = {.pin_bit_mask = (1ULL << (uint8_t)pin),
                            .mode = GPIO_MODE_INPUT,
                            .pull_up_en = GPIO_PULLUP_ENABLE,
                            .pull_down_en = GPIO_PULLDOWN_DISABLE,
                            .intr_type = GPIO_INTR_NEGEDGE};
 
-  ESP_ERROR_CHECK(gpio_config(&io_conf));
-  ESP_LOGI(TAG, "Configured pin %d as input", pin);
+  esp_err_t err = gpio_config(&io_conf);
+  if (err != ESP_OK)
+    return err;
+
+  uint64_t bit = 1ULL << pin;
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  s_gpio_config.inputs |= bit;
+  s_gpio_config.outputs &= ~bit;
+  s_gpio_config.pull_ups |= bit;
+  s_gpio_config.pull_downs &= ~bit;
+  s_gpio_config.isrs &= ~bit;
+  s_gpio_config.latches &= ~bit;
+  s_gpio_config.intr_type[pin] = io_conf.intr_type;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  s_edge_level[pin] = 0;
+  s_edge_period[pin] = 0;
+#endif
+
+  gpio_drv_metric_inc(pin, reconfigs);
 
   if (isr_handler == NULL)
     return ESP_OK;
 
-  ESP_ERROR_CHECK(gpio_isr_handler_add(pin, isr_handler, isr_handler_arg));
-  ESP_LOGI(TAG, "Configured ISR handler for pin %d", pin);
+  return gpio_attach_isr(pin, isr_handler, isr_handler_arg);
+}
+
+esp_err_t gpio_set_config_input(gpio_pinout_t pin, void isr_handler(void *),
+                                void *isr_handler_arg)
+{
+  ESP_ERROR_CHECK(
+      gpio_set_config_input_nolog(pin, isr_handler, isr_handler_arg));
+  GPIO_DRV_LOGI(TAG, "Configured pin %d as input", pin);
+
+  if (isr_handler != NULL)
+    GPIO_DRV_LOGI(TAG, "Configured ISR handler for pin %d", pin);
 
   return ESP_OK;
 }
 
-esp_err_t gpio_write(gpio_t *self, gpio_state_t state)
+// Pins that can have an entry in the registry
+static inline bool gpio_registrable(int pin)
 {
-  gpio_set_level(self->pin, (uint32_t)state);
+#if CONFIG_GPIO_DRIVERS_VPINS
+  if (GPIO_DRV_IS_VPIN(pin))
+    return gpio_vport_from_pin(pin) != NULL;
+#endif
+  return GPIO_IS_VALID_GPIO(pin);
+}
+
+// Native backend: GPIO 0 to GPIO_NUM_MAX - 1 straight through the W1TS/W1TC
+// registers (those of the simulator on the host)
+static esp_err_t gpio_native_init(gpio_t *self, bool log, bool configure);
+
+static inline esp_err_t IRAM_ATTR gpio_native_write(uint32_t pin,
+                                                    uint32_t level)
+{
+  if (pin >= GPIO_NUM_MAX || !GPIO_IS_VALID_OUTPUT_GPIO((int)pin))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_drv_ll_write_pin(pin, level);
+  gpio_drv_metric_inc(pin, writes);
   return ESP_OK;
 }
 
+static inline uint32_t IRAM_ATTR gpio_native_read(uint32_t pin)
+{
+  return pin < GPIO_NUM_MAX ? gpio_drv_ll_read_pin(pin) : 0;
+}
+
+static inline void IRAM_ATTR gpio_native_toggle(uint32_t pin)
+{
+  if (pin >= GPIO_NUM_MAX)
+    return;
+
+  // Read the output register, not the input one (0 on output-only pins), and
+  // keep the read-then-write atomic against the other core and the ISRs
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  uint32_t level = gpio_drv_ll_read_output_pin(pin);
+  gpio_drv_ll_write_pin(pin, !level);
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+  gpio_drv_metric_inc(pin, toggles);
+}
+
+#if GPIO_DRV_BACKENDS > 1
+// Pin numbers are split in ranges of 64, each owned by one backend: the
+// native pins, then the virtual pins from GPIO_VPIN_BASE
+#define GPIO_BACKEND_RANGE_SHIFT 6
+#define GPIO_BACKEND_RANGES                                                   \
+  ((GPIO_REGISTRY_SIZE + (1 << GPIO_BACKEND_RANGE_SHIFT) - 1) >>              \
+   GPIO_BACKEND_RANGE_SHIFT)
+
+static const DRAM_ATTR gpio_drv_backend_t s_native_backend = {
+    .init = gpio_native_init,
+    .write = gpio_native_write,
+    .read = gpio_native_read,
+    .toggle = gpio_native_toggle,
+};
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+_Static_assert(GPIO_VPIN_BASE == 1 << GPIO_BACKEND_RANGE_SHIFT,
+               "the virtual pins must start at the second range");
+#endif
+
+// Backend of each range, in DRAM for the IRAM handle functions
+static const gpio_drv_backend_t *const DRAM_ATTR
+    s_gpio_backends[GPIO_BACKEND_RANGES] = {
+        [0] = &s_native_backend,
+#if CONFIG_GPIO_DRIVERS_VPINS
+        [1 ... GPIO_BACKEND_RANGES - 1] = &gpio_drv_vport_backend,
+#endif
+};
+
+static inline const gpio_drv_backend_t *IRAM_ATTR gpio_backend_of(uint32_t pin)
+{
+  // Numbers past the last range go to the native backend, which rejects them
+  uint32_t range = pin >> GPIO_BACKEND_RANGE_SHIFT;
+  return range < GPIO_BACKEND_RANGES ? s_gpio_backends[range]
+                                     : &s_native_backend;
+}
+
+#define GPIO_BACKEND_CALL(pin, op, ...) gpio_backend_of(pin)->op(__VA_ARGS__)
+#else
+// Native pins only: plain calls, inlined into the public functions
+#define GPIO_BACKEND_CALL(pin, op, ...) gpio_native_##op(__VA_ARGS__)
+#endif
+
+esp_err_t gpio_write(gpio_t *self, gpio_state_t state)
+{
+  return GPIO_BACKEND_CALL(self->pin, write, self->pin, state);
+}
+
 gpio_state_t gpio_read(gpio_t *self)
 {
-  return gpio_get_level(self->pin);
+  return GPIO_BACKEND_CALL(self->pin, read, self->pin) ? GPIO_STATE_HIGH
+                                                       : GPIO_STATE_LOW;
 }
 
-void gpio_toggle(gpio_t *self)
+
+esp_err_t IRAM_ATTR gpio_write_mask(uint64_t pin_mask, uint64_t levels)
 {
-  gpio_state_t state = gpio_read(self);
-  gpio_write(self, state == GPIO_STATE_LOW ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+  uint32_t skew = gpio_drv_ll_write(levels & pin_mask, ~levels & pin_mask);
+  gpio_drv_skew_record(skew);
+  return ESP_OK;
 }
 
-// TODO: Finish GPIO driver implementation
-void gpio_init_impl(gpio_t *self)
+uint64_t IRAM_ATTR gpio_read_mask(uint64_t pin_mask)
 {
-  s_gpio_instance = self;
-  s_gpio_instance->get_state = &gpio_read;
-  s_gpio_instance->set_state = &gpio_write;
-  //s_gpio_instance->toggle = &gpio_toggle;
+  return gpio_drv_ll_read() & pin_mask;
+}
 
-  switch (s_gpio_instance->_mode)
+void IRAM_ATTR gpio_toggle(gpio_t *self)
+{
+  GPIO_BACKEND_CALL(self->pin, toggle, self->pin);
+}
+
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+static void IRAM_ATTR gpio_edge_check(uint32_t pin, uint32_t level,
+                                      uint32_t now)
+{
+  gpio_edge_check_t *check = &s_edge_check[pin];
+  uint32_t last = s_edge_level[pin];
+  uint32_t period = s_edge_period[pin];
+  bool any_edge = s_gpio_config.intr_type[pin] == GPIO_INTR_ANYEDGE;
+  s_edge_level[pin] = level + 1;
+  check->interrupts++;
+
+  if (last == 0)
+  {
+    s_edge_grid[pin] = now;
+    return;
+  }
+
+  uint32_t lost;
+  if (period != 0)
+  {
+    // Edges since the last expected one, to the nearest (which may be up to
+    // half a period ahead); on any edge, the levels tell whether their
+    // number is odd
+    int32_t elapsed = (int32_t)(now - s_edge_grid[pin]);
+    uint32_t edges = 0;
+    bool up = false;
+    if (elapsed > 0)
+    {
+      up = (uint32_t)elapsed % period >= period / 2;
+      edges = (uint32_t)elapsed / period + up;
+    }
+    if (any_edge && (edges & 1) != (last != level + 1))
+      edges = (up && edges > 1) ? edges - 1 : edges + 1;
+
+    if (edges == 0)
+    {
+      // Sooner than the period allows: restart the grid here
+      s_edge_grid[pin] = now;
+      check->early++;
+      s_edge_flags |= 1ULL << pin;
+      return;
+    }
+    s_edge_grid[pin] += edges * period;
+    lost = edges - 1;
+  }
+  else if (any_edge)
+  {
+    // An edge latched again since the ISR service cleared the status may
+    // have come before the level read: the level then belongs to the next
+    // interrupt, which has nothing to compare with
+    if (gpio_drv_ll_intr_status(1ULL << pin) != 0)
+      s_edge_level[pin] = 0;
+
+    // The same level twice: an odd number of edges merged into one
+    lost = last == level + 1;
+  }
+  else
+  {
+    return;
+  }
+
+  if (lost == 0)
+    return;
+  check->lost += lost;
+  s_edge_flags |= 1ULL << pin;
+}
+#endif
+
+// The inputs set up by gpio_init_impl get their ISR handler through a
+// wrapper when it counts interrupts, checks, records or debounces edges
+#define GPIO_ISR_DISPATCH                                                     \
+  (CONFIG_GPIO_DRIVERS_METRICS || CONFIG_GPIO_DRIVERS_EDGE_EVENTS ||          \
+   CONFIG_GPIO_DRIVERS_EDGE_CHECK || CONFIG_GPIO_DRIVERS_DEBOUNCE)
+
+#if GPIO_ISR_DISPATCH
+static void IRAM_ATTR gpio_isr_dispatch(void *arg)
+{
+  gpio_t *self = arg;
+  void (*handler)(void *) = self->isr_handler;
+
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS || CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  // As close to the edge as the ISR gets
+  uint32_t level = gpio_drv_ll_read_pin(self->pin);
+#endif
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  gpio_edge_check(self->pin, level, GPIO_DRV_CYCLES());
+#endif
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS
+  gpio_drv_event_push(self->pin, level);
+#endif
+
+  if (handler == NULL)
+  {
+    gpio_drv_metric_inc(self->pin, dropped);
+    return;
+  }
+#if CONFIG_GPIO_DRIVERS_DEBOUNCE
+  if (gpio_drv_debounce(self->pin))
+  {
+    gpio_drv_metric_inc(self->pin, debounced);
+    return;
+  }
+#endif
+
+  gpio_drv_metric_inc(self->pin, interrupts);
+  handler(self->isr_handler_arg);
+}
+#endif
+
+static esp_err_t gpio_install_isr_service_once(bool log)
+{
+  if (__atomic_load_n(&isr_service_installed, __ATOMIC_ACQUIRE))
+  {
+    if (log)
+      GPIO_DRV_LOGI(TAG, "ISR service already installed");
+    return ESP_OK;
+  }
+
+  // Both cores may get here at once: the loser sees ESP_ERR_INVALID_STATE
+  esp_err_t err = gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    if (log)
+      GPIO_DRV_LOGI(TAG, "ISR service already installed");
+    err = ESP_OK;
+  }
+
+  if (err == ESP_OK)
+    __atomic_store_n(&isr_service_installed, true, __ATOMIC_RELEASE);
+
+  return err;
+}
+
+esp_err_t gpio_drv_isr_service_install(void)
+{
+  return gpio_install_isr_service_once(false);
+}
+
+#if CONFIG_IDF_TARGET_LINUX
+void gpio_drv_isr_service_reset(void)
+{
+  __atomic_store_n(&isr_service_installed, false, __ATOMIC_RELEASE);
+}
+#endif
+
+// Set up a GPIO object; with configure false, the pin is assumed to be
+// configured already (restored from a snapshot) and only the ISR handler of
+// an input is added
+static esp_err_t gpio_init_pin(gpio_t *self, bool log, bool configure)
+{
+  self->get_state = &gpio_read;
+  self->set_state = &gpio_write;
+  //self->toggle = &gpio_toggle;
+
+  if (gpio_registrable(self->pin))
+  {
+    GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+    s_gpio_registry[self->pin] = self;
+    GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+  }
+
+  return GPIO_BACKEND_CALL(self->pin, init, self, log, configure);
+}
+
+static esp_err_t gpio_native_init(gpio_t *self, bool log, bool configure)
+{
+  // The service must be up before an input pin adds its ISR handler
+  esp_err_t err = gpio_install_isr_service_once(log);
+  if (err != ESP_OK)
+    return err;
+
+  switch (self->_mode)
   {
     case GPIO_MODE_INPUT:
     {
-      gpio_set_config_input(s_gpio_instance->pin, s_gpio_instance->isr_handler,
-                            NULL);
-      break;
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS
+      // Every input records its edges, with or without a handler
+      void (*handler)(void *) = gpio_isr_dispatch;
+      void *arg = self;
+#elif CONFIG_GPIO_DRIVERS_METRICS || CONFIG_GPIO_DRIVERS_EDGE_CHECK ||     \
+    CONFIG_GPIO_DRIVERS_DEBOUNCE
+      void (*handler)(void *) = self->isr_handler ? gpio_isr_dispatch : NULL;
+      void *arg = self;
+#else
+      void (*handler)(void *) = self->isr_handler;
+      void *arg = self->isr_handler_arg;
+#endif
+      if (!configure)
+        return handler ? gpio_attach_isr(self->pin, handler, arg) : ESP_OK;
+
+      return log ? gpio_set_config_input(self->pin, handler, arg)
+                 : gpio_set_config_input_nolog(self->pin, handler, arg);
     }
     case GPIO_MODE_OUTPUT:
     {
-      gpio_set_config_output(s_gpio_instance->pin);
-      gpio_write(s_gpio_instance, s_gpio_instance->_act_state);
-      break;
+      if (!configure)
+        return GPIO_IS_VALID_OUTPUT_GPIO(self->pin) ? ESP_OK
+                                                    : ESP_ERR_INVALID_ARG;
+
+      err = log ? gpio_set_config_output(self->pin)
+                : gpio_set_config_output_nolog(self->pin);
+      if (err == ESP_OK)
+        gpio_write(self, self->_act_state);
+      return err;
     }
     default:
     {
-      ESP_LOGE(TAG, "Invalid GPIO mode");
-      break;
+      return ESP_ERR_INVALID_ARG;
     }
   }
+}
 
-  if (!isr_service_installed)
+// TODO: Finish GPIO driver implementation
+void gpio_init_impl(gpio_t *self)
+{
+  esp_err_t err = gpio_init_pin(self, true, true);
+  if (err == ESP_ERR_INVALID_ARG)
+    GPIO_DRV_LOGE(TAG, "Invalid GPIO %d or mode", self->pin);
+  else
+    ESP_ERROR_CHECK(err);
+}
+
+esp_err_t gpio_init_impl_nolog(gpio_t *self)
+{
+  return gpio_init_pin(self, false, true);
+}
+
+esp_err_t gpio_attach_impl(gpio_t *self)
+{
+  return gpio_init_pin(self, false, false);
+}
+
+esp_err_t gpio_set_hold(gpio_t *self, bool hold)
+{
+  if (!GPIO_IS_VALID_GPIO(self->pin))
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = hold ? gpio_hold_en(self->pin) : gpio_hold_dis(self->pin);
+  if (err != ESP_OK)
+    return err;
+
+  uint64_t bit = 1ULL << self->pin;
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  if (hold)
+    s_gpio_config.holds |= bit;
+  else
+    s_gpio_config.holds &= ~bit;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  return ESP_OK;
+}
+
+void gpio_drv_get_config(gpio_drv_config_t *config)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  *config = s_gpio_config;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+}
+
+void gpio_drv_set_config(const gpio_drv_config_t *config)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  s_gpio_config = *config;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+}
+
+gpio_t *gpio_get_instance(gpio_pinout_t pin)
+{
+  if (!gpio_registrable(pin))
+    return NULL;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  gpio_t *instance = s_gpio_registry[pin];
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  return instance;
+}
+
+gpio_hdl_t gpio_get_handle(const gpio_t *self)
+{
+  if (self == NULL || !gpio_registrable(self->pin))
+    return GPIO_HDL_INVALID;
+
+  return gpio_get_instance(self->pin) == self ? (gpio_hdl_t)self->pin
+                                              : GPIO_HDL_INVALID;
+}
+
+gpio_t *gpio_from_handle(gpio_hdl_t hdl)
+{
+  return hdl < GPIO_REGISTRY_SIZE ? gpio_get_instance(hdl) : NULL;
+}
+
+esp_err_t IRAM_ATTR gpio_write_h(gpio_hdl_t hdl, gpio_state_t state)
+{
+  return GPIO_BACKEND_CALL(hdl, write, hdl, state);
+}
+
+gpio_state_t IRAM_ATTR gpio_read_h(gpio_hdl_t hdl)
+{
+  return GPIO_BACKEND_CALL(hdl, read, hdl) ? GPIO_STATE_HIGH : GPIO_STATE_LOW;
+}
+
+void IRAM_ATTR gpio_toggle_h(gpio_hdl_t hdl)
+{
+  GPIO_BACKEND_CALL(hdl, toggle, hdl);
+}
+
+gpio_t *gpio_alloc(void)
+{
+#if GPIO_PIN_POOL_SIZE > 0
+  gpio_t *self = NULL;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  uint64_t free_slots = ~s_gpio_pool_used &
+                        (UINT64_MAX >> (64 - GPIO_PIN_POOL_SIZE));
+  if (free_slots != 0)
+  {
+    int slot = __builtin_ctzll(free_slots);
+    s_gpio_pool_used |= 1ULL << slot;
+
+    uint32_t used = (uint32_t)__builtin_popcountll(s_gpio_pool_used);
+    if (used > s_gpio_pool_high_water)
+      s_gpio_pool_high_water = used;
+
+    self = &s_gpio_pool[slot];
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  if (self != NULL)
+    memset(self, 0, sizeof(*self));
+
+  return self;
+#else
+  return NULL;
+#endif
+}
+
+esp_err_t gpio_free(gpio_t *self)
+{
+#if GPIO_PIN_POOL_SIZE > 0
+  if (self < &s_gpio_pool[0] || self >= &s_gpio_pool[GPIO_PIN_POOL_SIZE])
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+  uint64_t bit = 1ULL << (self - s_gpio_pool);
+
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  if (!(s_gpio_pool_used & bit))
   {
-    ESP_ERROR_CHECK(gpio_install_isr_service(GPIO_ISR_SERVICE_DEFAULT_FLAGS));
-    isr_service_installed = true;
+    err = ESP_ERR_INVALID_ARG;
   }
   else
-    ESP_LOGI(TAG, "ISR service already installed");
+  {
+    if (gpio_registrable(self->pin) && s_gpio_registry[self->pin] == self)
+      s_gpio_registry[self->pin] = NULL;
+    s_gpio_pool_used &= ~bit;
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  return err;
+#else
+  (void)self;
+  return ESP_ERR_INVALID_ARG;
+#endif
+}
+
+esp_err_t gpio_get_pool_stats(gpio_pool_t pool, gpio_pool_stats_t *stats)
+{
+  if (stats == NULL || pool >= GPIO_POOL_MAX)
+    return ESP_ERR_INVALID_ARG;
+
+  switch (pool)
+  {
+#if GPIO_PIN_POOL_SIZE > 0
+    case GPIO_POOL_PINS:
+    {
+      GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+      stats->capacity = GPIO_PIN_POOL_SIZE;
+      stats->used = (uint32_t)__builtin_popcountll(s_gpio_pool_used);
+      stats->high_water = s_gpio_pool_high_water;
+      GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+      return ESP_OK;
+    }
+#endif
+#if CONFIG_GPIO_DRIVERS_DEFERRED_LOG
+    case GPIO_POOL_LOG:
+    {
+      gpio_drv_log_pool_stats(stats);
+      return ESP_OK;
+    }
+#endif
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS
+    case GPIO_POOL_EVENTS:
+    {
+      gpio_drv_event_pool_stats(stats);
+      return ESP_OK;
+    }
+#endif
+    default:
+    {
+      return ESP_ERR_NOT_SUPPORTED;
+    }
+  }
 }
 
 esp_err_t gpio_disable_isr(gpio_t *self)
@@ -121,5 +716,191 @@ esp_err_t gpio_disable_isr(gpio_t *self)
 
 esp_err_t gpio_enable_isr(gpio_t *self)
 {
-  return gpio_intr_enable(self->pin);
+  esp_err_t err = gpio_intr_enable(self->pin);
+  if (err == ESP_OK)
+  {
+    GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+    s_gpio_config.latches &= ~(1ULL << self->pin);
+    GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+  }
+
+  return err;
+}
+
+static bool gpio_is_edge_type(gpio_int_type_t type)
+{
+  return type == GPIO_INTR_POSEDGE || type == GPIO_INTR_NEGEDGE ||
+         type == GPIO_INTR_ANYEDGE;
+}
+
+esp_err_t gpio_set_edge(gpio_t *self, gpio_int_type_t type)
+{
+  if (self == NULL || !GPIO_IS_VALID_GPIO(self->pin) ||
+      !gpio_is_edge_type(type))
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = gpio_set_intr_type(self->pin, type);
+  if (err != ESP_OK)
+    return err;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  s_gpio_config.intr_type[self->pin] = type;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  s_edge_level[self->pin] = 0;
+#endif
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_edge_period(gpio_t *self, uint32_t period_ns)
+{
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  if (self == NULL || !GPIO_IS_VALID_GPIO(self->pin))
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t period = (uint64_t)period_ns * GPIO_DRV_CPU_MHZ() / 1000;
+  if (period_ns != 0 && (period == 0 || period > INT32_MAX))
+    return ESP_ERR_INVALID_ARG;
+
+  s_edge_period[self->pin] = (uint32_t)period;
+  s_edge_level[self->pin] = 0;
+  return ESP_OK;
+#else
+  (void)self;
+  (void)period_ns;
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t gpio_set_latch(gpio_t *self, gpio_int_type_t type)
+{
+  if (self == NULL || !GPIO_IS_VALID_GPIO(self->pin) ||
+      !gpio_is_edge_type(type))
+    return ESP_ERR_INVALID_ARG;
+
+  // Mask the CPU interrupt before the type, so no edge reaches the ISR
+  // service, which would clear its status bit
+  esp_err_t err = gpio_intr_disable(self->pin);
+  if (err == ESP_OK)
+    err = gpio_set_intr_type(self->pin, type);
+  if (err != ESP_OK)
+    return err;
+
+  // Drop what the previous type latched
+  uint64_t bit = 1ULL << self->pin;
+  gpio_drv_ll_intr_clear(bit);
+
+  GPIO_DRV_ENTER_CRITICAL(&s_gpio_lock);
+  s_gpio_config.latches |= bit;
+  s_gpio_config.intr_type[self->pin] = type;
+  GPIO_DRV_EXIT_CRITICAL(&s_gpio_lock);
+
+  return ESP_OK;
+}
+
+uint64_t IRAM_ATTR gpio_poll_edges(uint64_t pin_mask)
+{
+  // Clear only the bits read: an edge landing between both accesses stays
+  // latched for the next poll
+  uint64_t edges = gpio_drv_ll_intr_status(pin_mask);
+  gpio_drv_ll_intr_clear(edges);
+
+  return edges;
+}
+
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+void IRAM_ATTR gpio_drv_skew_record(uint32_t cycles)
+{
+  s_skew_stats.last = cycles;
+  if (cycles > s_skew_stats.max)
+    s_skew_stats.max = cycles;
+  s_skew_stats.writes++;
+}
+#endif
+
+esp_err_t gpio_get_write_skew(gpio_skew_stats_t *stats)
+{
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+  if (stats == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  *stats = s_skew_stats;
+  return ESP_OK;
+#else
+  (void)stats;
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t gpio_get_metrics(gpio_pinout_t pin, gpio_metrics_t *metrics)
+{
+#if CONFIG_GPIO_DRIVERS_METRICS
+  if (metrics == NULL || !GPIO_IS_VALID_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+
+  memset(metrics, 0, sizeof(*metrics));
+  for (int core = 0; core < GPIO_DRV_CORES; core++)
+  {
+    const gpio_metrics_t *slot = &gpio_drv_metrics[core][pin].counters;
+    metrics->writes += slot->writes;
+    metrics->toggles += slot->toggles;
+    metrics->interrupts += slot->interrupts;
+    metrics->dropped += slot->dropped;
+    metrics->debounced += slot->debounced;
+    metrics->reconfigs += slot->reconfigs;
+  }
+
+  return ESP_OK;
+#else
+  (void)pin;
+  (void)metrics;
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t gpio_reset_metrics(void)
+{
+#if CONFIG_GPIO_DRIVERS_METRICS
+  memset(gpio_drv_metrics, 0, sizeof(gpio_drv_metrics));
+  return ESP_OK;
+#else
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t gpio_get_edge_check(gpio_pinout_t pin, gpio_edge_check_t *check)
+{
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  if (check == NULL || !GPIO_IS_VALID_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+
+  *check = s_edge_check[pin];
+  return ESP_OK;
+#else
+  (void)pin;
+  (void)check;
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+uint64_t gpio_get_edge_check_flags(void)
+{
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  return s_edge_flags;
+#else
+  return 0;
+#endif
+}
+
+esp_err_t gpio_reset_edge_check(void)
+{
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+  memset(s_edge_level, 0, sizeof(s_edge_level));
+  memset(s_edge_check, 0, sizeof(s_edge_check));
+  s_edge_flags = 0;
+  return ESP_OK;
+#else
+  return ESP_ERR_NOT_SUPPORTED;
+#endif
 }
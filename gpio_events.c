@@ -0,0 +1,149 @@
+/**
+ * @file gpio_events.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_events.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+#include "gpio_timestamp.h"
+
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS
+
+#define GPIO_EVENT_RING_SIZE CONFIG_GPIO_DRIVERS_EDGE_EVENTS_ENTRIES
+#define GPIO_EVENT_RING_MASK (GPIO_EVENT_RING_SIZE - 1)
+
+_Static_assert((GPIO_EVENT_RING_SIZE & GPIO_EVENT_RING_MASK) == 0,
+               "CONFIG_GPIO_DRIVERS_EDGE_EVENTS_ENTRIES must be a power of 2");
+
+typedef struct
+{
+  uint32_t seq; /**< Ring position this entry is ready for, as in gpio_log.c */
+  int64_t time; /**< esp_timer time, or gpio_ts_now() with TIMESTAMP */
+  uint8_t pin;
+  uint8_t level;
+} gpio_event_entry_t;
+
+// Same bounded multi-producer ring as the deferred log: the ISRs of both
+// cores claim positions with a CAS on head, the consumer owns tail
+typedef struct
+{
+  gpio_event_entry_t entries[GPIO_EVENT_RING_SIZE];
+  uint32_t head;
+  uint32_t tail;
+  uint32_t dropped;
+  uint32_t high_water; /**< Most entries pending at a pop */
+} gpio_event_ring_t;
+
+static gpio_event_ring_t s_event_ring = {0};
+
+#define GPIO_EVENT_LAP(pos) ((pos) & ~(uint32_t)GPIO_EVENT_RING_MASK)
+
+void IRAM_ATTR gpio_drv_event_push(uint32_t pin, uint32_t level)
+{
+#if CONFIG_GPIO_DRIVERS_TIMESTAMP
+  int64_t now = (int64_t)gpio_ts_now();
+#else
+  int64_t now = GPIO_DRV_TIME_US();
+#endif
+  gpio_event_entry_t *entry;
+  uint32_t pos = __atomic_load_n(&s_event_ring.head, __ATOMIC_RELAXED);
+
+  for (;;)
+  {
+    entry = &s_event_ring.entries[pos & GPIO_EVENT_RING_MASK];
+    int32_t diff = (int32_t)(__atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE) -
+                             GPIO_EVENT_LAP(pos));
+
+    if (diff == 0)
+    {
+      if (__atomic_compare_exchange_n(&s_event_ring.head, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    }
+    else if (diff < 0)
+    {
+      __atomic_fetch_add(&s_event_ring.dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+    else
+    {
+      pos = __atomic_load_n(&s_event_ring.head, __ATOMIC_RELAXED);
+    }
+  }
+
+  entry->time = now;
+  entry->pin = (uint8_t)pin;
+  entry->level = (uint8_t)level;
+  __atomic_store_n(&entry->seq, GPIO_EVENT_LAP(pos) + 1, __ATOMIC_RELEASE);
+}
+
+bool gpio_event_pop(gpio_edge_event_t *event)
+{
+  uint32_t pos = s_event_ring.tail;
+  gpio_event_entry_t *entry = &s_event_ring.entries[pos & GPIO_EVENT_RING_MASK];
+
+  if (__atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE) != GPIO_EVENT_LAP(pos) + 1)
+    return false;
+
+  uint32_t pending = __atomic_load_n(&s_event_ring.head, __ATOMIC_RELAXED) - pos;
+  if (pending > GPIO_EVENT_RING_SIZE)
+    pending = GPIO_EVENT_RING_SIZE;
+  if (pending > s_event_ring.high_water)
+    __atomic_store_n(&s_event_ring.high_water, pending, __ATOMIC_RELAXED);
+
+  *event = (gpio_edge_event_t){
+      .time_us = entry->time,
+      .pin = entry->pin,
+      .level = entry->level,
+  };
+#if CONFIG_GPIO_DRIVERS_TIMESTAMP
+  // Split in the consumer: a 64-bit division has no place in the ISR
+  uint32_t cycles;
+  event->time_us = gpio_ts_to_us((uint64_t)entry->time, &cycles);
+  event->cycles = (uint16_t)cycles;
+#endif
+  __atomic_store_n(&entry->seq, GPIO_EVENT_LAP(pos) + GPIO_EVENT_RING_SIZE,
+                   __ATOMIC_RELEASE);
+  __atomic_store_n(&s_event_ring.tail, pos + 1, __ATOMIC_RELAXED);
+
+  return true;
+}
+
+uint32_t gpio_event_get_dropped(void)
+{
+  return __atomic_load_n(&s_event_ring.dropped, __ATOMIC_RELAXED);
+}
+
+void gpio_drv_event_pool_stats(gpio_pool_stats_t *stats)
+{
+  uint32_t used = __atomic_load_n(&s_event_ring.head, __ATOMIC_RELAXED) -
+                  __atomic_load_n(&s_event_ring.tail, __ATOMIC_RELAXED);
+
+  stats->capacity = GPIO_EVENT_RING_SIZE;
+  stats->used = used > GPIO_EVENT_RING_SIZE ? GPIO_EVENT_RING_SIZE : used;
+  stats->high_water =
+      __atomic_load_n(&s_event_ring.high_water, __ATOMIC_RELAXED);
+}
+
+#else
+
+bool gpio_event_pop(gpio_edge_event_t *event)
+{
+  (void)event;
+  return false;
+}
+
+uint32_t gpio_event_get_dropped(void)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,467 @@
+/**
+ * @file gpio_evlog.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_evlog.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_EVLOG
+
+#include <esp_partition.h>
+
+#include "gpio_varint.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <pthread.h>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <spi_flash_mmap.h>
+#endif
+
+#define GPIO_EVLOG_MAGIC 0x47504945UL
+#define GPIO_EVLOG_PAGE_SIZE SPI_FLASH_SEC_SIZE
+#define GPIO_EVLOG_BLANK_CHUNK 64
+
+// Low bits of an event record: pin << 1 | level; the time delta, zigzag
+// coded, is above
+#define GPIO_EVLOG_PIN_BITS 7
+#define GPIO_EVLOG_PIN_MASK ((1U << GPIO_EVLOG_PIN_BITS) - 1)
+
+/**
+ * @brief Header at the start of each written sector.
+ *
+ * Written after the events of the page: after an erase it reads as 0xFF, so
+ * a page torn by a reset has no valid magic.
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t seq;     /**< Page number, one more than the previous page */
+  int64_t first_us; /**< Time of the first event of the page */
+  uint32_t bytes;   /**< Event bytes after the header */
+  uint32_t events;  /**< Events in the page */
+} gpio_evlog_header_t;
+
+#define GPIO_EVLOG_PAYLOAD (GPIO_EVLOG_PAGE_SIZE - sizeof(gpio_evlog_header_t))
+
+typedef struct
+{
+  const esp_partition_t *partition;
+  uint32_t slots;     /**< Sectors of the partition */
+  uint32_t next_slot; /**< Sector of the next page, the oldest one once full */
+  uint32_t next_seq;
+  int64_t last_us; /**< Time of the last event of the RAM page */
+  gpio_evlog_header_t header; /**< Header of the RAM page */
+  gpio_evlog_stats_t stats;
+  uint8_t page[GPIO_EVLOG_PAYLOAD]; /**< Events of the RAM page */
+} gpio_evlog_t;
+
+static gpio_evlog_t s_evlog = {0};
+
+static const char *TAG = "GPIO_EVLOG";
+
+#if CONFIG_IDF_TARGET_LINUX
+static pthread_mutex_t s_evlog_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define GPIO_EVLOG_LOCK() pthread_mutex_lock(&s_evlog_mutex)
+#define GPIO_EVLOG_UNLOCK() pthread_mutex_unlock(&s_evlog_mutex)
+#else
+static StaticSemaphore_t s_evlog_mutex_buf;
+static SemaphoreHandle_t s_evlog_mutex = NULL;
+#if CONFIG_GPIO_DRIVERS_STATIC_ONLY
+static StaticTask_t s_evlog_task_tcb;
+static StackType_t s_evlog_task_stack[CONFIG_GPIO_DRIVERS_EVLOG_TASK_STACK];
+#endif
+#define GPIO_EVLOG_LOCK() xSemaphoreTake(s_evlog_mutex, portMAX_DELAY)
+#define GPIO_EVLOG_UNLOCK() xSemaphoreGive(s_evlog_mutex)
+#endif
+
+static bool gpio_evlog_header_valid(const gpio_evlog_header_t *header)
+{
+  return header->magic == GPIO_EVLOG_MAGIC &&
+         header->bytes <= GPIO_EVLOG_PAYLOAD;
+}
+
+// Erase the sector at offset, unless it is still blank from a previous erase
+static esp_err_t gpio_evlog_prepare_sector(uint32_t offset)
+{
+  uint32_t chunk[GPIO_EVLOG_BLANK_CHUNK];
+
+  for (uint32_t at = 0; at < GPIO_EVLOG_PAGE_SIZE; at += sizeof(chunk))
+  {
+    esp_err_t err = esp_partition_read(s_evlog.partition, offset + at, chunk,
+                                       sizeof(chunk));
+    if (err != ESP_OK)
+      return err;
+
+    for (size_t i = 0; i < GPIO_EVLOG_BLANK_CHUNK; i++)
+    {
+      if (chunk[i] != UINT32_MAX)
+      {
+        s_evlog.stats.erases++;
+        return esp_partition_erase_range(s_evlog.partition, offset,
+                                         GPIO_EVLOG_PAGE_SIZE);
+      }
+    }
+  }
+
+  s_evlog.stats.erases_skipped++;
+  return ESP_OK;
+}
+
+// Write the RAM page to the next sector and start a new one. On a flash
+// error the page is lost, so a failing sector cannot stall the log
+static esp_err_t gpio_evlog_write_page(void)
+{
+  uint32_t offset = s_evlog.next_slot * GPIO_EVLOG_PAGE_SIZE;
+
+  s_evlog.header.magic = GPIO_EVLOG_MAGIC;
+  s_evlog.header.seq = s_evlog.next_seq;
+
+  esp_err_t err = gpio_evlog_prepare_sector(offset);
+  if (err == ESP_OK)
+    err = esp_partition_write(s_evlog.partition,
+                              offset + sizeof(gpio_evlog_header_t),
+                              s_evlog.page, s_evlog.header.bytes);
+  if (err == ESP_OK)
+    err = esp_partition_write(s_evlog.partition, offset, &s_evlog.header,
+                              sizeof(s_evlog.header));
+
+  if (err == ESP_OK)
+  {
+    s_evlog.stats.pages++;
+    s_evlog.stats.events += s_evlog.header.events;
+    s_evlog.stats.bytes += s_evlog.header.bytes;
+  }
+  else
+  {
+    GPIO_DRV_LOGE(TAG, "Page %" PRIu32 " lost: error 0x%x", s_evlog.next_seq,
+                  err);
+  }
+
+  s_evlog.next_slot = (s_evlog.next_slot + 1) % s_evlog.slots;
+  s_evlog.next_seq++;
+  s_evlog.header = (gpio_evlog_header_t){0};
+
+  return err;
+}
+
+static void gpio_evlog_append(const gpio_edge_event_t *event)
+{
+  // Events come in the order their ISRs queued them, which a nested ISR or
+  // a timestamp step may put before the previous one: the signed delta
+  // keeps the exact time
+  if (event->time_us < s_evlog.last_us)
+    s_evlog.stats.reordered++;
+
+  if (s_evlog.header.events == 0)
+  {
+    s_evlog.header.first_us = event->time_us;
+    s_evlog.last_us = event->time_us;
+  }
+
+  int64_t delta = event->time_us - s_evlog.last_us;
+  uint8_t record[GPIO_VARINT_MAX];
+  size_t len = gpio_varint_put(
+      record, (gpio_varint_zigzag(delta) << GPIO_EVLOG_PIN_BITS) |
+                  (uint64_t)(event->pin << 1) | (event->level & 1));
+
+  if (s_evlog.header.bytes + len > GPIO_EVLOG_PAYLOAD)
+  {
+    // The event opens the next page, with no delta
+    gpio_evlog_write_page();
+    s_evlog.header.first_us = event->time_us;
+    s_evlog.last_us = event->time_us;
+    delta = 0;
+    len = gpio_varint_put(record, (uint64_t)(event->pin << 1) |
+                                      (event->level & 1));
+  }
+
+  for (size_t i = 0; i < len; i++)
+    s_evlog.page[s_evlog.header.bytes + i] = record[i];
+  s_evlog.header.bytes += len;
+  s_evlog.header.events++;
+  s_evlog.last_us += delta;
+}
+
+uint32_t gpio_evlog_drain(void)
+{
+  gpio_edge_event_t event;
+  uint32_t moved = 0;
+
+  GPIO_EVLOG_LOCK();
+  if (s_evlog.partition != NULL)
+  {
+    while (gpio_event_pop(&event))
+    {
+      gpio_evlog_append(&event);
+      moved++;
+    }
+  }
+  GPIO_EVLOG_UNLOCK();
+
+  return moved;
+}
+
+esp_err_t gpio_evlog_sync(void)
+{
+  gpio_evlog_drain();
+
+  GPIO_EVLOG_LOCK();
+  esp_err_t err = ESP_ERR_INVALID_STATE;
+  if (s_evlog.partition != NULL)
+    err = s_evlog.header.events ? gpio_evlog_write_page() : ESP_OK;
+  GPIO_EVLOG_UNLOCK();
+
+  return err;
+}
+
+esp_err_t gpio_evlog_get_stats(gpio_evlog_stats_t *stats)
+{
+  if (stats == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  GPIO_EVLOG_LOCK();
+  *stats = s_evlog.stats;
+  GPIO_EVLOG_UNLOCK();
+
+  return ESP_OK;
+}
+
+// Resume after the newest page found in the partition
+static esp_err_t gpio_evlog_mount(const esp_partition_t *partition)
+{
+  s_evlog.partition = partition;
+  s_evlog.slots = partition->size / GPIO_EVLOG_PAGE_SIZE;
+  s_evlog.next_slot = 0;
+  s_evlog.next_seq = 0;
+
+  bool found = false;
+  for (uint32_t slot = 0; slot < s_evlog.slots; slot++)
+  {
+    gpio_evlog_header_t header;
+    esp_err_t err = esp_partition_read(partition, slot * GPIO_EVLOG_PAGE_SIZE,
+                                       &header, sizeof(header));
+    if (err != ESP_OK)
+    {
+      s_evlog.partition = NULL;
+      return err;
+    }
+
+    if (gpio_evlog_header_valid(&header) &&
+        (!found || (int32_t)(header.seq - s_evlog.next_seq) >= 0))
+    {
+      found = true;
+      s_evlog.next_slot = (slot + 1) % s_evlog.slots;
+      s_evlog.next_seq = header.seq + 1;
+    }
+  }
+
+  return ESP_OK;
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static void gpio_evlog_task(void *arg)
+{
+  (void)arg;
+
+  for (;;)
+  {
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_GPIO_DRIVERS_EVLOG_PERIOD_MS));
+    gpio_evlog_drain();
+  }
+}
+#endif
+
+esp_err_t gpio_evlog_init(const char *label)
+{
+  if (label == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+#if !CONFIG_IDF_TARGET_LINUX
+  if (s_evlog_mutex == NULL)
+    s_evlog_mutex = xSemaphoreCreateMutexStatic(&s_evlog_mutex_buf);
+#endif
+
+  const esp_partition_t *partition = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (partition == NULL)
+    return ESP_ERR_NOT_FOUND;
+  if (partition->size / GPIO_EVLOG_PAGE_SIZE < 2)
+    return ESP_ERR_INVALID_SIZE;
+
+  GPIO_EVLOG_LOCK();
+  bool mounted = s_evlog.partition != NULL;
+  esp_err_t err = mounted ? ESP_OK : gpio_evlog_mount(partition);
+  GPIO_EVLOG_UNLOCK();
+
+  if (err != ESP_OK || mounted)
+    return err;
+
+  GPIO_DRV_LOGI(TAG, "Mounted: %" PRIu32 " sectors, next page %" PRIu32,
+                s_evlog.slots, s_evlog.next_seq);
+
+#if !CONFIG_IDF_TARGET_LINUX
+#if CONFIG_GPIO_DRIVERS_STATIC_ONLY
+  if (xTaskCreateStatic(gpio_evlog_task, "gpio_evlog",
+                        CONFIG_GPIO_DRIVERS_EVLOG_TASK_STACK, NULL,
+                        CONFIG_GPIO_DRIVERS_EVLOG_TASK_PRIO,
+                        s_evlog_task_stack, &s_evlog_task_tcb) == NULL)
+#else
+  if (xTaskCreate(gpio_evlog_task, "gpio_evlog",
+                  CONFIG_GPIO_DRIVERS_EVLOG_TASK_STACK, NULL,
+                  CONFIG_GPIO_DRIVERS_EVLOG_TASK_PRIO, NULL) != pdPASS)
+#endif
+  {
+    GPIO_EVLOG_LOCK();
+    s_evlog.partition = NULL;
+    GPIO_EVLOG_UNLOCK();
+    return ESP_ERR_NO_MEM;
+  }
+#endif
+
+  return ESP_OK;
+}
+
+#if CONFIG_IDF_TARGET_LINUX
+void gpio_drv_evlog_unmount(void)
+{
+  GPIO_EVLOG_LOCK();
+  s_evlog = (gpio_evlog_t){0};
+  GPIO_EVLOG_UNLOCK();
+}
+#endif
+
+esp_err_t gpio_evlog_reader_init(gpio_evlog_reader_t *reader)
+{
+  if (reader == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  GPIO_EVLOG_LOCK();
+  esp_err_t err = ESP_ERR_INVALID_STATE;
+  if (s_evlog.partition != NULL)
+  {
+    // Once the log has wrapped, the next sector to write holds the oldest page
+    *reader = (gpio_evlog_reader_t){.slot = s_evlog.next_slot};
+    err = ESP_OK;
+  }
+  GPIO_EVLOG_UNLOCK();
+
+  return err;
+}
+
+// Move the reader to the next written page
+static esp_err_t gpio_evlog_reader_next_page(gpio_evlog_reader_t *reader)
+{
+  while (reader->visited < s_evlog.slots)
+  {
+    uint32_t offset = reader->slot * GPIO_EVLOG_PAGE_SIZE;
+    reader->slot = (reader->slot + 1) % s_evlog.slots;
+    reader->visited++;
+
+    gpio_evlog_header_t header;
+    esp_err_t err = esp_partition_read(s_evlog.partition, offset, &header,
+                                       sizeof(header));
+    if (err != ESP_OK)
+      return err;
+    if (!gpio_evlog_header_valid(&header))
+      continue;
+
+    reader->seq = header.seq;
+    reader->offset = offset + sizeof(header);
+    reader->end = reader->offset + header.bytes;
+    reader->time_us = header.first_us;
+    return ESP_OK;
+  }
+
+  return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t gpio_evlog_read(gpio_evlog_reader_t *reader, gpio_edge_event_t *event)
+{
+  if (reader == NULL || event == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  GPIO_EVLOG_LOCK();
+  esp_err_t err = s_evlog.partition ? ESP_OK : ESP_ERR_INVALID_STATE;
+  while (err == ESP_OK && reader->offset >= reader->end)
+    err = gpio_evlog_reader_next_page(reader);
+
+  uint8_t record[GPIO_VARINT_MAX];
+  uint32_t len = reader->end - reader->offset;
+  if (len > sizeof(record))
+    len = sizeof(record);
+  if (err == ESP_OK)
+    err = esp_partition_read(s_evlog.partition, reader->offset, record, len);
+  GPIO_EVLOG_UNLOCK();
+
+  if (err != ESP_OK)
+    return err;
+
+  uint64_t value;
+  len = gpio_varint_get(record, len, &value);
+  if (len == 0 || (value & GPIO_EVLOG_PIN_MASK) >> 1 >= GPIO_NUM_MAX)
+    return ESP_ERR_INVALID_CRC;
+
+  reader->offset += len;
+  reader->time_us += gpio_varint_unzigzag(value >> GPIO_EVLOG_PIN_BITS);
+  *event = (gpio_edge_event_t){
+      .time_us = reader->time_us,
+      .pin = (uint8_t)((value & GPIO_EVLOG_PIN_MASK) >> 1),
+      .level = (uint8_t)(value & 1),
+  };
+
+  return ESP_OK;
+}
+
+#else
+
+esp_err_t gpio_evlog_init(const char *label)
+{
+  (void)label;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+uint32_t gpio_evlog_drain(void)
+{
+  return 0;
+}
+
+esp_err_t gpio_evlog_sync(void)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_evlog_get_stats(gpio_evlog_stats_t *stats)
+{
+  (void)stats;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_evlog_reader_init(gpio_evlog_reader_t *reader)
+{
+  (void)reader;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_evlog_read(gpio_evlog_reader_t *reader, gpio_edge_event_t *event)
+{
+  (void)reader;
+  (void)event;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file gpio_expander.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_expander.h"
+
+#include "gpio_drivers_ll.h"
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+
+// MCP23017 registers, IOCON.BANK = 0 (A and B interleaved)
+#define MCP23017_IODIR 0x00
+#define MCP23017_GPIO 0x12
+#define MCP23017_OLAT 0x14
+#define MCP23017_IOCON_MIRROR 0x40
+
+// The port is the first member of the expander
+static inline gpio_expander_t *gpio_expander_of(gpio_vport_t *port)
+{
+  return (gpio_expander_t *)port;
+}
+
+static esp_err_t gpio_expander_write(gpio_vport_t *port, uint64_t levels,
+                                     uint64_t outputs)
+{
+  gpio_expander_t *self = gpio_expander_of(port);
+  const gpio_expander_config_t *cfg = &self->config;
+
+  if (cfg->type == GPIO_EXPANDER_PCF8574)
+  {
+    // Quasi-bidirectional: a pin written high is also an input
+    uint8_t data = (uint8_t)((levels & outputs) | ~outputs);
+    return cfg->bus->write(cfg->bus_ctx, cfg->addr, &data, 1);
+  }
+
+  // Latches first, so a pin turned into an output starts at its level
+  uint8_t olat[3] = {MCP23017_OLAT, (uint8_t)levels, (uint8_t)(levels >> 8)};
+  esp_err_t err = cfg->bus->write(cfg->bus_ctx, cfg->addr, olat,
+                                  sizeof(olat));
+  if (err != ESP_OK || (port->sent && outputs == port->sent_outputs))
+    return err;
+
+  // IODIR to GPPU in one sequential write
+  uint16_t inputs = (uint16_t)~outputs;
+  uint16_t int_en = cfg->int_pin != DISABLE ? inputs : 0;
+  uint8_t config[15] = {
+      MCP23017_IODIR,
+      (uint8_t)inputs, (uint8_t)(inputs >> 8), // IODIR
+      0, 0,                                    // IPOL
+      (uint8_t)int_en, (uint8_t)(int_en >> 8), // GPINTEN
+      0, 0,                                    // DEFVAL
+      0, 0,                                    // INTCON: on any change
+      MCP23017_IOCON_MIRROR,                   // IOCON: INTA = INTB
+      MCP23017_IOCON_MIRROR,
+      (uint8_t)inputs, (uint8_t)(inputs >> 8), // GPPU
+  };
+
+  return cfg->bus->write(cfg->bus_ctx, cfg->addr, config, sizeof(config));
+}
+
+static esp_err_t gpio_expander_read(gpio_vport_t *port, uint64_t *levels)
+{
+  gpio_expander_t *self = gpio_expander_of(port);
+  const gpio_expander_config_t *cfg = &self->config;
+  uint8_t data[2] = {0};
+  esp_err_t err;
+
+  // Reading the port also releases the INT line of both chips
+  if (cfg->type == GPIO_EXPANDER_PCF8574)
+  {
+    err = cfg->bus->write_read(cfg->bus_ctx, cfg->addr, NULL, 0, data, 1);
+  }
+  else
+  {
+    uint8_t reg = MCP23017_GPIO;
+    err = cfg->bus->write_read(cfg->bus_ctx, cfg->addr, &reg, 1, data, 2);
+  }
+
+  if (err == ESP_OK)
+    *levels = data[0] | ((uint64_t)data[1] << 8);
+
+  return err;
+}
+
+static const gpio_vport_ops_t s_expander_ops = {
+    .write = gpio_expander_write,
+    .read = gpio_expander_read,
+};
+
+static void IRAM_ATTR gpio_expander_isr(void *arg)
+{
+  gpio_vport_invalidate(arg);
+}
+
+esp_err_t gpio_expander_init(gpio_expander_t *self,
+                             const gpio_expander_config_t *config)
+{
+  if (self == NULL || config == NULL || config->bus == NULL ||
+      config->bus->write == NULL || config->bus->write_read == NULL ||
+      config->addr > 0x7F ||
+      (config->type != GPIO_EXPANDER_PCF8574 &&
+       config->type != GPIO_EXPANDER_MCP23017))
+    return ESP_ERR_INVALID_ARG;
+
+  uint8_t width = config->type == GPIO_EXPANDER_PCF8574 ? 8 : 16;
+  uint64_t pins = (1ULL << width) - 1;
+
+  *self = (gpio_expander_t){
+      .port =
+          {
+              .ops = &s_expander_ops,
+              .output_capable = pins,
+              .input_capable = pins,
+              .width = width,
+              .cached = config->int_pin != DISABLE,
+          },
+      .config = *config,
+  };
+
+  esp_err_t err = gpio_vport_register(&self->port);
+  if (err != ESP_OK)
+    return err;
+
+  // Every pin an input until gpio_init_impl() says otherwise
+  err = gpio_vport_flush(&self->port);
+  if (err != ESP_OK || config->int_pin == DISABLE)
+    return err;
+
+  self->int_line = (gpio_t){
+      .pin = config->int_pin,
+      ._mode = GPIO_MODE_INPUT,
+      .isr_handler = gpio_expander_isr,
+      .isr_handler_arg = &self->port,
+  };
+
+  return gpio_init_impl_nolog(&self->int_line);
+}
+
+#else
+
+esp_err_t gpio_expander_init(gpio_expander_t *self,
+                             const gpio_expander_config_t *config)
+{
+  (void)self;
+  (void)config;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
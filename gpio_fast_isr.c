@@ -0,0 +1,69 @@
+/**
+ * @file gpio_fast_isr.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_fast_isr.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_FAST_ISR
+#include CONFIG_GPIO_DRIVERS_FAST_ISR_BOARD
+
+#ifndef GPIO_FAST_ISR_PINS
+#error "The board header must define GPIO_FAST_ISR_PINS(X)"
+#endif
+
+GPIO_DRV_FAST_ISR_DEFINE(gpio_fast_isr_board, GPIO_FAST_ISR_PINS)
+
+static bool s_fast_isr_installed = false;
+
+esp_err_t gpio_drv_fast_isr_register(void (*entry)(void *), uint64_t mask)
+{
+  if (entry == NULL || mask == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  for (uint64_t pins = mask; pins; pins &= pins - 1)
+  {
+    if (!GPIO_IS_VALID_GPIO(__builtin_ctzll(pins)))
+      return ESP_ERR_INVALID_ARG;
+  }
+
+  // A shared interrupt runs its latest handler first: the service must be
+  // there before the trampolines, or it would clear their status bits
+  esp_err_t err = gpio_drv_isr_service_install();
+  if (err != ESP_OK)
+    return err;
+
+  gpio_isr_handle_t handle;
+  return gpio_isr_register(entry, NULL, GPIO_DRV_ISR_FLAGS, &handle);
+}
+
+esp_err_t gpio_fast_isr_install(void)
+{
+  if (__atomic_exchange_n(&s_fast_isr_installed, true, __ATOMIC_ACQ_REL))
+    return ESP_ERR_INVALID_STATE;
+
+  esp_err_t err =
+      gpio_drv_fast_isr_register(gpio_fast_isr_board, gpio_fast_isr_board_mask);
+  if (err != ESP_OK)
+    __atomic_store_n(&s_fast_isr_installed, false, __ATOMIC_RELEASE);
+
+  return err;
+}
+
+#else
+
+esp_err_t gpio_fast_isr_install(void)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
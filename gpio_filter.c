@@ -0,0 +1,141 @@
+/**
+ * @file gpio_filter.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_filter.h"
+
+#include "gpio_drivers_ll.h"
+
+// Add one to the bit-sliced counters of the pins set in bits
+static inline void IRAM_ATTR gpio_filter_count(uint64_t *count, uint64_t bits)
+{
+  for (int b = 0; b < GPIO_FILTER_COUNT_BITS; b++)
+  {
+    uint64_t carry = count[b] & bits;
+    count[b] ^= bits;
+    bits = carry;
+  }
+}
+
+// Pins whose bit-sliced counter is at least threshold, from the top bit
+// down: equal so far, or greater at the first bit that differs
+static inline uint64_t IRAM_ATTR gpio_filter_at_least(const uint64_t *count,
+                                                      uint32_t threshold)
+{
+  uint64_t greater = 0;
+  uint64_t equal = UINT64_MAX;
+
+  for (int b = GPIO_FILTER_COUNT_BITS - 1; b >= 0; b--)
+  {
+    if (threshold & (1U << b))
+    {
+      equal &= count[b];
+    }
+    else
+    {
+      greater |= equal & count[b];
+      equal &= ~count[b];
+    }
+  }
+
+  return greater | equal;
+}
+
+// Vote on the counted highs, then debounce the voted state
+static void IRAM_ATTR gpio_filter_apply(gpio_filter_t *self,
+                                        const uint64_t *count)
+{
+  uint64_t old = self->levels;
+
+  if (!self->started)
+  {
+    self->state =
+        gpio_filter_at_least(count, self->samples / 2 + 1) & self->pin_mask;
+    self->levels = self->state;
+    self->changed = 0;
+    self->started = true;
+    return;
+  }
+
+  self->state = ((self->state & gpio_filter_at_least(count, self->hold)) |
+                 gpio_filter_at_least(count, self->rise)) &
+                self->pin_mask;
+
+  if (self->debounce <= 1)
+  {
+    self->levels = self->state;
+  }
+  else
+  {
+    // Count the updates in a row each state differed from its level, and
+    // move the level once it reached the debounce
+    uint64_t *counter = self->debounce_count;
+    uint64_t differ = self->state ^ self->levels;
+    gpio_filter_count(counter, differ);
+
+    uint64_t flip = differ & gpio_filter_at_least(counter, self->debounce);
+    for (int b = 0; b < GPIO_FILTER_COUNT_BITS; b++)
+      counter[b] &= differ & ~flip;
+    self->levels ^= flip;
+  }
+
+  self->changed = self->levels ^ old;
+}
+
+esp_err_t gpio_filter_init(gpio_filter_t *self, uint64_t pin_mask,
+                           uint32_t samples, uint32_t hysteresis,
+                           uint32_t spacing, uint32_t debounce)
+{
+  if (self == NULL || samples == 0 || samples > GPIO_FILTER_SAMPLES_MAX ||
+      hysteresis > (samples - 1) / 2 || debounce > GPIO_FILTER_SAMPLES_MAX)
+    return ESP_ERR_INVALID_ARG;
+
+  *self = (gpio_filter_t){
+      .pin_mask = pin_mask,
+      .spacing = spacing,
+      .samples = (uint8_t)samples,
+      .rise = (uint8_t)(samples / 2 + 1 + hysteresis),
+      .hold = (uint8_t)((samples + 1) / 2 - hysteresis),
+      .debounce = (uint8_t)debounce,
+  };
+
+  return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR gpio_filter_update(gpio_filter_t *self,
+                                       const uint64_t *snapshots)
+{
+  if (self == NULL || snapshots == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t count[GPIO_FILTER_COUNT_BITS] = {0};
+  for (uint32_t i = 0; i < self->samples; i++)
+    gpio_filter_count(count, snapshots[i]);
+  gpio_filter_apply(self, count);
+
+  return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR gpio_filter_sample(gpio_filter_t *self)
+{
+  if (self == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t count[GPIO_FILTER_COUNT_BITS] = {0};
+  for (uint32_t i = 0; i < self->samples; i++)
+  {
+    if (i > 0 && self->spacing)
+      GPIO_DRV_SPIN(self->spacing);
+    gpio_filter_count(count, gpio_drv_ll_read());
+  }
+  gpio_filter_apply(self, count);
+
+  return ESP_OK;
+}
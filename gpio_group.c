@@ -0,0 +1,115 @@
+/**
+ * @file gpio_group.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_group.h"
+
+#include <esp_log.h>
+#include <string.h>
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+static const char *TAG = "GPIO_GROUP";
+
+esp_err_t gpio_group_init(gpio_group_t *self, const gpio_group_config_t *config)
+{
+  if (self == NULL || config == NULL || config->pins == NULL ||
+      config->pin_count == 0 || config->pin_count > GPIO_GROUP_MAX_PINS)
+  {
+    GPIO_DRV_LOGE(TAG, "Invalid group configuration");
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  memset(self, 0, sizeof(*self));
+
+  for (uint8_t bit = 0; bit < config->pin_count; bit++)
+  {
+    gpio_pinout_t pin = config->pins[bit];
+    if (!GPIO_IS_VALID_GPIO(pin) || (self->pin_mask & (1ULL << pin)))
+    {
+      GPIO_DRV_LOGE(TAG, "Invalid or duplicated pin %d", pin);
+      return ESP_ERR_INVALID_ARG;
+    }
+
+    self->bit_to_pin[bit] = (uint8_t)pin;
+    self->pin_mask |= 1ULL << pin;
+    if (config->active_low_mask & (1UL << bit))
+      self->invert_mask |= 1ULL << pin;
+  }
+  self->pin_count = config->pin_count;
+
+  // Each lane covers four logical bits: entry n is the pin mask of nibble n
+  for (uint8_t lane = 0; lane < GPIO_GROUP_LUT_LANES; lane++)
+  {
+    for (uint8_t nibble = 0; nibble < 16; nibble++)
+    {
+      uint64_t mask = 0;
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        uint8_t bit = lane * 4 + i;
+        if ((nibble & (1 << i)) && bit < self->pin_count)
+          mask |= 1ULL << self->bit_to_pin[bit];
+      }
+      self->scatter_lut[lane][nibble] = mask;
+    }
+  }
+
+  if (config->time_critical && (self->pin_mask & GPIO_DRV_BANK0_MASK) &&
+      (self->pin_mask & GPIO_DRV_BANK1_MASK))
+    GPIO_DRV_LOGW(TAG, "Time-critical group straddles GPIO 0-31 and 32-39, "
+                  "expect inter-bank skew");
+
+  GPIO_DRV_LOGI(TAG, "Configured group of %d pins", self->pin_count);
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_group_set_config_output(gpio_group_t *self)
+{
+  for (uint8_t bit = 0; bit < self->pin_count; bit++)
+  {
+    if (!GPIO_IS_VALID_OUTPUT_GPIO(self->bit_to_pin[bit]))
+    {
+      GPIO_DRV_LOGE(TAG, "Pin %d is input only", self->bit_to_pin[bit]);
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+
+  // Input enabled too, so gpio_group_read() reads the driven levels back
+  return gpio_drv_config_outputs(self->pin_mask, true);
+}
+
+esp_err_t IRAM_ATTR gpio_group_write(gpio_group_t *self, uint32_t value)
+{
+  uint64_t levels = 0;
+  uint8_t lanes = (self->pin_count + 3) / 4;
+
+  for (uint8_t lane = 0; lane < lanes; lane++)
+    levels |= self->scatter_lut[lane][(value >> (lane * 4)) & 0xF];
+
+  levels ^= self->invert_mask;
+  uint32_t skew =
+      gpio_drv_ll_write(levels & self->pin_mask, ~levels & self->pin_mask);
+  gpio_drv_skew_record(skew);
+
+  return ESP_OK;
+}
+
+uint32_t IRAM_ATTR gpio_group_read(gpio_group_t *self)
+{
+  uint64_t levels = gpio_drv_ll_read() ^ self->invert_mask;
+  uint32_t value = 0;
+
+  for (uint8_t bit = 0; bit < self->pin_count; bit++)
+    value |= (uint32_t)((levels >> self->bit_to_pin[bit]) & 1) << bit;
+
+  return value;
+}
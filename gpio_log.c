@@ -0,0 +1,257 @@
+/**
+ * @file gpio_log.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_log.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_DEFERRED_LOG
+
+#if !CONFIG_IDF_TARGET_LINUX
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+#define GPIO_LOG_RING_SIZE CONFIG_GPIO_DRIVERS_DEFERRED_LOG_ENTRIES
+#define GPIO_LOG_RING_MASK (GPIO_LOG_RING_SIZE - 1)
+
+_Static_assert((GPIO_LOG_RING_SIZE & GPIO_LOG_RING_MASK) == 0,
+               "CONFIG_GPIO_DRIVERS_DEFERRED_LOG_ENTRIES must be a power of 2");
+
+typedef struct
+{
+  uint32_t seq; /**< Ring position this entry is ready for, see below */
+  uint8_t level;
+  uint8_t nargs;
+  uint32_t time_ms;
+  const char *tag;
+  const char *format;
+  uint32_t args[GPIO_LOG_MAX_ARGS];
+} gpio_log_entry_t;
+
+// Bounded multi-producer ring. With lap = p & ~mask, the entry of position p
+// is free for its writer when seq == lap and holds its message when
+// seq == lap + 1, so the zeroed ring needs no initialization. Writers claim
+// a position with a CAS on head, so ISRs and both cores can log at once
+// without a lock; the flush task is the only reader.
+typedef struct
+{
+  gpio_log_entry_t entries[GPIO_LOG_RING_SIZE];
+  uint32_t head;
+  uint32_t tail;
+  uint32_t dropped;
+  uint32_t reported;
+  uint32_t high_water; /**< Most entries pending at a flush */
+} gpio_log_ring_t;
+
+static gpio_log_ring_t s_log_ring = {0};
+#if !CONFIG_IDF_TARGET_LINUX
+static bool s_log_task_started = false;
+#if CONFIG_GPIO_DRIVERS_STATIC_ONLY
+static StaticTask_t s_log_task_tcb;
+static StackType_t s_log_task_stack[CONFIG_GPIO_DRIVERS_DEFERRED_LOG_TASK_STACK];
+#endif
+#endif
+
+static const char *TAG = "GPIO_LOG";
+
+#define GPIO_LOG_LAP(pos) ((pos) & ~(uint32_t)GPIO_LOG_RING_MASK)
+
+void IRAM_ATTR gpio_log_write(esp_log_level_t level, const char *tag,
+                              const char *format, int nargs, ...)
+{
+  gpio_log_entry_t *entry;
+  uint32_t pos = __atomic_load_n(&s_log_ring.head, __ATOMIC_RELAXED);
+
+  for (;;)
+  {
+    entry = &s_log_ring.entries[pos & GPIO_LOG_RING_MASK];
+    int32_t diff = (int32_t)(__atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE) -
+                             GPIO_LOG_LAP(pos));
+
+    if (diff == 0)
+    {
+      if (__atomic_compare_exchange_n(&s_log_ring.head, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // Full: the reader has not freed this entry yet
+      __atomic_fetch_add(&s_log_ring.dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+    else
+    {
+      pos = __atomic_load_n(&s_log_ring.head, __ATOMIC_RELAXED);
+    }
+  }
+
+  if (nargs > GPIO_LOG_MAX_ARGS)
+    nargs = GPIO_LOG_MAX_ARGS;
+
+  va_list args;
+  va_start(args, nargs);
+  for (int i = 0; i < nargs; i++)
+    entry->args[i] = va_arg(args, uint32_t);
+  va_end(args);
+
+  entry->level = (uint8_t)level;
+  entry->nargs = (uint8_t)nargs;
+  entry->time_ms = (uint32_t)(GPIO_DRV_TIME_US() / 1000);
+  entry->tag = tag;
+  entry->format = format;
+  __atomic_store_n(&entry->seq, GPIO_LOG_LAP(pos) + 1, __ATOMIC_RELEASE);
+}
+
+static char gpio_log_letter(esp_log_level_t level)
+{
+  static const char letters[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+  return level < sizeof(letters) ? letters[level] : '?';
+}
+
+uint32_t gpio_log_flush(void)
+{
+  uint32_t written = 0;
+
+  // The ring is fullest right before a flush drains it
+  uint32_t pending =
+      __atomic_load_n(&s_log_ring.head, __ATOMIC_RELAXED) - s_log_ring.tail;
+  if (pending > GPIO_LOG_RING_SIZE)
+    pending = GPIO_LOG_RING_SIZE;
+  if (pending > s_log_ring.high_water)
+    __atomic_store_n(&s_log_ring.high_water, pending, __ATOMIC_RELAXED);
+
+  for (;;)
+  {
+    uint32_t pos = s_log_ring.tail;
+    gpio_log_entry_t *entry = &s_log_ring.entries[pos & GPIO_LOG_RING_MASK];
+    if (__atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE) != GPIO_LOG_LAP(pos) + 1)
+      break;
+
+    gpio_log_entry_t copy = *entry;
+    __atomic_store_n(&entry->seq, GPIO_LOG_LAP(pos) + GPIO_LOG_RING_SIZE,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&s_log_ring.tail, pos + 1, __ATOMIC_RELAXED);
+
+    // Unused arguments are zero and ignored by the format
+    uint32_t a[GPIO_LOG_MAX_ARGS] = {0};
+    for (int i = 0; i < copy.nargs; i++)
+      a[i] = copy.args[i];
+
+    esp_log_level_t level = (esp_log_level_t)copy.level;
+    esp_log_write(level, copy.tag, "%c (%" PRIu32 ") %s: ",
+                  gpio_log_letter(level), copy.time_ms, copy.tag);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+    esp_log_write(level, copy.tag, copy.format, a[0], a[1], a[2], a[3]);
+#pragma GCC diagnostic pop
+    esp_log_write(level, copy.tag, "\n");
+    written++;
+  }
+
+  uint32_t dropped = __atomic_load_n(&s_log_ring.dropped, __ATOMIC_RELAXED);
+  if (dropped != s_log_ring.reported)
+  {
+    ESP_LOGW(TAG, "%" PRIu32 " deferred log messages dropped",
+             dropped - s_log_ring.reported);
+    s_log_ring.reported = dropped;
+  }
+
+  return written;
+}
+
+uint32_t gpio_log_get_dropped(void)
+{
+  return __atomic_load_n(&s_log_ring.dropped, __ATOMIC_RELAXED);
+}
+
+void gpio_drv_log_pool_stats(gpio_pool_stats_t *stats)
+{
+  uint32_t used = __atomic_load_n(&s_log_ring.head, __ATOMIC_RELAXED) -
+                  __atomic_load_n(&s_log_ring.tail, __ATOMIC_RELAXED);
+
+  stats->capacity = GPIO_LOG_RING_SIZE;
+  stats->used = used > GPIO_LOG_RING_SIZE ? GPIO_LOG_RING_SIZE : used;
+  stats->high_water = __atomic_load_n(&s_log_ring.high_water, __ATOMIC_RELAXED);
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static void gpio_log_task(void *arg)
+{
+  (void)arg;
+
+  for (;;)
+  {
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_GPIO_DRIVERS_DEFERRED_LOG_PERIOD_MS));
+    gpio_log_flush();
+  }
+}
+#endif
+
+esp_err_t gpio_log_init(void)
+{
+#if !CONFIG_IDF_TARGET_LINUX
+  if (__atomic_exchange_n(&s_log_task_started, true, __ATOMIC_ACQ_REL))
+    return ESP_OK;
+
+#if CONFIG_GPIO_DRIVERS_STATIC_ONLY
+  if (xTaskCreateStatic(gpio_log_task, "gpio_log",
+                        CONFIG_GPIO_DRIVERS_DEFERRED_LOG_TASK_STACK, NULL,
+                        CONFIG_GPIO_DRIVERS_DEFERRED_LOG_TASK_PRIO,
+                        s_log_task_stack, &s_log_task_tcb) == NULL)
+#else
+  if (xTaskCreate(gpio_log_task, "gpio_log",
+                  CONFIG_GPIO_DRIVERS_DEFERRED_LOG_TASK_STACK, NULL,
+                  CONFIG_GPIO_DRIVERS_DEFERRED_LOG_TASK_PRIO, NULL) != pdPASS)
+#endif
+  {
+    __atomic_store_n(&s_log_task_started, false, __ATOMIC_RELEASE);
+    return ESP_ERR_NO_MEM;
+  }
+#endif
+
+  return ESP_OK;
+}
+
+#else
+
+esp_err_t gpio_log_init(void)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+void gpio_log_write(esp_log_level_t level, const char *tag, const char *format,
+                    int nargs, ...)
+{
+  (void)level;
+  (void)tag;
+  (void)format;
+  (void)nargs;
+}
+
+uint32_t gpio_log_flush(void)
+{
+  return 0;
+}
+
+uint32_t gpio_log_get_dropped(void)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,305 @@
+/**
+ * @file gpio_pps.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_pps.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+// Edges the ISR can queue before they are processed; a power of 2
+#define GPIO_PPS_CAPTURES 4
+#define GPIO_PPS_CAPTURES_MASK (GPIO_PPS_CAPTURES - 1)
+
+// Fraction bits of the phase and frequency, in cycles
+#define GPIO_PPS_FRAC 8
+
+// Loop gains, as shifts: 1/8 of the phase error corrects the phase and
+// 1/128 the frequency, close to critical damping
+#define GPIO_PPS_PHASE_SHIFT 3
+#define GPIO_PPS_FREQ_SHIFT 7
+
+// Edges further than 1/4096 s (244 ppm) from a whole second are glitches
+#define GPIO_PPS_TOLERANCE_SHIFT 12
+
+// Rejected edges in a row before starting over from the next one
+#define GPIO_PPS_RELOCK 4
+
+// Accepted edges in a row before the timescale is trusted
+#define GPIO_PPS_LOCK 8
+
+#define GPIO_PPS_NS_PER_S 1000000000LL
+
+typedef struct
+{
+  uint32_t cycles;      /**< Cycle counter at ISR entry */
+  uint32_t read_cycles; /**< Cycles taken by the esp_timer read */
+  int64_t time_us;      /**< esp_timer time */
+} gpio_pps_capture_t;
+
+typedef enum
+{
+  GPIO_PPS_IDLE,    /**< No edge yet */
+  GPIO_PPS_ACQUIRE, /**< One edge: the frequency needs a second one */
+  GPIO_PPS_TRACK,   /**< Phase and frequency tracked */
+} gpio_pps_state_t;
+
+typedef struct
+{
+  // Written by the ISR; the consumer owns tail
+  gpio_pps_capture_t captures[GPIO_PPS_CAPTURES];
+  uint32_t head;
+  uint32_t tail;
+  uint32_t pulses;
+  uint32_t overruns;
+
+  // Loop, guarded by s_pps_lock
+  gpio_pps_state_t state;
+  uint32_t mhz;
+  uint32_t last_cycles; /**< Cycle counter of the last edge */
+  int64_t last_us;      /**< esp_timer time of the last edge */
+  int64_t ext;          /**< Cycle counter of the last edge, 64 bits */
+  int64_t base;         /**< 64-bit cycle count at esp_timer zero */
+  int64_t anchor; /**< 64-bit cycle count of the second boundary, Q8 */
+  int64_t period; /**< Cycles in one second, Q8 */
+  uint64_t ns_per_cycle; /**< Q32 */
+  int64_t second;
+  uint32_t accepted;
+  uint32_t rejected;
+  uint32_t in_row;      /**< Edges accepted in a row */
+  uint32_t rejects_row; /**< Edges rejected in a row */
+  int32_t offset_ns;
+} gpio_pps_t;
+
+static gpio_pps_t s_pps = {0};
+static gpio_drv_lock_t s_pps_lock = GPIO_DRV_LOCK_INITIALIZER;
+static int s_pps_pin = -1;
+
+static void IRAM_ATTR gpio_pps_isr(void *arg)
+{
+  (void)arg;
+
+  uint32_t cycles = GPIO_DRV_CYCLES();
+  int64_t time_us = GPIO_DRV_TIME_US();
+  uint32_t read_cycles = GPIO_DRV_CYCLES() - cycles;
+
+  s_pps.pulses++;
+  uint32_t head = s_pps.head;
+  if (head - __atomic_load_n(&s_pps.tail, __ATOMIC_ACQUIRE) ==
+      GPIO_PPS_CAPTURES)
+  {
+    s_pps.overruns++;
+    return;
+  }
+
+  s_pps.captures[head & GPIO_PPS_CAPTURES_MASK] = (gpio_pps_capture_t){
+      .cycles = cycles,
+      .read_cycles = read_cycles,
+      .time_us = time_us,
+  };
+  __atomic_store_n(&s_pps.head, head + 1, __ATOMIC_RELEASE);
+}
+
+// (a * k) >> 32 for a Q32 k, without a 128-bit product
+static int64_t gpio_pps_mul_q32(int64_t a, uint64_t k)
+{
+  uint64_t u = a < 0 ? -(uint64_t)a : (uint64_t)a;
+  uint64_t u_hi = u >> 32;
+  uint64_t u_lo = u & 0xFFFFFFFF;
+  uint64_t k_hi = k >> 32;
+  uint64_t k_lo = k & 0xFFFFFFFF;
+  uint64_t r = ((u_hi * k_hi) << 32) + u_hi * k_lo + u_lo * k_hi +
+               ((u_lo * k_lo) >> 32);
+
+  return a < 0 ? -(int64_t)r : (int64_t)r;
+}
+
+// Nanoseconds per cycle, Q32, of a Q8 period: 1e9 << 40 / period, in two
+// steps to stay in 64 bits
+static uint64_t gpio_pps_ns_per_cycle(int64_t period)
+{
+  uint64_t num = (uint64_t)GPIO_PPS_NS_PER_S << 32;
+  uint64_t q = num / (uint64_t)period;
+  uint64_t r = num % (uint64_t)period;
+
+  return (q << GPIO_PPS_FRAC) + (r << GPIO_PPS_FRAC) / (uint64_t)period;
+}
+
+static void gpio_pps_feed(const gpio_pps_capture_t *capture)
+{
+  gpio_pps_t *pps = &s_pps;
+
+  // Extend the cycle counter to 64 bits, counting its wraps with esp_timer
+  if (pps->state == GPIO_PPS_IDLE)
+  {
+    pps->mhz = GPIO_DRV_CPU_MHZ();
+    pps->ext = capture->cycles;
+  }
+  else
+  {
+    int64_t expected = (capture->time_us - pps->last_us) * pps->mhz;
+    uint32_t delta = capture->cycles - pps->last_cycles;
+    int64_t wraps = (expected - delta + (1LL << 31)) >> 32;
+    pps->ext += delta + (wraps << 32);
+  }
+  pps->last_cycles = capture->cycles;
+  pps->last_us = capture->time_us;
+
+  // Cycle count at esp_timer zero. Both count the same crystal, but each
+  // read truncates esp_timer by up to a microsecond: the smallest estimate
+  // is the closest. esp_timer was read halfway through read_cycles
+  int64_t base = pps->ext + capture->read_cycles / 2 -
+                 capture->time_us * pps->mhz;
+  if (pps->state == GPIO_PPS_IDLE || base < pps->base)
+    pps->base = base;
+
+  int64_t edge = pps->ext << GPIO_PPS_FRAC;
+  if (pps->state == GPIO_PPS_IDLE)
+  {
+    pps->anchor = edge;
+    pps->period = ((int64_t)pps->mhz * 1000000) << GPIO_PPS_FRAC;
+    pps->state = GPIO_PPS_ACQUIRE;
+    return;
+  }
+
+  // Whole seconds since the last boundary, and the phase error
+  int64_t elapsed = edge - pps->anchor;
+  int64_t n = elapsed >= 0 ? (elapsed + pps->period / 2) / pps->period : 0;
+  int64_t error = elapsed - n * pps->period;
+  int64_t tolerance = pps->period >> GPIO_PPS_TOLERANCE_SHIFT;
+
+  if (n < 1 || error > tolerance || error < -tolerance)
+  {
+    pps->rejected++;
+    pps->in_row = 0;
+
+    // Acquiring, or the PPS phase moved for good: start over from here
+    if (pps->state == GPIO_PPS_ACQUIRE ||
+        ++pps->rejects_row >= GPIO_PPS_RELOCK)
+    {
+      pps->second += n;
+      pps->anchor = edge;
+      pps->state = GPIO_PPS_ACQUIRE;
+      pps->rejects_row = 0;
+    }
+    return;
+  }
+
+  if (pps->state == GPIO_PPS_ACQUIRE)
+  {
+    // First measure of the frequency
+    pps->period = elapsed / n;
+    pps->anchor = edge;
+    pps->state = GPIO_PPS_TRACK;
+    error = 0;
+  }
+  else
+  {
+    pps->anchor += n * pps->period + error / (1 << GPIO_PPS_PHASE_SHIFT);
+    pps->period += error / (n << GPIO_PPS_FREQ_SHIFT);
+  }
+
+  pps->second += n;
+  pps->accepted++;
+  pps->in_row++;
+  pps->rejects_row = 0;
+  pps->offset_ns =
+      (int32_t)(error * 1000 / ((int64_t)pps->mhz << GPIO_PPS_FRAC));
+  pps->ns_per_cycle = gpio_pps_ns_per_cycle(pps->period);
+}
+
+// Feed the edges queued by the ISR to the loop. Called with s_pps_lock held
+static void gpio_pps_process(void)
+{
+  uint32_t head = __atomic_load_n(&s_pps.head, __ATOMIC_ACQUIRE);
+
+  while (s_pps.tail != head)
+  {
+    gpio_pps_capture_t capture =
+        s_pps.captures[s_pps.tail & GPIO_PPS_CAPTURES_MASK];
+    __atomic_store_n(&s_pps.tail, s_pps.tail + 1, __ATOMIC_RELEASE);
+    gpio_pps_feed(&capture);
+  }
+}
+
+esp_err_t gpio_pps_init(gpio_pinout_t pin, gpio_int_type_t edge)
+{
+  if (!GPIO_IS_VALID_GPIO(pin) ||
+      (edge != GPIO_INTR_POSEDGE && edge != GPIO_INTR_NEGEDGE))
+    return ESP_ERR_INVALID_ARG;
+
+  if (s_pps_pin >= 0 && s_pps_pin != pin)
+    gpio_isr_handler_remove(s_pps_pin);
+  s_pps_pin = -1;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_pps_lock);
+  s_pps = (gpio_pps_t){0};
+  GPIO_DRV_EXIT_CRITICAL(&s_pps_lock);
+
+  // An edge caught before the type is set only restarts the acquisition
+  gpio_t self = {.pin = pin};
+  esp_err_t err = gpio_drv_isr_service_install();
+  if (err == ESP_OK)
+    err = gpio_set_config_input_nolog(pin, gpio_pps_isr, NULL);
+  if (err == ESP_OK)
+    err = gpio_set_edge(&self, edge);
+  if (err == ESP_OK)
+    s_pps_pin = pin;
+
+  return err;
+}
+
+esp_err_t gpio_pps_to_ns(int64_t time_us, int64_t *ns)
+{
+  if (ns == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_ERR_INVALID_STATE;
+  GPIO_DRV_ENTER_CRITICAL(&s_pps_lock);
+  gpio_pps_process();
+  if (s_pps.accepted > 0)
+  {
+    int64_t cycles = s_pps.base + time_us * s_pps.mhz;
+    int64_t elapsed = cycles - (s_pps.anchor >> GPIO_PPS_FRAC);
+    *ns = s_pps.second * GPIO_PPS_NS_PER_S +
+          gpio_pps_mul_q32(elapsed, s_pps.ns_per_cycle);
+    err = ESP_OK;
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_pps_lock);
+
+  return err;
+}
+
+esp_err_t gpio_pps_get_stats(gpio_pps_stats_t *stats)
+{
+  if (stats == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_pps_lock);
+  gpio_pps_process();
+
+  int64_t nominal = ((int64_t)s_pps.mhz * 1000000) << GPIO_PPS_FRAC;
+  *stats = (gpio_pps_stats_t){
+      .pulses = s_pps.pulses,
+      .accepted = s_pps.accepted,
+      .rejected = s_pps.rejected,
+      .overruns = s_pps.overruns,
+      .second = s_pps.second,
+      .drift_ppb = s_pps.accepted > 0 ? (int32_t)((s_pps.period - nominal) *
+                                                  1000000000LL / nominal)
+                                      : 0,
+      .offset_ns = s_pps.offset_ns,
+      .locked = s_pps.state == GPIO_PPS_TRACK &&
+                s_pps.in_row >= GPIO_PPS_LOCK,
+  };
+  GPIO_DRV_EXIT_CRITICAL(&s_pps_lock);
+
+  return ESP_OK;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file gpio_shiftreg.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_shiftreg.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+
+// Serializes the groups sharing clock and latch lines
+static gpio_drv_lock_t s_shiftreg_lock = GPIO_DRV_LOCK_INITIALIZER;
+
+// Registered chains, newest first; chains are never removed
+static gpio_shiftreg_t *s_shiftreg_list = NULL;
+
+// Shift out one word per lane, the highest bit first so bit 0 ends at QA of
+// the first chip, then latch every lane
+static void IRAM_ATTR gpio_shiftreg_shift_out(const gpio_shiftreg_config_t *cfg,
+                                              const uint64_t *lanes,
+                                              const uint64_t *levels,
+                                              size_t count, uint8_t length)
+{
+  uint64_t clock = 1ULL << cfg->clock;
+  uint64_t data = 0;
+  uint64_t prev = 0;
+  bool first = true;
+
+  for (size_t i = 0; i < count; i++)
+    data |= lanes[i];
+
+  GPIO_DRV_ENTER_CRITICAL(&s_shiftreg_lock);
+  for (int bit = length - 1; bit >= 0; bit--)
+  {
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      if ((levels[i] >> bit) & 1)
+        word |= lanes[i];
+    }
+
+    // Only the data lines that change are stored, together with the falling
+    // edge of the previous clock pulse
+    uint64_t changed = first ? ~0ULL : word ^ prev;
+    gpio_drv_ll_store(word & changed & data, (~word & changed & data) | clock);
+    gpio_drv_ll_write_pin(cfg->clock, 1);
+
+    prev = word;
+    first = false;
+  }
+  gpio_drv_ll_write_pin(cfg->clock, 0);
+  gpio_drv_ll_write_pin(cfg->latch, 1);
+  gpio_drv_ll_write_pin(cfg->latch, 0);
+  GPIO_DRV_EXIT_CRITICAL(&s_shiftreg_lock);
+}
+
+// Load the parallel inputs, then shift in one word per lane, bit 0 first
+static void IRAM_ATTR gpio_shiftreg_shift_in(const gpio_shiftreg_config_t *cfg,
+                                             const uint64_t *lanes,
+                                             uint64_t *levels, size_t count,
+                                             uint8_t length)
+{
+  for (size_t i = 0; i < count; i++)
+    levels[i] = 0;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_shiftreg_lock);
+  gpio_drv_ll_write_pin(cfg->latch, 0);
+  gpio_drv_ll_write_pin(cfg->latch, 1);
+  for (int bit = 0; bit < length; bit++)
+  {
+    uint64_t in = gpio_drv_ll_read();
+    for (size_t i = 0; i < count; i++)
+    {
+      if (in & lanes[i])
+        levels[i] |= 1ULL << bit;
+    }
+
+    gpio_drv_ll_write_pin(cfg->clock, 1);
+    gpio_drv_ll_write_pin(cfg->clock, 0);
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_shiftreg_lock);
+}
+
+// Gather the registered chains sharing the clock and latch lines of a chain
+static size_t gpio_shiftreg_group(const gpio_shiftreg_config_t *cfg,
+                                  gpio_shiftreg_t **chains, uint64_t *lanes,
+                                  uint8_t *length)
+{
+  size_t count = 0;
+  *length = 0;
+
+  for (gpio_shiftreg_t *chain = __atomic_load_n(&s_shiftreg_list,
+                                                __ATOMIC_ACQUIRE);
+       chain != NULL && count < GPIO_SHIFTREG_LANES_MAX; chain = chain->next)
+  {
+    if (chain->config.type != cfg->type || chain->config.clock != cfg->clock ||
+        chain->config.latch != cfg->latch)
+      continue;
+
+    chains[count] = chain;
+    lanes[count] = 1ULL << chain->config.data;
+    if (chain->config.length > *length)
+      *length = chain->config.length;
+    count++;
+  }
+
+  return count;
+}
+
+// Shift out a 74HC595 group; the levels of @p self are given, those of the
+// other chains are their shadows, marked sent unless @p self is NULL
+static void gpio_shiftreg_flush_group(const gpio_shiftreg_config_t *cfg,
+                                      const gpio_shiftreg_t *self,
+                                      uint64_t self_levels)
+{
+  gpio_shiftreg_t *chains[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t lanes[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t levels[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t outputs[GPIO_SHIFTREG_LANES_MAX];
+  uint8_t length;
+
+  size_t count = gpio_shiftreg_group(cfg, chains, lanes, &length);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (chains[i] == self)
+      levels[i] = self_levels;
+    else
+      gpio_drv_vport_pending(&chains[i]->port, &levels[i], &outputs[i]);
+  }
+
+  gpio_shiftreg_shift_out(cfg, lanes, levels, count, length);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (chains[i] != self)
+      gpio_drv_vport_sent(&chains[i]->port, levels[i], outputs[i]);
+  }
+}
+
+static esp_err_t gpio_shiftreg_write(gpio_vport_t *port, uint64_t levels,
+                                     uint64_t outputs)
+{
+  (void)outputs;
+
+  // The port is the first member of the chain
+  gpio_shiftreg_t *self = (gpio_shiftreg_t *)port;
+  if (self->config.type == GPIO_SHIFTREG_74HC595)
+    gpio_shiftreg_flush_group(&self->config, self, levels);
+
+  return ESP_OK;
+}
+
+static esp_err_t gpio_shiftreg_read(gpio_vport_t *port, uint64_t *levels)
+{
+  gpio_shiftreg_t *self = (gpio_shiftreg_t *)port;
+  gpio_shiftreg_t *chains[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t lanes[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t words[GPIO_SHIFTREG_LANES_MAX];
+  uint8_t length;
+
+  size_t count = gpio_shiftreg_group(&self->config, chains, lanes, &length);
+  gpio_shiftreg_shift_in(&self->config, lanes, words, count, length);
+
+  // Bits past the end of a shorter chain are not its inputs
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t word = words[i] & chains[i]->port.input_capable;
+    if (chains[i] == self)
+      *levels = word;
+    else
+      gpio_drv_vport_received(&chains[i]->port, word);
+  }
+
+  return ESP_OK;
+}
+
+static const gpio_vport_ops_t s_shiftreg_595_ops = {
+    .write = gpio_shiftreg_write,
+};
+
+static const gpio_vport_ops_t s_shiftreg_165_ops = {
+    .write = gpio_shiftreg_write,
+    .read = gpio_shiftreg_read,
+};
+
+esp_err_t gpio_shiftreg_init(gpio_shiftreg_t *self,
+                             const gpio_shiftreg_config_t *config)
+{
+  if (self == NULL || config == NULL || config->length == 0 ||
+      config->length > 64 || !GPIO_IS_VALID_OUTPUT_GPIO(config->clock) ||
+      !GPIO_IS_VALID_OUTPUT_GPIO(config->latch) ||
+      config->clock == config->latch || config->data == config->clock ||
+      config->data == config->latch)
+    return ESP_ERR_INVALID_ARG;
+
+  bool out = config->type == GPIO_SHIFTREG_74HC595;
+  if ((!out && config->type != GPIO_SHIFTREG_74HC165) ||
+      (out && !GPIO_IS_VALID_OUTPUT_GPIO(config->data)) ||
+      (!out && !GPIO_IS_VALID_GPIO(config->data)))
+    return ESP_ERR_INVALID_ARG;
+
+  // Lanes of a group need their own data lines
+  gpio_shiftreg_t *chains[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t lanes[GPIO_SHIFTREG_LANES_MAX];
+  uint8_t length;
+  size_t count = gpio_shiftreg_group(config, chains, lanes, &length);
+  bool in_group = false;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (chains[i] == self)
+      in_group = true;
+    else if (chains[i]->config.data == config->data)
+      return ESP_ERR_INVALID_ARG;
+  }
+  if (count == GPIO_SHIFTREG_LANES_MAX && !in_group)
+    return ESP_ERR_NO_MEM;
+
+  bool listed = false;
+  for (gpio_shiftreg_t *chain = s_shiftreg_list; chain; chain = chain->next)
+    listed |= chain == self;
+
+  // The clock and latch lines of a group are configured again: harmless
+  esp_err_t err = gpio_set_config_output_nolog(config->clock);
+  if (err == ESP_OK)
+    err = gpio_set_config_output_nolog(config->latch);
+  if (err == ESP_OK)
+  {
+    // The data line of a 74HC165 toggles with every bit: no interrupt
+    err = out ? gpio_set_config_output_nolog(config->data)
+              : gpio_set_config_input_nolog(config->data, NULL, NULL);
+    if (err == ESP_OK && !out)
+      err = gpio_intr_disable(config->data);
+  }
+  if (err != ESP_OK)
+    return err;
+
+  // Idle: clock low, 74HC595 latch low, 74HC165 shifting (SH/LD high)
+  gpio_drv_ll_write_pin(config->clock, 0);
+  gpio_drv_ll_write_pin(config->latch, !out);
+
+  // A chain set up again keeps its place in the list, and its virtual pins
+  // if its length did not change
+  uint8_t base = listed && self->port.width == config->length
+                     ? self->port.base
+                     : 0;
+  gpio_shiftreg_t *next = listed ? self->next : NULL;
+
+  uint64_t pins = config->length == 64 ? ~0ULL
+                                       : (1ULL << config->length) - 1;
+  *self = (gpio_shiftreg_t){
+      .port =
+          {
+              .ops = out ? &s_shiftreg_595_ops : &s_shiftreg_165_ops,
+              .output_capable = out ? pins : 0,
+              .input_capable = out ? 0 : pins,
+              .width = config->length,
+              .cached = !out,
+              .base = base,
+          },
+      .config = *config,
+      .next = next,
+  };
+
+  err = gpio_vport_register(&self->port);
+  if (err != ESP_OK)
+    return err;
+
+  if (!listed)
+  {
+    GPIO_DRV_ENTER_CRITICAL(&s_shiftreg_lock);
+    self->next = s_shiftreg_list;
+    __atomic_store_n(&s_shiftreg_list, self, __ATOMIC_RELEASE);
+    GPIO_DRV_EXIT_CRITICAL(&s_shiftreg_lock);
+  }
+
+  // Clear the outputs
+  return out ? gpio_vport_flush(&self->port) : ESP_OK;
+}
+
+#if CONFIG_IDF_TARGET_LINUX
+void gpio_drv_shiftreg_reset(void)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_shiftreg_lock);
+  __atomic_store_n(&s_shiftreg_list, NULL, __ATOMIC_RELEASE);
+  GPIO_DRV_EXIT_CRITICAL(&s_shiftreg_lock);
+}
+#endif
+
+esp_err_t gpio_shiftreg_flush(gpio_shiftreg_t *self)
+{
+  if (self == NULL || self->port.base < GPIO_VPIN_BASE ||
+      self->config.type != GPIO_SHIFTREG_74HC595)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_shiftreg_t *chains[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t lanes[GPIO_SHIFTREG_LANES_MAX];
+  uint64_t levels;
+  uint64_t outputs;
+  uint8_t length;
+
+  size_t count = gpio_shiftreg_group(&self->config, chains, lanes, &length);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (gpio_drv_vport_pending(&chains[i]->port, &levels, &outputs))
+    {
+      gpio_shiftreg_flush_group(&self->config, NULL, 0);
+      break;
+    }
+  }
+
+  return ESP_OK;
+}
+
+#else
+
+esp_err_t gpio_shiftreg_init(gpio_shiftreg_t *self,
+                             const gpio_shiftreg_config_t *config)
+{
+  (void)self;
+  (void)config;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_shiftreg_flush(gpio_shiftreg_t *self)
+{
+  (void)self;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file gpio_sleep.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_sleep.h"
+
+#include <string.h>
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+// At most one class per mode, pull and interrupt type combination in use
+#define GPIO_SLEEP_MAX_CLASSES 16
+
+static const char *TAG = "GPIO_SLEEP";
+
+static uint8_t gpio_snapshot_intr_type(const gpio_snapshot_t *snapshot, int pin)
+{
+  return (snapshot->intr_types[pin / 2] >> ((pin & 1) * 4)) & 0x0F;
+}
+
+// Outputs with their input enabled read their levels back (GPIO groups)
+static gpio_mode_t gpio_snapshot_mode(const gpio_snapshot_t *snapshot,
+                                      uint64_t bit)
+{
+  if (!(snapshot->outputs & bit))
+    return GPIO_MODE_INPUT;
+
+  return (snapshot->inputs & bit) ? GPIO_MODE_INPUT_OUTPUT : GPIO_MODE_OUTPUT;
+}
+
+esp_err_t gpio_snapshot_save(gpio_snapshot_t *snapshot)
+{
+  if (snapshot == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_drv_config_t config;
+  gpio_drv_get_config(&config);
+
+  memset(snapshot, 0, sizeof(*snapshot));
+  snapshot->inputs = config.inputs;
+  snapshot->outputs = config.outputs;
+  snapshot->pull_ups = config.pull_ups;
+  snapshot->pull_downs = config.pull_downs;
+  snapshot->holds = config.holds;
+  snapshot->isrs = config.isrs;
+  snapshot->latches = config.latches;
+  snapshot->levels = gpio_drv_ll_read_outputs() & config.outputs;
+
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+    snapshot->intr_types[pin / 2] |= (config.intr_type[pin] & 0x0F)
+                                     << ((pin & 1) * 4);
+
+  snapshot->magic = GPIO_SNAPSHOT_MAGIC;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_snapshot_restore(const gpio_snapshot_t *snapshot)
+{
+  if (snapshot == NULL)
+    return ESP_ERR_INVALID_ARG;
+  if (snapshot->magic != GPIO_SNAPSHOT_MAGIC)
+    return ESP_ERR_INVALID_STATE;
+
+  // Levels before directions, so no output glitches through a stale level
+  gpio_drv_ll_write(snapshot->levels, snapshot->outputs & ~snapshot->levels);
+
+  gpio_config_t classes[GPIO_SLEEP_MAX_CLASSES];
+  int class_count = 0;
+  uint64_t pins = snapshot->inputs | snapshot->outputs;
+
+  while (pins)
+  {
+    int pin = __builtin_ctzll(pins);
+    uint64_t bit = 1ULL << pin;
+    pins &= pins - 1;
+
+    gpio_config_t config = {
+        .pin_bit_mask = bit,
+        .mode = gpio_snapshot_mode(snapshot, bit),
+        .pull_up_en = (snapshot->pull_ups & bit) ? GPIO_PULLUP_ENABLE
+                                                 : GPIO_PULLUP_DISABLE,
+        .pull_down_en = (snapshot->pull_downs & bit) ? GPIO_PULLDOWN_ENABLE
+                                                     : GPIO_PULLDOWN_DISABLE,
+        .intr_type = gpio_snapshot_intr_type(snapshot, pin),
+    };
+
+    int i = 0;
+    while (i < class_count &&
+           (classes[i].mode != config.mode ||
+            classes[i].pull_up_en != config.pull_up_en ||
+            classes[i].pull_down_en != config.pull_down_en ||
+            classes[i].intr_type != config.intr_type))
+      i++;
+
+    if (i == class_count)
+    {
+      if (class_count == GPIO_SLEEP_MAX_CLASSES)
+        return ESP_FAIL;
+      classes[class_count++] = config;
+    }
+    else
+    {
+      classes[i].pin_bit_mask |= bit;
+    }
+  }
+
+  for (int i = 0; i < class_count; i++)
+  {
+    esp_err_t err = gpio_config(&classes[i]);
+    if (err != ESP_OK)
+    {
+      GPIO_DRV_LOGE(TAG, "Restore failed");
+      return err;
+    }
+  }
+
+  // gpio_config() unmasks the CPU interrupt of any pin with a type. Stop at
+  // the first error: the pins left are tracked neither latched nor held
+  esp_err_t err = ESP_OK;
+  uint64_t latches = 0;
+  for (uint64_t rest = snapshot->latches; rest && err == ESP_OK;
+       rest &= rest - 1)
+  {
+    int pin = __builtin_ctzll(rest);
+    err = gpio_intr_disable((gpio_num_t)pin);
+    if (err == ESP_OK)
+      latches |= 1ULL << pin;
+  }
+
+  uint64_t holds = 0;
+  for (uint64_t rest = snapshot->holds; rest && err == ESP_OK;
+       rest &= rest - 1)
+  {
+    int pin = __builtin_ctzll(rest);
+    err = gpio_hold_en((gpio_num_t)pin);
+    if (err == ESP_OK)
+      holds |= 1ULL << pin;
+  }
+
+  gpio_drv_config_t config = {
+      .inputs = snapshot->inputs,
+      .outputs = snapshot->outputs,
+      .pull_ups = snapshot->pull_ups,
+      .pull_downs = snapshot->pull_downs,
+      .holds = holds,
+      .isrs = snapshot->isrs,
+      .latches = latches,
+  };
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+    config.intr_type[pin] = gpio_snapshot_intr_type(snapshot, pin);
+  gpio_drv_set_config(&config);
+
+  if (err != ESP_OK)
+    GPIO_DRV_LOGE(TAG, "Restore failed");
+
+  return err;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file gpio_telemetry.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_telemetry.h"
+
+#include "gpio_drivers.h"
+#include "gpio_drivers_ll.h"
+#include "gpio_varint.h"
+
+// Low bit of the first varint of a frame
+#define GPIO_TELEMETRY_DELTA 0
+#define GPIO_TELEMETRY_KEY 1
+
+// Gather the bits of value selected by mask into the low bits
+static uint64_t gpio_telemetry_pack(uint64_t value, uint64_t mask)
+{
+  uint64_t packed = 0;
+
+  for (int bit = 0; mask; bit++)
+  {
+    int pin = __builtin_ctzll(mask);
+    mask &= mask - 1;
+    packed |= ((value >> pin) & 1) << bit;
+  }
+
+  return packed;
+}
+
+// Inverse of gpio_telemetry_pack()
+static uint64_t gpio_telemetry_unpack(uint64_t packed, uint64_t mask)
+{
+  uint64_t value = 0;
+
+  for (int bit = 0; mask; bit++)
+  {
+    int pin = __builtin_ctzll(mask);
+    mask &= mask - 1;
+    value |= ((packed >> bit) & 1) << pin;
+  }
+
+  return value;
+}
+
+esp_err_t gpio_telemetry_init(gpio_telemetry_enc_t *enc, uint64_t pin_mask,
+                              uint32_t keyframe_us)
+{
+  if (enc == NULL || pin_mask == 0 || keyframe_us == 0 ||
+      (pin_mask >> GPIO_NUM_MAX) != 0)
+    return ESP_ERR_INVALID_ARG;
+
+  // Edge events only carry the level of their own pin: start from the
+  // levels now, or the first keyframe would report the others low
+  *enc = (gpio_telemetry_enc_t){
+      .pin_mask = pin_mask,
+      .levels = gpio_read_mask(pin_mask),
+      .keyframe_us = keyframe_us,
+  };
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_telemetry_encode(gpio_telemetry_enc_t *enc, int64_t time_us,
+                                uint64_t levels, uint8_t *buf, size_t size,
+                                size_t *len)
+{
+  if (enc == NULL || buf == NULL || len == NULL)
+    return ESP_ERR_INVALID_ARG;
+  if (size < GPIO_TELEMETRY_FRAME_MAX)
+    return ESP_ERR_INVALID_SIZE;
+
+  levels &= enc->pin_mask;
+  size_t at = 0;
+
+  if (!enc->started || time_us - enc->key_us >= enc->keyframe_us)
+  {
+    at += gpio_varint_put(buf + at,
+                          ((uint64_t)time_us << 1) | GPIO_TELEMETRY_KEY);
+    at += gpio_varint_put(buf + at, enc->pin_mask);
+    at += gpio_varint_put(buf + at,
+                          gpio_telemetry_pack(levels, enc->pin_mask));
+    enc->key_us = time_us;
+    enc->started = true;
+  }
+  else if (levels != enc->levels)
+  {
+    // Zigzag: edge events of both cores may come slightly out of order
+    int64_t delta = time_us - enc->last_us;
+    at += gpio_varint_put(buf + at, (gpio_varint_zigzag(delta) << 1) |
+                                        GPIO_TELEMETRY_DELTA);
+    at += gpio_varint_put(
+        buf + at, gpio_telemetry_pack(levels ^ enc->levels, enc->pin_mask));
+  }
+  else
+  {
+    *len = 0;
+    return ESP_OK;
+  }
+
+  enc->levels = levels;
+  enc->last_us = time_us;
+  *len = at;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_telemetry_encode_event(gpio_telemetry_enc_t *enc,
+                                      const gpio_edge_event_t *event,
+                                      uint8_t *buf, size_t size, size_t *len)
+{
+  if (enc == NULL || event == NULL || len == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t bit = 1ULL << (event->pin & 63);
+  if (event->pin >= GPIO_NUM_MAX || !(enc->pin_mask & bit))
+  {
+    *len = 0;
+    return ESP_OK;
+  }
+
+  uint64_t levels = event->level ? enc->levels | bit : enc->levels & ~bit;
+  return gpio_telemetry_encode(enc, event->time_us, levels, buf, size, len);
+}
+
+esp_err_t gpio_telemetry_poll(gpio_telemetry_enc_t *enc, uint8_t *buf,
+                              size_t size, size_t *len)
+{
+  if (enc == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t levels = gpio_read_mask(enc->pin_mask);
+  return gpio_telemetry_encode(enc, GPIO_DRV_TIME_US(), levels, buf, size,
+                               len);
+}
+
+void gpio_telemetry_decoder_init(gpio_telemetry_dec_t *dec)
+{
+  *dec = (gpio_telemetry_dec_t){0};
+}
+
+esp_err_t gpio_telemetry_decode(gpio_telemetry_dec_t *dec, const uint8_t *buf,
+                                size_t len, size_t *used)
+{
+  if (dec == NULL || buf == NULL || used == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t fields[3];
+  size_t at = 0;
+  size_t n = gpio_varint_get(buf, len, &fields[0]);
+  if (n == 0)
+    return len < GPIO_VARINT_MAX ? ESP_ERR_INVALID_SIZE : ESP_ERR_INVALID_CRC;
+  at += n;
+
+  size_t count = (fields[0] & 1) == GPIO_TELEMETRY_KEY ? 3 : 2;
+  for (size_t i = 1; i < count; i++)
+  {
+    n = gpio_varint_get(buf + at, len - at, &fields[i]);
+    if (n == 0)
+      return len - at < GPIO_VARINT_MAX ? ESP_ERR_INVALID_SIZE
+                                        : ESP_ERR_INVALID_CRC;
+    at += n;
+  }
+  *used = at;
+
+  if (count == 3)
+  {
+    if (fields[1] == 0 || (fields[1] >> GPIO_NUM_MAX) != 0)
+      return ESP_ERR_INVALID_CRC;
+
+    dec->time_us = (int64_t)(fields[0] >> 1);
+    dec->pin_mask = fields[1];
+    dec->levels = gpio_telemetry_unpack(fields[2], fields[1]);
+    dec->synced = true;
+    return ESP_OK;
+  }
+
+  if (!dec->synced)
+    return ESP_ERR_INVALID_STATE;
+
+  dec->time_us += gpio_varint_unzigzag(fields[0] >> 1);
+  dec->levels ^= gpio_telemetry_unpack(fields[1], dec->pin_mask);
+
+  return ESP_OK;
+}
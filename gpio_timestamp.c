@@ -0,0 +1,285 @@
+/**
+ * @file gpio_timestamp.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_timestamp.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_TIMESTAMP
+#include <stdbool.h>
+
+#if !CONFIG_IDF_TARGET_LINUX
+#include <esp_timer.h>
+#endif
+
+// esp_timer reads per measure. They are (1 + 1/N) us apart, so the
+// truncation to the microsecond falls on N phases spread over it
+#define GPIO_TS_SAMPLES 16
+
+// Measures by gpio_ts_init(), each shifted by a quarter of the sample
+// phase step, so the timescale starts closer than one measure gets
+#define GPIO_TS_INIT_SYNCS 4
+
+// A measure further than this from the timescale, in microseconds, steps it
+#define GPIO_TS_STEP_US 2
+
+// Move the anchor along once the counter is this far past it, well before
+// the 32-bit difference wraps
+#define GPIO_TS_REANCHOR 0x80000000UL
+
+_Static_assert(GPIO_DRV_CORES <= GPIO_TS_MAX_CORES,
+               "GPIO_TS_MAX_CORES is smaller than the number of cores");
+
+// Timescale of one core, only written on that core with interrupts masked
+typedef struct
+{
+  uint32_t anchor_cycles; /**< Cycle counter of the core at the anchor */
+  int64_t anchor;         /**< Timescale at the anchor */
+  int32_t error;          /**< Last measure minus the timescale */
+  bool synced;
+} __attribute__((aligned(GPIO_DRV_CACHE_LINE))) gpio_ts_core_t;
+
+static gpio_ts_core_t s_ts_cores[GPIO_DRV_CORES] = {0};
+static uint32_t s_ts_mhz = 0;
+static uint32_t s_ts_syncs = 0;
+static uint32_t s_ts_steps = 0;
+
+// Latest timestamp handed out on any core, and the stamps raised to it
+static uint64_t s_ts_floor = 0;
+static uint32_t s_ts_held = 0;
+
+#if !CONFIG_IDF_TARGET_LINUX
+static esp_timer_handle_t s_ts_timer = NULL;
+#endif
+
+uint64_t IRAM_ATTR gpio_ts_now(void)
+{
+  uint32_t irq = gpio_drv_ll_irq_mask();
+  gpio_ts_core_t *core = &s_ts_cores[GPIO_DRV_CORE_ID()];
+  uint32_t cycles = GPIO_DRV_CYCLES();
+  uint32_t delta = cycles - core->anchor_cycles;
+  int64_t now = core->anchor + delta;
+  bool synced = core->synced;
+
+  if (delta >= GPIO_TS_REANCHOR)
+  {
+    core->anchor_cycles = cycles;
+    core->anchor = now;
+  }
+  gpio_drv_ll_irq_restore(irq);
+
+  if (!synced)
+    return (uint64_t)GPIO_DRV_TIME_US() * GPIO_DRV_CPU_MHZ();
+
+  // The timescales of the cores agree within a few cycles only: a stamp
+  // behind one already taken on the other core is raised to it
+  uint64_t floor = __atomic_load_n(&s_ts_floor, __ATOMIC_RELAXED);
+  while ((uint64_t)now > floor)
+  {
+    if (__atomic_compare_exchange_n(&s_ts_floor, &floor, (uint64_t)now, true,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      return (uint64_t)now;
+  }
+  __atomic_fetch_add(&s_ts_held, 1, __ATOMIC_RELAXED);
+
+  return floor;
+}
+
+// Measure the timescale at the current cycle counter of the calling core,
+// the samples delayed by arg cycles, and move the core's timescale to it
+static void gpio_ts_sync_core(void *arg)
+{
+  uint32_t mhz = s_ts_mhz;
+  uint32_t irq = gpio_drv_ll_irq_mask();
+  GPIO_DRV_SPIN((uint32_t)(uintptr_t)arg);
+  gpio_ts_core_t *core = &s_ts_cores[GPIO_DRV_CORE_ID()];
+  uint32_t first = GPIO_DRV_CYCLES();
+  int64_t measure = INT64_MIN;
+
+  for (int i = 0; i < GPIO_TS_SAMPLES; i++)
+  {
+    uint32_t start = GPIO_DRV_CYCLES();
+    int64_t time_us = GPIO_DRV_TIME_US();
+    uint32_t end = GPIO_DRV_CYCLES();
+
+    // The timer was read about halfway through. Its truncation only makes
+    // the estimate smaller: the largest one is the closest
+    int64_t estimate =
+        time_us * mhz - (int64_t)(start - first) - (end - start) / 2;
+    if (estimate > measure)
+      measure = estimate;
+
+    // Whole microseconds more if the read took longer than the spacing
+    uint32_t spent = GPIO_DRV_CYCLES() - start;
+    uint32_t spacing = mhz + mhz / GPIO_TS_SAMPLES;
+    while (spacing <= spent)
+      spacing += mhz;
+    GPIO_DRV_SPIN(spacing - spent);
+  }
+
+  int64_t current = core->anchor + (uint32_t)(first - core->anchor_cycles);
+  int64_t error = measure - current;
+  int64_t step = (int64_t)GPIO_TS_STEP_US * mhz;
+
+  // Only move forward by a measure, which is never ahead of the truth
+  if (!core->synced || error > step || error < -step)
+  {
+    if (core->synced)
+      __atomic_fetch_add(&s_ts_steps, 1, __ATOMIC_RELAXED);
+    current = measure;
+
+    // A step back would hold every stamp at the floor until it caught up
+    __atomic_store_n(&s_ts_floor, 0, __ATOMIC_RELAXED);
+  }
+  else if (error > 0)
+  {
+    current = measure;
+  }
+
+  core->anchor_cycles = first;
+  core->anchor = current;
+  core->error = (int32_t)(error > INT32_MAX   ? INT32_MAX
+                          : error < INT32_MIN ? INT32_MIN
+                                              : error);
+  core->synced = true;
+  gpio_drv_ll_irq_restore(irq);
+}
+
+static esp_err_t gpio_ts_sync_shifted(uint32_t shift)
+{
+  if (s_ts_mhz == 0)
+    return ESP_ERR_INVALID_STATE;
+
+  for (int core = 0; core < GPIO_DRV_CORES; core++)
+  {
+    if (GPIO_DRV_RUN_ON_CORE(core, gpio_ts_sync_core,
+                             (void *)(uintptr_t)shift) != ESP_OK)
+      return ESP_FAIL;
+  }
+  __atomic_fetch_add(&s_ts_syncs, 1, __ATOMIC_RELAXED);
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_ts_sync(void)
+{
+  return gpio_ts_sync_shifted(0);
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static void gpio_ts_timer_cb(void *arg)
+{
+  (void)arg;
+  gpio_ts_sync();
+}
+#endif
+
+esp_err_t gpio_ts_init(void)
+{
+  // A new frequency is a new timescale: measure it from scratch
+  uint32_t mhz = GPIO_DRV_CPU_MHZ();
+  if (mhz != s_ts_mhz)
+  {
+    for (int core = 0; core < GPIO_DRV_CORES; core++)
+      s_ts_cores[core].synced = false;
+    s_ts_mhz = mhz;
+  }
+
+  uint32_t shift = mhz / (GPIO_TS_SAMPLES * GPIO_TS_INIT_SYNCS);
+  for (int i = 0; i < GPIO_TS_INIT_SYNCS; i++)
+  {
+    esp_err_t err = gpio_ts_sync_shifted(i * shift);
+    if (err != ESP_OK)
+      return err;
+  }
+
+#if !CONFIG_IDF_TARGET_LINUX
+  if (s_ts_timer == NULL)
+  {
+    const esp_timer_create_args_t args = {
+        .callback = gpio_ts_timer_cb,
+        .name = "gpio_ts",
+        .skip_unhandled_events = true,
+    };
+    if (esp_timer_create(&args, &s_ts_timer) != ESP_OK)
+      return ESP_FAIL;
+    if (esp_timer_start_periodic(
+            s_ts_timer, CONFIG_GPIO_DRIVERS_TIMESTAMP_SYNC_MS * 1000ULL) !=
+        ESP_OK)
+      return ESP_FAIL;
+  }
+#endif
+
+  return ESP_OK;
+}
+
+int64_t gpio_ts_to_us(uint64_t ts, uint32_t *cycles)
+{
+  uint32_t mhz = s_ts_mhz ? s_ts_mhz : GPIO_DRV_CPU_MHZ();
+
+  if (cycles != NULL)
+    *cycles = (uint32_t)(ts % mhz);
+
+  return (int64_t)(ts / mhz);
+}
+
+esp_err_t gpio_ts_get_stats(gpio_ts_stats_t *stats)
+{
+  if (stats == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  *stats = (gpio_ts_stats_t){
+      .mhz = s_ts_mhz,
+      .syncs = __atomic_load_n(&s_ts_syncs, __ATOMIC_RELAXED),
+      .steps = __atomic_load_n(&s_ts_steps, __ATOMIC_RELAXED),
+      .held = __atomic_load_n(&s_ts_held, __ATOMIC_RELAXED),
+  };
+  for (int core = 0; core < GPIO_DRV_CORES; core++)
+    stats->error[core] = s_ts_cores[core].error;
+
+  return ESP_OK;
+}
+
+#else
+
+esp_err_t gpio_ts_init(void)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_ts_sync(void)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+uint64_t IRAM_ATTR gpio_ts_now(void)
+{
+  return (uint64_t)GPIO_DRV_TIME_US() * GPIO_DRV_CPU_MHZ();
+}
+
+int64_t gpio_ts_to_us(uint64_t ts, uint32_t *cycles)
+{
+  uint32_t mhz = GPIO_DRV_CPU_MHZ();
+
+  if (cycles != NULL)
+    *cycles = (uint32_t)(ts % mhz);
+
+  return (int64_t)(ts / mhz);
+}
+
+esp_err_t gpio_ts_get_stats(gpio_ts_stats_t *stats)
+{
+  (void)stats;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * @file gpio_vport.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_vport.h"
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+
+#define GPIO_VPIN_COUNT CONFIG_GPIO_DRIVERS_VPIN_COUNT
+
+_Static_assert(GPIO_VPIN_BASE + GPIO_VPIN_COUNT <= GPIO_HDL_INVALID,
+               "Virtual pins must fit in a gpio_hdl_t");
+
+// Port of each virtual pin, filled once by gpio_vport_register
+static gpio_vport_t *s_vpin_ports[GPIO_VPIN_COUNT] = {NULL};
+static uint32_t s_vpin_used = 0;
+static gpio_drv_lock_t s_vport_lock = GPIO_DRV_LOCK_INITIALIZER;
+
+esp_err_t gpio_vport_register(gpio_vport_t *port)
+{
+  if (port == NULL || port->ops == NULL || port->ops->write == NULL ||
+      port->width == 0 || port->width > 64)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  if (gpio_vport_from_pin(port->base) == port)
+  {
+    // Already registered
+  }
+  else if (s_vpin_used + port->width > GPIO_VPIN_COUNT)
+  {
+    err = ESP_ERR_NO_MEM;
+  }
+  else
+  {
+    port->base = (uint8_t)(GPIO_VPIN_BASE + s_vpin_used);
+    port->shadow = 0;
+    port->outputs = 0;
+    port->sent = false;
+    port->inputs_valid = 0;
+    port->stats = (gpio_vport_stats_t){0};
+    for (uint32_t i = 0; i < port->width; i++)
+      __atomic_store_n(&s_vpin_ports[s_vpin_used + i], port, __ATOMIC_RELEASE);
+    s_vpin_used += port->width;
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+
+  return err;
+}
+
+gpio_vport_t *gpio_vport_from_pin(gpio_pinout_t pin)
+{
+  if ((unsigned)pin < GPIO_VPIN_BASE ||
+      (unsigned)pin >= GPIO_VPIN_BASE + GPIO_VPIN_COUNT)
+    return NULL;
+
+  return __atomic_load_n(&s_vpin_ports[pin - GPIO_VPIN_BASE], __ATOMIC_ACQUIRE);
+}
+
+esp_err_t gpio_vport_flush(gpio_vport_t *port)
+{
+  if (port == NULL || port->base < GPIO_VPIN_BASE)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t shadow;
+  uint64_t outputs;
+  if (!gpio_drv_vport_pending(port, &shadow, &outputs))
+    return ESP_OK;
+
+  // The bus transaction runs outside the lock; writes made meanwhile differ
+  // from the sent shadow and go with the next flush
+  esp_err_t err = port->ops->write(port, shadow, outputs);
+  if (err != ESP_OK)
+    return err;
+
+  gpio_drv_vport_sent(port, shadow, outputs);
+
+  return ESP_OK;
+}
+
+bool gpio_drv_vport_pending(gpio_vport_t *port, uint64_t *levels,
+                            uint64_t *outputs)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  *levels = port->shadow;
+  *outputs = port->outputs;
+  bool changed = !port->sent || *levels != port->sent_shadow ||
+                 *outputs != port->sent_outputs;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+
+  return changed;
+}
+
+void gpio_drv_vport_sent(gpio_vport_t *port, uint64_t levels,
+                         uint64_t outputs)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  port->sent_shadow = levels;
+  port->sent_outputs = outputs;
+  port->sent = true;
+  port->stats.flushes++;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+}
+
+void gpio_drv_vport_received(gpio_vport_t *port, uint64_t levels)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  port->inputs = levels;
+  port->stats.reads++;
+  __atomic_store_n(&port->inputs_valid, 1, __ATOMIC_RELEASE);
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+}
+
+esp_err_t gpio_vport_flush_all(void)
+{
+  esp_err_t first = ESP_OK;
+
+  for (uint32_t i = 0; i < GPIO_VPIN_COUNT;)
+  {
+    gpio_vport_t *port = __atomic_load_n(&s_vpin_ports[i], __ATOMIC_ACQUIRE);
+    if (port == NULL)
+      break;
+
+    esp_err_t err = gpio_vport_flush(port);
+    if (first == ESP_OK)
+      first = err;
+    i += port->width;
+  }
+
+  return first;
+}
+
+esp_err_t gpio_vport_refresh(gpio_vport_t *port)
+{
+  if (port == NULL || port->base < GPIO_VPIN_BASE)
+    return ESP_ERR_INVALID_ARG;
+  if (port->ops->read == NULL)
+    return ESP_ERR_NOT_SUPPORTED;
+
+  // Valid before the read: an interrupt during the transaction invalidates
+  // the cache again, so its change is not lost
+  __atomic_store_n(&port->inputs_valid, 1, __ATOMIC_RELEASE);
+
+  uint64_t levels;
+  esp_err_t err = port->ops->read(port, &levels);
+
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  if (err == ESP_OK)
+  {
+    port->inputs = levels;
+    port->stats.reads++;
+  }
+  else
+  {
+    __atomic_store_n(&port->inputs_valid, 0, __ATOMIC_RELEASE);
+  }
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+
+  return err;
+}
+
+void IRAM_ATTR gpio_vport_invalidate(gpio_vport_t *port)
+{
+  if (port != NULL)
+    __atomic_store_n(&port->inputs_valid, 0, __ATOMIC_RELEASE);
+}
+
+esp_err_t gpio_vport_get_stats(gpio_vport_t *port, gpio_vport_stats_t *stats)
+{
+  if (port == NULL || stats == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  *stats = port->stats;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+
+  return ESP_OK;
+}
+
+static esp_err_t gpio_vpin_init(gpio_t *self, bool log, bool configure)
+{
+  // Virtual pins are set up in their port, which has no ISR
+  (void)log;
+  (void)configure;
+  gpio_vport_t *port = gpio_vport_from_pin(self->pin);
+  if (port == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t bit = 1ULL << (self->pin - port->base);
+  switch (self->_mode)
+  {
+    case GPIO_MODE_INPUT:
+    {
+      if (!(port->input_capable & bit))
+        return ESP_ERR_INVALID_ARG;
+      if (self->isr_handler != NULL)
+        return ESP_ERR_NOT_SUPPORTED;
+
+      GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+      port->outputs &= ~bit;
+      GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+      gpio_vport_invalidate(port);
+      break;
+    }
+    case GPIO_MODE_OUTPUT:
+    {
+      if (!(port->output_capable & bit))
+        return ESP_ERR_INVALID_ARG;
+
+      GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+      port->outputs |= bit;
+      if (self->_act_state)
+        port->shadow |= bit;
+      else
+        port->shadow &= ~bit;
+      GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+      break;
+    }
+    default:
+    {
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+
+  // Configuration takes effect at once, as for native pins
+  return gpio_vport_flush(port);
+}
+
+static esp_err_t gpio_vpin_write(uint32_t pin, uint32_t level)
+{
+  gpio_vport_t *port = gpio_vport_from_pin(pin);
+  if (port == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t bit = 1ULL << (pin - port->base);
+
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  if (level)
+    port->shadow |= bit;
+  else
+    port->shadow &= ~bit;
+  port->stats.writes++;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+
+  return ESP_OK;
+}
+
+static void gpio_vpin_toggle(uint32_t pin)
+{
+  gpio_vport_t *port = gpio_vport_from_pin(pin);
+  if (port == NULL)
+    return;
+
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  port->shadow ^= 1ULL << (pin - port->base);
+  port->stats.writes++;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+}
+
+static uint32_t gpio_vpin_read(uint32_t pin)
+{
+  gpio_vport_t *port = gpio_vport_from_pin(pin);
+  if (port == NULL)
+    return 0;
+
+  uint32_t bit = pin - port->base;
+
+  // Output-only ports read back what was written
+  if (port->ops->read == NULL)
+    return (uint32_t)(port->shadow >> bit) & 1;
+
+  if (port->cached && __atomic_load_n(&port->inputs_valid, __ATOMIC_ACQUIRE))
+  {
+    GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+    port->stats.cache_hits++;
+    GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+  }
+  else
+  {
+    gpio_vport_refresh(port);
+  }
+
+  return (uint32_t)(port->inputs >> bit) & 1;
+}
+
+const DRAM_ATTR gpio_drv_backend_t gpio_drv_vport_backend = {
+    .init = gpio_vpin_init,
+    .write = gpio_vpin_write,
+    .read = gpio_vpin_read,
+    .toggle = gpio_vpin_toggle,
+};
+
+#if CONFIG_IDF_TARGET_LINUX
+void gpio_drv_vport_reset(void)
+{
+  GPIO_DRV_ENTER_CRITICAL(&s_vport_lock);
+  for (uint32_t i = 0; i < GPIO_VPIN_COUNT; i++)
+    __atomic_store_n(&s_vpin_ports[i], NULL, __ATOMIC_RELEASE);
+  s_vpin_used = 0;
+  GPIO_DRV_EXIT_CRITICAL(&s_vport_lock);
+}
+#endif
+
+#else
+
+esp_err_t gpio_vport_register(gpio_vport_t *port)
+{
+  (void)port;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_vport_flush(gpio_vport_t *port)
+{
+  (void)port;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_vport_flush_all(void)
+{
+  return ESP_OK;
+}
+
+esp_err_t gpio_vport_refresh(gpio_vport_t *port)
+{
+  (void)port;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+void gpio_vport_invalidate(gpio_vport_t *port)
+{
+  (void)port;
+}
+
+gpio_vport_t *gpio_vport_from_pin(gpio_pinout_t pin)
+{
+  (void)pin;
+  return NULL;
+}
+
+esp_err_t gpio_vport_get_stats(gpio_vport_t *port, gpio_vport_stats_t *stats)
+{
+  (void)port;
+  (void)stats;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
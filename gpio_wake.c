@@ -0,0 +1,266 @@
+/**
+ * @file gpio_wake.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_wake.h"
+
+#include <esp_attr.h>
+#include <esp_sleep.h>
+#if !CONFIG_IDF_TARGET_LINUX
+#include <driver/rtc_io.h>
+#include <soc/rtc_cntl_reg.h>
+#include <soc/rtc_io_reg.h>
+#include <soc/soc.h>
+#endif
+
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+
+static esp_err_t gpio_wake_check_inputs(uint64_t pin_mask)
+{
+  gpio_drv_config_t config;
+  gpio_drv_get_config(&config);
+
+  if (pin_mask == 0 || (pin_mask & ~config.inputs))
+    return ESP_ERR_INVALID_ARG;
+
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+  {
+    if (gpio_get_instance(__builtin_ctzll(pins)) == NULL)
+      return ESP_ERR_INVALID_ARG;
+  }
+
+  return ESP_OK;
+}
+
+// Arm each input on the level it does not have, so any change wakes the chip.
+// The wake-up level is the interrupt type of the pin: mask the CPU interrupt
+// first, or a handler added to it would run again and again once it holds
+static esp_err_t gpio_wake_arm(uint64_t pin_mask, uint64_t inputs)
+{
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+  {
+    int pin = __builtin_ctzll(pins);
+    gpio_int_type_t level = ((inputs >> pin) & 1) ? GPIO_INTR_LOW_LEVEL
+                                                  : GPIO_INTR_HIGH_LEVEL;
+    esp_err_t err = gpio_intr_disable(pin);
+    if (err == ESP_OK)
+      err = gpio_wakeup_enable(pin, level);
+    if (err != ESP_OK)
+      return err;
+  }
+
+  // Drop what the previous types latched, and the level that woke the chip
+  gpio_drv_ll_intr_clear(pin_mask);
+
+  return ESP_OK;
+}
+
+// Restore the interrupt types, without the levels latched while armed, then
+// unmask the inputs with a handler (latching inputs stay masked)
+static void gpio_wake_disarm(uint64_t pin_mask)
+{
+  gpio_drv_config_t config;
+  gpio_drv_get_config(&config);
+
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+  {
+    int pin = __builtin_ctzll(pins);
+    gpio_wakeup_disable(pin);
+    gpio_set_intr_type(pin, config.intr_type[pin]);
+  }
+
+  gpio_drv_ll_intr_clear(pin_mask);
+
+  uint64_t isrs = pin_mask & config.isrs & ~config.latches;
+  for (uint64_t pins = isrs; pins; pins &= pins - 1)
+    gpio_intr_enable(__builtin_ctzll(pins));
+}
+
+esp_err_t gpio_wake_light_sleep(const gpio_wake_pattern_t *pattern,
+                                uint32_t *rejected)
+{
+  if (pattern == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = gpio_wake_check_inputs(pattern->pin_mask);
+  if (err != ESP_OK)
+    return err;
+
+  err = esp_sleep_enable_gpio_wakeup();
+  if (err != ESP_OK)
+    return err;
+
+  uint32_t mismatches = 0;
+  uint64_t inputs = gpio_drv_ll_read();
+
+  while (!gpio_wake_pattern_match(pattern, inputs))
+  {
+    err = gpio_wake_arm(pattern->pin_mask, inputs);
+    if (err == ESP_OK)
+      err = esp_light_sleep_start();
+    if (err != ESP_OK)
+      break;
+
+    inputs = gpio_drv_ll_read();
+    if (!gpio_wake_pattern_match(pattern, inputs))
+      mismatches++;
+  }
+
+  gpio_wake_disarm(pattern->pin_mask);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+
+  if (rejected != NULL)
+    *rejected = mismatches;
+
+  return err;
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static const char *TAG = "GPIO_WAKE";
+
+// Pattern checked by the wake stub, kept across deep sleep
+static RTC_DATA_ATTR gpio_wake_pattern_t s_wake_pattern;
+static RTC_DATA_ATTR uint32_t s_wake_rejected;
+// RTC IO number of each checked input, for the wake stub
+static RTC_DATA_ATTR uint8_t s_wake_rtc_io[GPIO_NUM_MAX];
+
+#if CONFIG_GPIO_DRIVERS_WAKE_STUB
+// The checked inputs are on their RTC function: read them from the RTC IO
+// input register, as ext1 does. Plain loops, as __builtin_ctzll() may call
+// libgcc, in flash
+static uint64_t RTC_IRAM_ATTR gpio_wake_stub_read(void)
+{
+  uint32_t rtc_in = REG_GET_FIELD(RTC_GPIO_IN_REG, RTC_GPIO_IN_NEXT);
+  uint64_t inputs = 0;
+
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+  {
+    if (((s_wake_pattern.pin_mask >> pin) & 1) &&
+        ((rtc_in >> s_wake_rtc_io[pin]) & 1))
+      inputs |= 1ULL << pin;
+  }
+
+  return inputs;
+}
+
+// Write the ext1 registers directly, as esp_sleep_enable_ext1_wakeup() is
+// in flash; the pads were set up by gpio_wake_deep_sleep()
+static void RTC_IRAM_ATTR gpio_wake_stub_arm(uint64_t inputs)
+{
+  gpio_wake_ext1_t ext1 = gpio_wake_ext1_next(&s_wake_pattern, inputs);
+
+  uint32_t rtc_mask = 0;
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+  {
+    if ((ext1.pin_mask >> pin) & 1)
+      rtc_mask |= 1U << s_wake_rtc_io[pin];
+  }
+
+  REG_SET_BIT(RTC_CNTL_EXT_WAKEUP1_REG, RTC_CNTL_EXT_WAKEUP1_STATUS_CLR);
+  REG_SET_FIELD(RTC_CNTL_EXT_WAKEUP1_REG, RTC_CNTL_EXT_WAKEUP1_SEL, rtc_mask);
+  if (ext1.any_high)
+    REG_SET_BIT(RTC_CNTL_EXT_WAKEUP_CONF_REG, RTC_CNTL_EXT_WAKEUP1_LV);
+  else
+    REG_CLR_BIT(RTC_CNTL_EXT_WAKEUP_CONF_REG, RTC_CNTL_EXT_WAKEUP1_LV);
+}
+
+// Runs from RTC fast memory before the bootloader: only registers and RTC
+// data can be used, so the decision is a register read and a compare. On a
+// mismatch, the condition that woke the chip may still hold: re-arm on one
+// that does not, or the chip would wake again at once
+void RTC_IRAM_ATTR esp_wake_deep_sleep(void)
+{
+  uint64_t inputs = gpio_wake_stub_read();
+
+  if (!gpio_wake_pattern_match(&s_wake_pattern, inputs))
+  {
+    s_wake_rejected++;
+    gpio_wake_stub_arm(inputs);
+    esp_wake_stub_sleep(&esp_wake_deep_sleep);
+  }
+
+  esp_default_wake_deep_sleep();
+}
+#endif
+
+// Switch the checked inputs to their RTC function, which ext1 samples, with
+// the pulls the driver gave them
+static esp_err_t gpio_wake_rtc_inputs(uint64_t pin_mask)
+{
+  gpio_drv_config_t config;
+  gpio_drv_get_config(&config);
+
+  for (uint64_t pins = pin_mask; pins; pins &= pins - 1)
+  {
+    int pin = __builtin_ctzll(pins);
+    if (!rtc_gpio_is_valid_gpio((gpio_num_t)pin))
+      return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = rtc_gpio_init((gpio_num_t)pin);
+    if (err == ESP_OK)
+      err = rtc_gpio_set_direction(pin, RTC_GPIO_MODE_INPUT_ONLY);
+    if (err == ESP_OK)
+      err = ((config.pull_ups >> pin) & 1) ? rtc_gpio_pullup_en(pin)
+                                           : rtc_gpio_pullup_dis(pin);
+    if (err == ESP_OK)
+      err = ((config.pull_downs >> pin) & 1) ? rtc_gpio_pulldown_en(pin)
+                                             : rtc_gpio_pulldown_dis(pin);
+    if (err != ESP_OK)
+      return err;
+
+    s_wake_rtc_io[pin] = (uint8_t)rtc_io_number_get(pin);
+  }
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_wake_deep_sleep(const gpio_wake_pattern_t *pattern)
+{
+  if (pattern == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = gpio_wake_check_inputs(pattern->pin_mask);
+  if (err != ESP_OK)
+    return err;
+
+  uint64_t inputs = gpio_drv_ll_read();
+  if (gpio_wake_pattern_match(pattern, inputs))
+    return ESP_OK;
+
+  gpio_wake_ext1_t ext1 = gpio_wake_ext1_next(pattern, inputs);
+  err = gpio_wake_rtc_inputs(pattern->pin_mask);
+  if (err == ESP_OK)
+    err = esp_sleep_enable_ext1_wakeup(ext1.pin_mask,
+                                       ext1.any_high ? ESP_EXT1_WAKEUP_ANY_HIGH
+                                                     : ESP_EXT1_WAKEUP_ALL_LOW);
+  if (err != ESP_OK)
+  {
+    GPIO_DRV_LOGE(TAG, "Pattern pins cannot wake from deep sleep");
+    for (uint64_t pins = pattern->pin_mask; pins; pins &= pins - 1)
+    {
+      gpio_num_t pin = (gpio_num_t)__builtin_ctzll(pins);
+      if (rtc_gpio_is_valid_gpio(pin))
+        rtc_gpio_deinit(pin);
+    }
+    return err;
+  }
+
+  s_wake_pattern = *pattern;
+  esp_deep_sleep_start();
+
+  return ESP_FAIL;
+}
+
+uint32_t gpio_wake_get_rejected(void)
+{
+  return s_wake_rejected;
+}
+#endif
@@ -0,0 +1,1089 @@
+/**
+ * @file gpio_sim.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_sim.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "gpio_sim_priv.h"
+
+#define GPIO_SIM_PIN_COUNT 40
+#define GPIO_SIM_DEFAULT_MHZ 240
+#define GPIO_SIM_PIN_BIT(pin) (1ULL << (pin))
+#define GPIO_SIM_VECTOR_MAX 4
+
+typedef struct
+{
+  gpio_isr_t isr_handler;    /**< Handler added through the ISR service */
+  void *isr_handler_arg;     /**< Argument to the handler */
+  gpio_int_type_t intr_type; /**< Interrupt type of the pin */
+  uint64_t output_edges;     /**< Output transitions of the pin */
+} gpio_sim_pin_t;
+
+// Handler registered with gpio_isr_register()
+struct gpio_sim_vector
+{
+  void (*fn)(void *arg);
+  void *arg;
+};
+
+typedef struct
+{
+  uint64_t out;        /**< Output register of both banks */
+  uint64_t out_en;     /**< Output enabled pins */
+  uint64_t in_en;      /**< Input enabled pins */
+  uint64_t pull_up;    /**< Pins with the pull-up enabled */
+  uint64_t pull_down;  /**< Pins with the pull-down enabled */
+  uint64_t ext;        /**< Levels applied from outside the chip */
+  uint64_t ext_driven; /**< Pins driven from outside the chip */
+  uint64_t intr_ena;   /**< Pins with their interrupt enabled */
+  uint64_t status;     /**< Interrupt status latch */
+  uint64_t sensed;     /**< Levels seen by the input stage */
+  uint64_t outputs;    /**< Levels driven by the output stage */
+  uint64_t hold;       /**< Pins whose pad state is held */
+  uint64_t held_out;   /**< Output register bits latched by the hold */
+  uint64_t held_out_en; /**< Output enable bits latched by the hold */
+  uint64_t wakeup;     /**< Light-sleep wake-up pins, on their level type */
+
+  bool isr_service_installed;
+  int isr_service_flags;
+  bool in_isr;
+
+  // Handlers of gpio_isr_register(), run from the latest as in the IDF
+  // shared interrupt chain
+  struct gpio_sim_vector vectors[GPIO_SIM_VECTOR_MAX];
+  uint32_t vector_count;
+  int vector_flags;
+  uint32_t irq_masked[GPIO_SIM_CTX_MAX];
+
+  bool threaded;         /**< Core and interrupt threads are running */
+  bool stop;             /**< Ask the interrupt thread to exit */
+  bool preempted;        /**< The interrupt core is parked for the ISR */
+  gpio_sim_core_t isr_core;
+  bool core_idle[GPIO_SIM_CORE_MAX];
+
+  uint64_t now;
+  uint32_t mhz;
+  uint32_t cycle_offset[GPIO_SIM_CORE_MAX];
+  gpio_sim_cost_t cost;
+  gpio_sim_stats_t stats;
+  gpio_sim_pin_t pins[GPIO_SIM_PIN_COUNT];
+} gpio_sim_t;
+
+typedef struct
+{
+  gpio_sim_core_t core;
+  gpio_sim_core_fn_t fn;
+  void *arg;
+} gpio_sim_core_start_t;
+
+static gpio_sim_t s_sim = {.mhz = GPIO_SIM_DEFAULT_MHZ};
+
+// Serializes every access to s_sim, like the bus of the real chip
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_isr_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_core_cond = PTHREAD_COND_INITIALIZER;
+
+// Backs the driver critical sections (a spinlock on the real chip)
+static pthread_mutex_t s_critical_lock;
+static pthread_once_t s_critical_once = PTHREAD_ONCE_INIT;
+static _Thread_local uint32_t s_critical_depth = 0;
+static _Thread_local uint32_t s_critical_irq = 0;
+
+static _Thread_local gpio_sim_ctx_t s_ctx = GPIO_SIM_CTX_CORE0;
+
+void gpio_sim_lock(void)
+{
+  pthread_mutex_lock(&s_lock);
+}
+
+void gpio_sim_unlock(void)
+{
+  pthread_mutex_unlock(&s_lock);
+}
+
+static bool gpio_sim_is_valid(gpio_num_t pin)
+{
+  return pin >= 0 && pin < GPIO_SIM_PIN_COUNT && GPIO_IS_VALID_GPIO(pin);
+}
+
+// Output register and enable seen by the pads, where held pins keep the
+// state latched by gpio_hold_en()
+static uint64_t gpio_sim_pad_out(void)
+{
+  return (s_sim.out & ~s_sim.hold) | (s_sim.held_out & s_sim.hold);
+}
+
+static uint64_t gpio_sim_pad_out_en(void)
+{
+  return (s_sim.out_en & ~s_sim.hold) | (s_sim.held_out_en & s_sim.hold);
+}
+
+static uint64_t gpio_sim_levels(void)
+{
+  uint64_t out = gpio_sim_pad_out();
+  uint64_t out_en = gpio_sim_pad_out_en();
+  uint64_t floating = ~out_en & ~s_sim.ext_driven;
+
+  uint64_t levels = (out_en & out) |
+                    (~out_en & s_sim.ext_driven & s_sim.ext) |
+                    (floating & s_sim.pull_up & ~s_sim.pull_down);
+
+  // Shift-register models drive their data line when it is an input
+  levels = (levels & out_en) | (gpio_sim_shiftreg_levels(levels) & ~out_en);
+
+  return gpio_sim_fault_levels(levels) & s_sim.in_en;
+}
+
+static bool gpio_sim_triggers(gpio_int_type_t type, bool before, bool after)
+{
+  switch (type)
+  {
+    case GPIO_INTR_POSEDGE:
+      return !before && after;
+    case GPIO_INTR_NEGEDGE:
+      return before && !after;
+    case GPIO_INTR_ANYEDGE:
+      return before != after;
+    case GPIO_INTR_LOW_LEVEL:
+      return !after;
+    case GPIO_INTR_HIGH_LEVEL:
+      return after;
+    default:
+      return false;
+  }
+}
+
+static bool gpio_sim_irq_pending(void)
+{
+  return (s_sim.isr_service_installed || s_sim.vector_count) &&
+         (s_sim.status & s_sim.intr_ena);
+}
+
+// Run the gpio_isr_register() handlers once. Called and returns with s_lock
+// held, but releases it while a handler runs.
+static void gpio_sim_run_vectors(void)
+{
+  s_sim.now += s_sim.cost.isr_vector;
+  s_sim.in_isr = true;
+
+  for (uint32_t i = s_sim.vector_count; i-- > 0;)
+  {
+    struct gpio_sim_vector vector = s_sim.vectors[i];
+    gpio_sim_unlock();
+    vector.fn(vector.arg);
+    gpio_sim_lock();
+  }
+
+  s_sim.in_isr = false;
+}
+
+// Run the handler of every pending interrupt. Called and returns with
+// s_lock held, but releases it while a handler runs.
+static void gpio_sim_run_isrs(void)
+{
+  while (gpio_sim_irq_pending())
+  {
+    uint64_t pending = s_sim.status & s_sim.intr_ena;
+    if (s_sim.vector_count)
+    {
+      gpio_sim_run_vectors();
+
+      // Without the service nobody clears the rest: the real interrupt
+      // would fire again forever
+      if (!s_sim.isr_service_installed)
+      {
+        if (!(pending & ~s_sim.status))
+          break;
+        continue;
+      }
+    }
+
+    while (s_sim.isr_service_installed && (s_sim.status & s_sim.intr_ena))
+    {
+      int pin = __builtin_ctzll(s_sim.status & s_sim.intr_ena);
+      gpio_sim_pin_t *p = &s_sim.pins[pin];
+
+      s_sim.status &= ~GPIO_SIM_PIN_BIT(pin);
+      if (p->isr_handler == NULL)
+        continue;
+
+      gpio_isr_t handler = p->isr_handler;
+      void *arg = p->isr_handler_arg;
+      s_sim.now += s_sim.cost.isr_entry;
+      s_sim.stats.isrs++;
+      s_sim.in_isr = true;
+
+      gpio_sim_unlock();
+      handler(arg);
+      gpio_sim_lock();
+
+      s_sim.in_isr = false;
+    }
+  }
+}
+
+static void gpio_sim_dispatch(void)
+{
+  if (!gpio_sim_irq_pending())
+    return;
+
+  // With threads, the interrupt thread takes over at the next preemption
+  // point of the interrupt core
+  if (s_sim.threaded)
+  {
+    pthread_cond_broadcast(&s_isr_cond);
+    return;
+  }
+
+  if (s_sim.irq_masked[s_ctx] || s_sim.in_isr)
+    return;
+
+  gpio_sim_run_isrs();
+}
+
+// Park the interrupt core while the interrupt thread runs the handlers
+static void gpio_sim_preempt(void)
+{
+  if (!s_sim.threaded || (int)s_ctx != (int)s_sim.isr_core)
+    return;
+
+  while (gpio_sim_irq_pending() && !s_sim.irq_masked[s_ctx])
+  {
+    s_sim.preempted = true;
+    pthread_cond_broadcast(&s_isr_cond);
+    while (s_sim.preempted)
+      pthread_cond_wait(&s_core_cond, &s_lock);
+  }
+}
+
+static void gpio_sim_sense(void);
+
+// Apply the fault events due up to a time, each at its own time
+static void gpio_sim_run_faults(uint64_t until)
+{
+  uint64_t at = 0;
+
+  while (gpio_sim_fault_next(&at) && at <= until)
+  {
+    if (at > s_sim.now)
+      s_sim.now = at;
+    gpio_sim_fault_fire(at);
+    gpio_sim_sense();
+  }
+}
+
+// Entry of every operation issued by the simulated CPU. With threads, give
+// the other contexts a chance to interleave, as the real cores would.
+static void gpio_sim_enter(void)
+{
+  if (__atomic_load_n(&s_sim.threaded, __ATOMIC_RELAXED))
+    sched_yield();
+
+  gpio_sim_lock();
+  gpio_sim_run_faults(s_sim.now);
+  gpio_sim_preempt();
+}
+
+// Latch the interrupt status of every pin whose sensed level changed
+static void gpio_sim_sense(void)
+{
+  uint64_t outputs = gpio_sim_pad_out() & gpio_sim_pad_out_en();
+  uint64_t toggled = outputs ^ s_sim.outputs;
+  if (toggled)
+  {
+    gpio_sim_rec_outputs(gpio_sim_cycles_to_ns(s_sim.now), s_sim.outputs,
+                         outputs);
+    gpio_sim_shiftreg_outputs(s_sim.outputs, outputs);
+    s_sim.outputs = outputs;
+    while (toggled)
+    {
+      s_sim.pins[__builtin_ctzll(toggled)].output_edges++;
+      toggled &= toggled - 1;
+    }
+  }
+
+  uint64_t before = s_sim.sensed;
+  uint64_t after = gpio_sim_levels();
+  s_sim.sensed = after;
+
+  for (int pin = 0; pin < GPIO_SIM_PIN_COUNT; pin++)
+  {
+    gpio_int_type_t type = s_sim.pins[pin].intr_type;
+    bool was = (before >> pin) & 1;
+    bool is = (after >> pin) & 1;
+    bool level_type = type == GPIO_INTR_LOW_LEVEL || type == GPIO_INTR_HIGH_LEVEL;
+
+    if ((was != is || level_type) && gpio_sim_triggers(type, was, is))
+      s_sim.status |= GPIO_SIM_PIN_BIT(pin);
+  }
+
+  gpio_sim_dispatch();
+}
+
+static uint32_t gpio_sim_reg_read_locked(gpio_sim_reg_t reg)
+{
+  s_sim.now += s_sim.cost.reg_read;
+  s_sim.stats.reg_reads++;
+
+  switch (reg)
+  {
+    case GPIO_SIM_REG_OUT:
+      return (uint32_t)s_sim.out;
+    case GPIO_SIM_REG_OUT1:
+      return (uint32_t)(s_sim.out >> 32) & 0xFF;
+    case GPIO_SIM_REG_IN:
+      return (uint32_t)s_sim.sensed;
+    case GPIO_SIM_REG_IN1:
+      return (uint32_t)(s_sim.sensed >> 32) & 0xFF;
+    case GPIO_SIM_REG_STATUS:
+      return (uint32_t)s_sim.status;
+    case GPIO_SIM_REG_STATUS1:
+      return (uint32_t)(s_sim.status >> 32) & 0xFF;
+    default:
+      return 0;
+  }
+}
+
+static void gpio_sim_reg_write_locked(gpio_sim_reg_t reg, uint32_t value)
+{
+  s_sim.now += s_sim.cost.reg_write;
+  s_sim.stats.reg_writes++;
+
+  switch (reg)
+  {
+    case GPIO_SIM_REG_OUT_W1TS:
+      s_sim.out |= value;
+      break;
+    case GPIO_SIM_REG_OUT_W1TC:
+      s_sim.out &= ~(uint64_t)value;
+      break;
+    case GPIO_SIM_REG_OUT1_W1TS:
+      s_sim.out |= (uint64_t)(value & 0xFF) << 32;
+      break;
+    case GPIO_SIM_REG_OUT1_W1TC:
+      s_sim.out &= ~((uint64_t)(value & 0xFF) << 32);
+      break;
+    case GPIO_SIM_REG_STATUS_W1TC:
+      s_sim.status &= ~(uint64_t)value;
+      return;
+    case GPIO_SIM_REG_STATUS1_W1TC:
+      s_sim.status &= ~((uint64_t)(value & 0xFF) << 32);
+      return;
+    default:
+      return;
+  }
+
+  gpio_sim_sense();
+}
+
+void gpio_sim_reset(void)
+{
+  gpio_sim_lock();
+  gpio_sim_cost_t cost = s_sim.cost;
+  uint32_t mhz = s_sim.mhz;
+
+  memset(&s_sim, 0, sizeof(s_sim));
+  s_sim.cost = cost;
+  s_sim.mhz = mhz;
+  gpio_sim_unlock();
+}
+
+void gpio_sim_set_cost(const gpio_sim_cost_t *cost)
+{
+  gpio_sim_lock();
+  if (cost == NULL)
+    memset(&s_sim.cost, 0, sizeof(s_sim.cost));
+  else
+    s_sim.cost = *cost;
+  gpio_sim_unlock();
+}
+
+void gpio_sim_set_cpu_freq(uint32_t mhz)
+{
+  gpio_sim_lock();
+  s_sim.mhz = mhz ? mhz : GPIO_SIM_DEFAULT_MHZ;
+  gpio_sim_unlock();
+}
+
+uint32_t gpio_sim_get_cpu_freq(void)
+{
+  gpio_sim_lock();
+  uint32_t mhz = s_sim.mhz;
+  gpio_sim_unlock();
+  return mhz;
+}
+
+uint64_t gpio_sim_now(void)
+{
+  gpio_sim_lock();
+  uint64_t now = s_sim.now;
+  gpio_sim_unlock();
+  return now;
+}
+
+uint64_t gpio_sim_now_ns(void)
+{
+  return gpio_sim_cycles_to_ns(gpio_sim_now());
+}
+
+uint32_t gpio_sim_cycles(void)
+{
+  gpio_sim_lock();
+  s_sim.now += s_sim.cost.cycle_read;
+  uint32_t cycles =
+      (uint32_t)s_sim.now + s_sim.cycle_offset[gpio_sim_current_core()];
+  gpio_sim_unlock();
+  return cycles;
+}
+
+void gpio_sim_set_cycle_offset(gpio_sim_core_t core, uint32_t offset)
+{
+  if (core >= GPIO_SIM_CORE_MAX)
+    return;
+
+  gpio_sim_lock();
+  s_sim.cycle_offset[core] = offset;
+  gpio_sim_unlock();
+}
+
+int64_t gpio_sim_timer_us(void)
+{
+  gpio_sim_lock();
+  uint32_t before = s_sim.cost.timer_read / 2;
+  s_sim.now += before;
+  int64_t time_us = (int64_t)(gpio_sim_cycles_to_ns(s_sim.now) / 1000);
+  s_sim.now += s_sim.cost.timer_read - before;
+  gpio_sim_unlock();
+  return time_us;
+}
+
+uint64_t gpio_sim_ns_to_cycles(uint64_t ns)
+{
+  return ns * s_sim.mhz / 1000;
+}
+
+uint64_t gpio_sim_cycles_to_ns(uint64_t cycles)
+{
+  return cycles * 1000 / s_sim.mhz;
+}
+
+void gpio_sim_advance(uint64_t cycles)
+{
+  gpio_sim_enter();
+  uint64_t until = s_sim.now + cycles;
+  gpio_sim_run_faults(until);
+  if (until > s_sim.now)
+    s_sim.now = until;
+  gpio_sim_unlock();
+}
+
+uint64_t gpio_sim_now_locked(void)
+{
+  return s_sim.now;
+}
+
+void gpio_sim_sense_locked(void)
+{
+  gpio_sim_sense();
+}
+
+void gpio_sim_get_stats(gpio_sim_stats_t *stats)
+{
+  gpio_sim_lock();
+  *stats = s_sim.stats;
+  gpio_sim_unlock();
+}
+
+void gpio_sim_set_input(gpio_num_t pin, uint32_t level)
+{
+  if (!gpio_sim_is_valid(pin))
+    return;
+
+  gpio_sim_enter();
+  s_sim.ext_driven |= GPIO_SIM_PIN_BIT(pin);
+  if (level)
+    s_sim.ext |= GPIO_SIM_PIN_BIT(pin);
+  else
+    s_sim.ext &= ~GPIO_SIM_PIN_BIT(pin);
+
+  gpio_sim_sense();
+  gpio_sim_unlock();
+}
+
+uint64_t gpio_sim_get_outputs(void)
+{
+  gpio_sim_lock();
+  uint64_t outputs = gpio_sim_pad_out() & gpio_sim_pad_out_en();
+  gpio_sim_unlock();
+  return outputs;
+}
+
+uint64_t gpio_sim_get_output_edges(gpio_num_t pin)
+{
+  if (!gpio_sim_is_valid(pin))
+    return 0;
+
+  gpio_sim_lock();
+  uint64_t edges = s_sim.pins[pin].output_edges;
+  gpio_sim_unlock();
+  return edges;
+}
+
+static void *gpio_sim_isr_thread(void *arg)
+{
+  (void)arg;
+  s_ctx = GPIO_SIM_CTX_ISR;
+
+  gpio_sim_lock();
+  while (!s_sim.stop)
+  {
+    bool can_run = gpio_sim_irq_pending() &&
+                   (s_sim.preempted || s_sim.core_idle[s_sim.isr_core]);
+    if (!can_run)
+    {
+      pthread_cond_wait(&s_isr_cond, &s_lock);
+      continue;
+    }
+
+    gpio_sim_run_isrs();
+    s_sim.preempted = false;
+    pthread_cond_broadcast(&s_core_cond);
+  }
+  gpio_sim_unlock();
+
+  return NULL;
+}
+
+static void *gpio_sim_core_thread(void *arg)
+{
+  gpio_sim_core_start_t *start = arg;
+  s_ctx = (gpio_sim_ctx_t)start->core;
+
+  start->fn(start->arg);
+
+  gpio_sim_lock();
+  s_sim.core_idle[start->core] = true;
+  pthread_cond_broadcast(&s_isr_cond);
+  gpio_sim_unlock();
+
+  return NULL;
+}
+
+esp_err_t gpio_sim_run_cores(gpio_sim_core_fn_t core0, void *arg0,
+                             gpio_sim_core_fn_t core1, void *arg1,
+                             gpio_sim_core_t isr_core)
+{
+  if (isr_core >= GPIO_SIM_CORE_MAX)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_core_start_t starts[GPIO_SIM_CORE_MAX] = {
+      {.core = GPIO_SIM_CORE_0, .fn = core0, .arg = arg0},
+      {.core = GPIO_SIM_CORE_1, .fn = core1, .arg = arg1},
+  };
+  pthread_t cores[GPIO_SIM_CORE_MAX];
+  pthread_t isr;
+
+  gpio_sim_lock();
+  if (s_sim.threaded)
+  {
+    gpio_sim_unlock();
+    return ESP_ERR_INVALID_STATE;
+  }
+  __atomic_store_n(&s_sim.threaded, true, __ATOMIC_RELAXED);
+  s_sim.stop = false;
+  s_sim.preempted = false;
+  s_sim.isr_core = isr_core;
+  for (int core = 0; core < GPIO_SIM_CORE_MAX; core++)
+    s_sim.core_idle[core] = starts[core].fn == NULL;
+  gpio_sim_unlock();
+
+  if (pthread_create(&isr, NULL, gpio_sim_isr_thread, NULL) != 0)
+  {
+    gpio_sim_lock();
+    __atomic_store_n(&s_sim.threaded, false, __ATOMIC_RELAXED);
+    gpio_sim_unlock();
+    return ESP_FAIL;
+  }
+
+  for (int core = 0; core < GPIO_SIM_CORE_MAX; core++)
+  {
+    if (starts[core].fn == NULL ||
+        pthread_create(&cores[core], NULL, gpio_sim_core_thread,
+                       &starts[core]) != 0)
+    {
+      starts[core].fn = NULL;
+      gpio_sim_lock();
+      s_sim.core_idle[core] = true;
+      pthread_cond_broadcast(&s_isr_cond);
+      gpio_sim_unlock();
+    }
+  }
+
+  for (int core = 0; core < GPIO_SIM_CORE_MAX; core++)
+  {
+    if (starts[core].fn != NULL)
+      pthread_join(cores[core], NULL);
+  }
+
+  gpio_sim_lock();
+  s_sim.stop = true;
+  pthread_cond_broadcast(&s_isr_cond);
+  gpio_sim_unlock();
+  pthread_join(isr, NULL);
+
+  gpio_sim_lock();
+  __atomic_store_n(&s_sim.threaded, false, __ATOMIC_RELAXED);
+  gpio_sim_dispatch();
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_run_on_core(gpio_sim_core_t core, gpio_sim_core_fn_t fn,
+                               void *arg)
+{
+  if (core >= GPIO_SIM_CORE_MAX || fn == NULL)
+    return ESP_ERR_INVALID_ARG;
+  if (__atomic_load_n(&s_sim.threaded, __ATOMIC_RELAXED))
+    return ESP_ERR_INVALID_STATE;
+
+  gpio_sim_ctx_t ctx = s_ctx;
+  s_ctx = (gpio_sim_ctx_t)core;
+  fn(arg);
+  s_ctx = ctx;
+
+  return ESP_OK;
+}
+
+gpio_sim_ctx_t gpio_sim_current_ctx(void)
+{
+  return s_ctx;
+}
+
+gpio_sim_core_t gpio_sim_current_core(void)
+{
+  if (s_ctx == GPIO_SIM_CTX_ISR)
+    return __atomic_load_n(&s_sim.isr_core, __ATOMIC_RELAXED);
+
+  return (gpio_sim_core_t)s_ctx;
+}
+
+uint32_t gpio_sim_reg_read(gpio_sim_reg_t reg)
+{
+  gpio_sim_enter();
+  uint32_t value = gpio_sim_reg_read_locked(reg);
+  gpio_sim_unlock();
+  return value;
+}
+
+void gpio_sim_reg_write(gpio_sim_reg_t reg, uint32_t value)
+{
+  gpio_sim_enter();
+  gpio_sim_reg_write_locked(reg, value);
+  gpio_sim_unlock();
+}
+
+uint32_t gpio_sim_irq_mask(void)
+{
+  gpio_sim_lock();
+  uint32_t state = s_sim.irq_masked[s_ctx];
+  s_sim.irq_masked[s_ctx] = 1;
+  gpio_sim_unlock();
+  return state;
+}
+
+void gpio_sim_irq_restore(uint32_t state)
+{
+  gpio_sim_lock();
+  s_sim.irq_masked[s_ctx] = state;
+  gpio_sim_dispatch();
+  gpio_sim_preempt();
+  gpio_sim_unlock();
+}
+
+static void gpio_sim_critical_init(void)
+{
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&s_critical_lock, &attr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+void gpio_sim_critical_enter(void)
+{
+  // Like portENTER_CRITICAL: no preemption while the lock is held
+  pthread_once(&s_critical_once, gpio_sim_critical_init);
+  uint32_t irq = gpio_sim_irq_mask();
+  pthread_mutex_lock(&s_critical_lock);
+  if (s_critical_depth++ == 0)
+    s_critical_irq = irq;
+}
+
+void gpio_sim_critical_exit(void)
+{
+  uint32_t irq = s_critical_irq;
+  bool outermost = --s_critical_depth == 0;
+  pthread_mutex_unlock(&s_critical_lock);
+  if (outermost)
+    gpio_sim_irq_restore(irq);
+}
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+  if (pGPIOConfig == NULL || pGPIOConfig->pin_bit_mask == 0 ||
+      (pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_GPIO_MASK))
+    return ESP_ERR_INVALID_ARG;
+  if ((pGPIOConfig->mode & GPIO_MODE_OUTPUT) &&
+      (pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.config;
+  s_sim.stats.configs++;
+
+  esp_err_t err = gpio_sim_fault_take_error(GPIO_SIM_FAIL_CONFIG);
+  if (err != ESP_OK)
+  {
+    gpio_sim_unlock();
+    return err;
+  }
+
+  uint64_t mask = pGPIOConfig->pin_bit_mask;
+  for (int pin = 0; pin < GPIO_SIM_PIN_COUNT; pin++)
+  {
+    if (!(mask & GPIO_SIM_PIN_BIT(pin)))
+      continue;
+
+    s_sim.pins[pin].intr_type = pGPIOConfig->intr_type;
+  }
+
+  if (pGPIOConfig->mode & GPIO_MODE_OUTPUT)
+    s_sim.out_en |= mask;
+  else
+    s_sim.out_en &= ~mask;
+
+  if (pGPIOConfig->mode & GPIO_MODE_INPUT)
+    s_sim.in_en |= mask;
+  else
+    s_sim.in_en &= ~mask;
+
+  if (pGPIOConfig->pull_up_en)
+    s_sim.pull_up |= mask;
+  else
+    s_sim.pull_up &= ~mask;
+
+  if (pGPIOConfig->pull_down_en)
+    s_sim.pull_down |= mask;
+  else
+    s_sim.pull_down &= ~mask;
+
+  if (pGPIOConfig->intr_type != GPIO_INTR_DISABLE)
+    s_sim.intr_ena |= mask;
+  else
+    s_sim.intr_ena &= ~mask;
+
+  // A fresh configuration must not report the edges it caused itself
+  s_sim.sensed = gpio_sim_levels();
+  s_sim.status &= ~mask;
+  gpio_sim_sense();
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_config_t io_conf = {.pin_bit_mask = GPIO_SIM_PIN_BIT(gpio_num),
+                           .mode = GPIO_MODE_DISABLE,
+                           .pull_up_en = GPIO_PULLUP_ENABLE,
+                           .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                           .intr_type = GPIO_INTR_DISABLE};
+
+  return gpio_config(&io_conf);
+}
+
+esp_err_t gpio_hold_en(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t bit = GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call;
+  if (!(s_sim.hold & bit))
+  {
+    s_sim.held_out = (s_sim.held_out & ~bit) | (s_sim.out & bit);
+    s_sim.held_out_en = (s_sim.held_out_en & ~bit) | (s_sim.out_en & bit);
+    s_sim.hold |= bit;
+  }
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call;
+  s_sim.hold &= ~GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_sense();
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  if (!GPIO_IS_VALID_OUTPUT_GPIO(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call;
+  gpio_sim_reg_write_locked(gpio_num < 32 ? (level ? GPIO_SIM_REG_OUT_W1TS
+                                                   : GPIO_SIM_REG_OUT_W1TC)
+                                          : (level ? GPIO_SIM_REG_OUT1_W1TS
+                                                   : GPIO_SIM_REG_OUT1_W1TC),
+                            1UL << (gpio_num & 31));
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return 0;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call;
+  uint32_t reg = gpio_sim_reg_read_locked(gpio_num < 32 ? GPIO_SIM_REG_IN
+                                                        : GPIO_SIM_REG_IN1);
+  gpio_sim_unlock();
+
+  return (reg >> (gpio_num & 31)) & 1;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  if (!gpio_sim_is_valid(gpio_num) || intr_type >= GPIO_INTR_MAX)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call + s_sim.cost.reg_write;
+  s_sim.pins[gpio_num].intr_type = intr_type;
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call + s_sim.cost.reg_write;
+  s_sim.intr_ena |= GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_dispatch();
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call + s_sim.cost.reg_write;
+  s_sim.intr_ena &= ~GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  if (!gpio_sim_is_valid(gpio_num) ||
+      (intr_type != GPIO_INTR_LOW_LEVEL && intr_type != GPIO_INTR_HIGH_LEVEL))
+    return ESP_ERR_INVALID_ARG;
+
+  // As in the IDF, the wake-up level is the interrupt type of the pin
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call + s_sim.cost.reg_write;
+  s_sim.pins[gpio_num].intr_type = intr_type;
+  s_sim.wakeup |= GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_enter();
+  s_sim.now += s_sim.cost.api_call + s_sim.cost.reg_write;
+  s_sim.wakeup &= ~GPIO_SIM_PIN_BIT(gpio_num);
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+bool gpio_sim_wakeup_locked(void)
+{
+  uint64_t levels = gpio_sim_levels();
+
+  for (uint64_t pins = s_sim.wakeup; pins; pins &= pins - 1)
+  {
+    int pin = __builtin_ctzll(pins);
+    if (gpio_sim_triggers(s_sim.pins[pin].intr_type, false,
+                          (levels >> pin) & 1))
+      return true;
+  }
+
+  return false;
+}
+
+// The service and the gpio_isr_register() handlers can only share the GPIO
+// interrupt if all of them asked for a shared one, as with esp_intr_alloc()
+static bool gpio_sim_isr_can_share(int intr_alloc_flags)
+{
+  if (!(intr_alloc_flags & ESP_INTR_FLAG_SHARED))
+    return !s_sim.isr_service_installed && !s_sim.vector_count;
+
+  return (!s_sim.isr_service_installed ||
+          (s_sim.isr_service_flags & ESP_INTR_FLAG_SHARED)) &&
+         (!s_sim.vector_count || (s_sim.vector_flags & ESP_INTR_FLAG_SHARED));
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+  esp_err_t err = ESP_OK;
+
+  gpio_sim_enter();
+  if (s_sim.isr_service_installed)
+  {
+    err = ESP_ERR_INVALID_STATE;
+  }
+  else if (!gpio_sim_isr_can_share(intr_alloc_flags))
+  {
+    err = ESP_ERR_NOT_FOUND;
+  }
+  else
+  {
+    s_sim.isr_service_installed = true;
+    s_sim.isr_service_flags = intr_alloc_flags;
+  }
+  gpio_sim_unlock();
+
+  return err;
+}
+
+esp_err_t gpio_isr_register(void (*fn)(void *), void *arg,
+                            int intr_alloc_flags, gpio_isr_handle_t *handle)
+{
+  if (fn == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+  gpio_sim_enter();
+  if (s_sim.vector_count == GPIO_SIM_VECTOR_MAX ||
+      !gpio_sim_isr_can_share(intr_alloc_flags))
+  {
+    err = ESP_ERR_NOT_FOUND;
+  }
+  else
+  {
+    s_sim.now += s_sim.cost.api_call;
+    s_sim.vector_flags = s_sim.vector_count
+                             ? s_sim.vector_flags & intr_alloc_flags
+                             : intr_alloc_flags;
+    s_sim.vectors[s_sim.vector_count] = (struct gpio_sim_vector){
+        .fn = fn,
+        .arg = arg,
+    };
+    if (handle != NULL)
+      *handle = &s_sim.vectors[s_sim.vector_count];
+    s_sim.vector_count++;
+  }
+  gpio_sim_unlock();
+
+  return err;
+}
+
+void gpio_uninstall_isr_service(void)
+{
+  gpio_sim_enter();
+  s_sim.isr_service_installed = false;
+  s_sim.isr_service_flags = 0;
+  for (int pin = 0; pin < GPIO_SIM_PIN_COUNT; pin++)
+    s_sim.pins[pin].isr_handler = NULL;
+  gpio_sim_unlock();
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler,
+                               void *args)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+  gpio_sim_enter();
+  if (!s_sim.isr_service_installed)
+  {
+    err = ESP_ERR_INVALID_STATE;
+  }
+  else if ((err = gpio_sim_fault_take_error(GPIO_SIM_FAIL_ISR_HANDLER_ADD)) ==
+           ESP_OK)
+  {
+    s_sim.now += s_sim.cost.api_call;
+    s_sim.pins[gpio_num].isr_handler = isr_handler;
+    s_sim.pins[gpio_num].isr_handler_arg = args;
+  }
+  gpio_sim_unlock();
+
+  return err;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+  if (!gpio_sim_is_valid(gpio_num))
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+  gpio_sim_enter();
+  if (!s_sim.isr_service_installed)
+  {
+    err = ESP_ERR_INVALID_STATE;
+  }
+  else
+  {
+    s_sim.now += s_sim.cost.api_call;
+    s_sim.pins[gpio_num].isr_handler = NULL;
+    s_sim.pins[gpio_num].isr_handler_arg = NULL;
+  }
+  gpio_sim_unlock();
+
+  return err;
+}
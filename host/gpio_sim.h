@@ -0,0 +1,710 @@
+/**
+ * @file gpio_sim.h
+ * @brief Control API of the host (linux target) GPIO simulator.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * The simulator models the ESP32 GPIO block behind the stand-in
+ * `driver/gpio.h`: output and input registers of both banks, pulls,
+ * per-pin interrupt types, the interrupt status latch, the ISR service and
+ * the handlers of gpio_isr_register().
+ *
+ * It also keeps a virtual clock, in CPU cycles. With a cost model set, every
+ * simulated operation (register access, driver call, gpio_config, interrupt
+ * entry) advances that clock, so code built on top of gpio_write can be
+ * checked for timing and throughput without hardware. The default cost model
+ * is all zeros: the simulator is then purely functional.
+ *
+ * By default everything runs on the calling thread and interrupt handlers run
+ * synchronously. gpio_sim_run_cores() instead runs "core 0", "core 1" and an
+ * "interrupt" context as real threads, for race detection under load.
+ *
+ * The header is private to the component: the host test app (host_test/)
+ * drives the simulator through it, and checks the driver with it.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_H
+#define GPIO_SIM_H
+
+#include <driver/gpio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio_expander.h"
+#include "gpio_shiftreg.h"
+
+/**
+ * @brief Simulated GPIO registers reachable through gpio_sim_reg_read/write.
+ */
+typedef enum
+{
+  GPIO_SIM_REG_OUT,
+  GPIO_SIM_REG_OUT1,
+  GPIO_SIM_REG_OUT_W1TS,
+  GPIO_SIM_REG_OUT_W1TC,
+  GPIO_SIM_REG_OUT1_W1TS,
+  GPIO_SIM_REG_OUT1_W1TC,
+  GPIO_SIM_REG_IN,
+  GPIO_SIM_REG_IN1,
+  GPIO_SIM_REG_STATUS,
+  GPIO_SIM_REG_STATUS1,
+  GPIO_SIM_REG_STATUS_W1TC,
+  GPIO_SIM_REG_STATUS1_W1TC,
+} gpio_sim_reg_t;
+
+/**
+ * @brief Cost, in CPU cycles, of each simulated operation.
+ */
+typedef struct
+{
+  uint32_t reg_read;   /**< One GPIO register read */
+  uint32_t reg_write;  /**< One GPIO register write */
+  uint32_t api_call;   /**< Overhead of a driver call (gpio_set_level...) */
+  uint32_t config;     /**< One gpio_config call */
+  uint32_t isr_entry;  /**< Interrupt entry up to the per-pin handler */
+  uint32_t isr_vector; /**< Entry up to a gpio_isr_register() handler */
+  uint32_t timer_read; /**< One esp_timer_get_time call */
+  uint32_t cycle_read; /**< One cycle counter (CCOUNT) read */
+} gpio_sim_cost_t;
+
+/**
+ * @brief Rough ESP32 figures at 240 MHz, with the code running from IRAM.
+ */
+#define GPIO_SIM_COST_ESP32_DEFAULT                                           \
+  {                                                                           \
+    .reg_read = 4, .reg_write = 2, .api_call = 30, .config = 6000,            \
+    .isr_entry = 250, .isr_vector = 150, .timer_read = 200, .cycle_read = 1,  \
+  }
+
+/**
+ * @brief Operation counters of the simulator.
+ */
+typedef struct
+{
+  uint64_t reg_reads;  /**< Register reads, including driver level reads */
+  uint64_t reg_writes; /**< Register writes, including driver level writes */
+  uint64_t configs;    /**< gpio_config calls */
+  uint64_t isrs;       /**< Per-pin handlers run */
+} gpio_sim_stats_t;
+
+/**
+ * @brief Simulated CPU cores.
+ */
+typedef enum
+{
+  GPIO_SIM_CORE_0,
+  GPIO_SIM_CORE_1,
+  GPIO_SIM_CORE_MAX,
+} gpio_sim_core_t;
+
+/**
+ * @brief Execution contexts of the simulator: both cores plus the interrupt.
+ */
+typedef enum
+{
+  GPIO_SIM_CTX_CORE0 = GPIO_SIM_CORE_0,
+  GPIO_SIM_CTX_CORE1 = GPIO_SIM_CORE_1,
+  GPIO_SIM_CTX_ISR,
+  GPIO_SIM_CTX_MAX,
+} gpio_sim_ctx_t;
+
+/**
+ * @brief Code run by a simulated core.
+ */
+typedef void (*gpio_sim_core_fn_t)(void *arg);
+
+/**
+ * @brief Reset every pin, the ISR service, the clock and the counters.
+ *
+ * The cost model is kept.
+ */
+void gpio_sim_reset(void);
+
+/**
+ * @brief Set the cost model, NULL to go back to the all-zero model.
+ *
+ * @param cost Cost of each simulated operation.
+ */
+void gpio_sim_set_cost(const gpio_sim_cost_t *cost);
+
+/**
+ * @brief Set the simulated CPU frequency, used by the time conversions.
+ *
+ * @param mhz CPU frequency in MHz (240 by default).
+ */
+void gpio_sim_set_cpu_freq(uint32_t mhz);
+
+/**
+ * @brief Get the simulated CPU frequency, in MHz.
+ */
+uint32_t gpio_sim_get_cpu_freq(void);
+
+/**
+ * @brief Current virtual time, in CPU cycles.
+ */
+uint64_t gpio_sim_now(void);
+
+/**
+ * @brief Current virtual time, in nanoseconds.
+ */
+uint64_t gpio_sim_now_ns(void);
+
+/**
+ * @brief Read the cycle counter of the calling core, as CCOUNT would.
+ *
+ * The virtual time plus the offset of the core (gpio_sim_set_cycle_offset),
+ * truncated to 32 bits. Costs gpio_sim_cost_t::cycle_read.
+ */
+uint32_t gpio_sim_cycles(void);
+
+/**
+ * @brief Offset the cycle counter of a core from the virtual time.
+ *
+ * The cycle counters of the real cores are not synchronized: each one starts
+ * when its core does. Cleared by gpio_sim_reset().
+ *
+ * @param core Core whose counter to offset.
+ * @param offset Cycles added to the virtual time.
+ */
+void gpio_sim_set_cycle_offset(gpio_sim_core_t core, uint32_t offset);
+
+/**
+ * @brief Read the simulated esp_timer, in microseconds.
+ *
+ * Costs gpio_sim_cost_t::timer_read, half of it before the time is taken.
+ */
+int64_t gpio_sim_timer_us(void);
+
+/**
+ * @brief Advance the virtual time, e.g. to model application code.
+ *
+ * @param cycles Cycles to add to the clock.
+ */
+void gpio_sim_advance(uint64_t cycles);
+
+/**
+ * @brief Get the operation counters.
+ *
+ * @param stats Where to store the counters.
+ */
+void gpio_sim_get_stats(gpio_sim_stats_t *stats);
+
+/**
+ * @brief Drive an input pin from outside the chip.
+ *
+ * Latches the interrupt status bit and, if the pin has a matching interrupt
+ * type, its interrupt enabled and a handler registered, runs the handler
+ * (immediately, or when interrupts get unmasked).
+ *
+ * @param pin GPIO number.
+ * @param level Level applied to the pin.
+ */
+void gpio_sim_set_input(gpio_num_t pin, uint32_t level);
+
+/**
+ * @brief Level of every output pin, bit N being GPIO N.
+ */
+uint64_t gpio_sim_get_outputs(void);
+
+/**
+ * @brief Number of output transitions of a pin since the last reset.
+ *
+ * @param pin GPIO number.
+ */
+uint64_t gpio_sim_get_output_edges(gpio_num_t pin);
+
+/**
+ * @brief Run code on both simulated cores, each on its own thread.
+ *
+ * A third thread plays the interrupt context. When an interrupt is pending,
+ * the @p isr_core thread is stopped at its next simulator operation (register
+ * access, driver call, gpio_sim_advance...) unless it masked interrupts, and
+ * the handlers run on the interrupt thread, concurrently with the other core.
+ * Busy loops on a core should call gpio_sim_advance() so they can be
+ * preempted. Returns once both cores are done.
+ *
+ * @param core0 Code run on core 0, NULL to leave it idle.
+ * @param arg0 Argument of core0.
+ * @param core1 Code run on core 1, NULL to leave it idle.
+ * @param arg1 Argument of core1.
+ * @param isr_core Core preempted by the GPIO interrupt.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** if the cores are already running
+ * - **ESP_FAIL** if the threads cannot be created
+ */
+esp_err_t gpio_sim_run_cores(gpio_sim_core_fn_t core0, void *arg0,
+                             gpio_sim_core_fn_t core1, void *arg1,
+                             gpio_sim_core_t isr_core);
+
+/**
+ * @brief Run a function as if on the given core, synchronously.
+ *
+ * Stands in for esp_ipc_call_blocking(): @p fn runs on the calling thread,
+ * with gpio_sim_current_core() returning @p core.
+ *
+ * @param core Core to run on.
+ * @param fn Function to run.
+ * @param arg Argument of fn.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** if called from gpio_sim_run_cores()
+ */
+esp_err_t gpio_sim_run_on_core(gpio_sim_core_t core, gpio_sim_core_fn_t fn,
+                               void *arg);
+
+/**
+ * @brief Context of the calling thread (core 0 outside gpio_sim_run_cores).
+ */
+gpio_sim_ctx_t gpio_sim_current_ctx(void);
+
+/**
+ * @brief Core the calling thread runs on; the interrupt context runs on the
+ * ISR core given to gpio_sim_run_cores().
+ */
+gpio_sim_core_t gpio_sim_current_core(void);
+
+/**
+ * @brief Driver calls whose failure can be injected.
+ */
+typedef enum
+{
+  GPIO_SIM_FAIL_CONFIG,          /**< gpio_config */
+  GPIO_SIM_FAIL_ISR_HANDLER_ADD, /**< gpio_isr_handler_add */
+  GPIO_SIM_FAIL_MAX,
+} gpio_sim_fail_op_t;
+
+/**
+ * @brief Counters of the injected faults.
+ */
+typedef struct
+{
+  uint64_t glitches;        /**< Glitch pulses injected */
+  uint64_t storm_edges;     /**< Edges injected by interrupt storms */
+  uint64_t injected_errors; /**< Driver calls failed on purpose */
+} gpio_sim_fault_stats_t;
+
+/**
+ * @brief Force the level seen on a pin, whatever drives it.
+ *
+ * @param pin GPIO number.
+ * @param level Stuck-at level.
+ */
+void gpio_sim_fault_stuck(gpio_num_t pin, uint32_t level);
+
+/**
+ * @brief Inject a train of glitches on a pin.
+ *
+ * Each glitch inverts the level seen on the pin for @p width cycles, which
+ * raises the interrupts of both of its edges.
+ *
+ * @param pin GPIO number.
+ * @param delay Cycles from now to the first glitch.
+ * @param width Width of each glitch, in cycles.
+ * @param period Cycles between the start of two glitches (ignored if count is 1).
+ * @param count Number of glitches.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if too many faults are scheduled
+ */
+esp_err_t gpio_sim_fault_glitch(gpio_num_t pin, uint64_t delay, uint32_t width,
+                                uint32_t period, uint32_t count);
+
+/**
+ * @brief Inject an interrupt storm: a pin toggling at a given rate.
+ *
+ * @param pin GPIO number.
+ * @param rate_hz Edges per second of simulated time.
+ * @param edges Number of edges to inject.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if too many faults are scheduled
+ */
+esp_err_t gpio_sim_fault_storm(gpio_num_t pin, uint32_t rate_hz,
+                               uint32_t edges);
+
+/**
+ * @brief Make the next calls of a driver function fail.
+ *
+ * @param op Driver function to fail.
+ * @param err Error returned.
+ * @param count Number of calls to fail.
+ */
+void gpio_sim_fault_fail(gpio_sim_fail_op_t op, esp_err_t err, uint32_t count);
+
+/**
+ * @brief Remove every stuck pin, scheduled glitch, storm and failure.
+ */
+void gpio_sim_fault_clear(void);
+
+/**
+ * @brief Get the counters of the injected faults.
+ *
+ * @param stats Where to store the counters.
+ */
+void gpio_sim_fault_get_stats(gpio_sim_fault_stats_t *stats);
+
+/**
+ * @brief Number of malloc(), calloc() and realloc() calls so far.
+ *
+ * @param count Where to store the number of calls.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_SIM_COUNT_ALLOCS is disabled
+ */
+esp_err_t gpio_sim_alloc_count(uint64_t *count);
+
+/**
+ * @brief Counters of the file-backed flash partition.
+ */
+typedef struct
+{
+  uint64_t reads;             /**< esp_partition_read calls */
+  uint64_t writes;            /**< esp_partition_write calls */
+  uint64_t erases;            /**< Sectors erased */
+  uint64_t bytes_written;     /**< Bytes programmed */
+  uint64_t busy_us;           /**< Flash time, from typical NOR timings */
+  uint32_t min_sector_erases; /**< Erases of the least erased sector */
+  uint32_t max_sector_erases; /**< Erases of the most erased sector */
+} gpio_sim_flash_stats_t;
+
+/**
+ * @brief Open a file as the flash partition of the esp_partition stand-in.
+ *
+ * The partition is a data partition; an existing file keeps its contents,
+ * as flash does across a reboot, and is grown with blank (0xFF) bytes. The
+ * counters start from zero. Any previously open partition is closed.
+ *
+ * @param path Backing file.
+ * @param label Partition label, for esp_partition_find_first().
+ * @param size Partition size, a multiple of 4096 bytes.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if the image does not fit in memory
+ * - **ESP_ERR_NOT_FOUND** if the file cannot be opened
+ */
+esp_err_t gpio_sim_flash_open(const char *path, const char *label,
+                              uint32_t size);
+
+/**
+ * @brief Close the flash partition; its contents stay in the file.
+ */
+void gpio_sim_flash_close(void);
+
+/**
+ * @brief Get the counters of the flash partition.
+ *
+ * @param stats Where to store the counters.
+ */
+void gpio_sim_flash_get_stats(gpio_sim_flash_stats_t *stats);
+
+/**
+ * @brief Bus counters of an expander model.
+ */
+typedef struct
+{
+  uint32_t writes; /**< Write transactions */
+  uint32_t reads;  /**< Write-read transactions */
+  uint64_t bytes;  /**< Data bytes, register pointers included */
+  uint64_t bus_ns; /**< Bus time at 400 kHz */
+} gpio_sim_expander_stats_t;
+
+/**
+ * @brief Register model of an I2C port expander, on gpio_sim_expander_bus.
+ *
+ * Each transaction advances the virtual clock by its 400 kHz bus time. The
+ * INT line, when wired, is an open-drain output driven on a simulated input:
+ * it goes low when an input changes and is released when the port is read
+ * (the MCP23017 model assumes IOCON.MIRROR and INTCON 0, as set by
+ * gpio_expander_init()).
+ */
+typedef struct
+{
+  gpio_expander_type_t type;
+  uint8_t addr;
+  gpio_num_t int_pin;              /**< Simulated input on INT, or NC */
+  uint8_t regs[0x16];              /**< MCP23017 registers, BANK = 0 */
+  uint8_t pointer;                 /**< MCP23017 register pointer */
+  uint8_t latch;                   /**< PCF8574 output latch */
+  uint16_t ext;                    /**< Levels driven on the pins */
+  uint16_t last_pins;              /**< Pin levels at the last port read */
+  bool int_active;                 /**< INT line pulled low */
+  gpio_sim_expander_stats_t stats; /**< Bus counters */
+} gpio_sim_expander_t;
+
+/**
+ * @brief Bus transactions of the expander models; the bus context is the
+ * gpio_sim_expander_t.
+ */
+extern const gpio_expander_bus_t gpio_sim_expander_bus;
+
+/**
+ * @brief Set up an expander model in its power-on state.
+ *
+ * @param model Model to set up.
+ * @param type Chip to model.
+ * @param addr 7-bit I2C address the model answers to.
+ * @param int_pin Simulated input on its INT line, GPIO_NUM_NC if none.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_sim_expander_init(gpio_sim_expander_t *model,
+                                 gpio_expander_type_t type, uint8_t addr,
+                                 gpio_num_t int_pin);
+
+/**
+ * @brief Drive the pins of an expander from outside.
+ *
+ * Pins configured as inputs take these levels (output pins ignore them);
+ * a change of an input with its interrupt enabled pulls INT low.
+ *
+ * @param model Expander model.
+ * @param levels Levels, bit N being pin N of the chip.
+ */
+void gpio_sim_expander_set_inputs(gpio_sim_expander_t *model, uint16_t levels);
+
+/**
+ * @brief Get the levels driven by the output pins of an expander.
+ *
+ * @param model Expander model.
+ * @return Levels of the outputs, 0 for the inputs (PCF8574: the latch).
+ */
+uint16_t gpio_sim_expander_get_outputs(const gpio_sim_expander_t *model);
+
+/**
+ * @brief Most shift-register chain models attached at once.
+ */
+#define GPIO_SIM_SHIFTREG_MAX 8
+
+/**
+ * @brief Model of a 74HC595 or 74HC165 chain wired to simulated pins.
+ *
+ * A 74HC595 chain shifts its data line in on each rising clock edge and
+ * copies the shift register to its outputs on each rising latch edge. A
+ * 74HC165 chain loads its inputs while SH/LD is low, drives bit 0 of its
+ * shift register on the data line, and shifts it down on each rising clock
+ * edge while SH/LD is high.
+ */
+typedef struct
+{
+  gpio_shiftreg_type_t type;
+  gpio_num_t data;   /**< SER or QH */
+  gpio_num_t clock;  /**< SRCLK or CLK */
+  gpio_num_t latch;  /**< RCLK or SH/LD */
+  uint8_t length;    /**< Bits of the chain */
+  uint64_t shift;    /**< Shift register */
+  uint64_t outputs;  /**< 74HC595 storage register */
+  uint64_t inputs;   /**< 74HC165 parallel inputs */
+  uint32_t clocks;   /**< Rising clock edges that shifted */
+  uint32_t latches;  /**< Latches (74HC595) or loads (74HC165) */
+} gpio_sim_shiftreg_t;
+
+/**
+ * @brief Wire a shift-register chain model to simulated pins.
+ *
+ * The model starts cleared. It stays attached until
+ * gpio_sim_shiftreg_detach_all(), gpio_sim_reset() included.
+ *
+ * @param model Model, kept alive while attached.
+ * @param type Chip of the chain.
+ * @param data Pin on SER (74HC595) or QH (74HC165).
+ * @param clock Pin on the shift clock.
+ * @param latch Pin on RCLK (74HC595) or SH/LD (74HC165).
+ * @param length Bits of the chain, 1 to 64.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if GPIO_SIM_SHIFTREG_MAX models are attached
+ */
+esp_err_t gpio_sim_shiftreg_attach(gpio_sim_shiftreg_t *model,
+                                   gpio_shiftreg_type_t type, gpio_num_t data,
+                                   gpio_num_t clock, gpio_num_t latch,
+                                   uint8_t length);
+
+/**
+ * @brief Detach every shift-register chain model.
+ */
+void gpio_sim_shiftreg_detach_all(void);
+
+/**
+ * @brief Set the parallel inputs of a 74HC165 chain model.
+ *
+ * @param model Chain model.
+ * @param levels Levels, bit N being the N-th bit shifted out after a load.
+ */
+void gpio_sim_shiftreg_set_inputs(gpio_sim_shiftreg_t *model, uint64_t levels);
+
+/**
+ * @brief Get the latched outputs of a 74HC595 chain model.
+ *
+ * @param model Chain model.
+ * @return Outputs, bit N being output N from QA of the first chip.
+ */
+uint64_t gpio_sim_shiftreg_get_outputs(const gpio_sim_shiftreg_t *model);
+
+/**
+ * @brief GPS PPS receiver model, against the drifting local clock.
+ *
+ * The virtual cycles of the simulator are the local clock: its crystal is
+ * off by drift_ppb (positive: fast), and the error changes by wander_ppb
+ * each second. The model keeps true time and raises its pin at each true
+ * second, give or take the jitter.
+ */
+typedef struct
+{
+  gpio_num_t pin;     /**< PPS output */
+  double drift_ppb;   /**< Local clock rate error now */
+  double wander_ppb;  /**< Change of drift_ppb at each second */
+  uint32_t jitter_ns; /**< Peak jitter of the edges */
+  int64_t second;     /**< True second of the last boundary */
+  double boundary;    /**< Local cycle count of the last boundary */
+  uint32_t lcg;       /**< Jitter generator */
+} gpio_sim_pps_t;
+
+/**
+ * @brief Start a PPS receiver model, true second 0 being now.
+ *
+ * Drives @p pin low; the pulses are rising edges, 100 us wide.
+ *
+ * @param pps Model.
+ * @param pin PPS output.
+ * @param drift_ppb Local clock rate error, in ppb (positive: fast).
+ * @param wander_ppb Change of the rate error each second, in ppb.
+ * @param jitter_ns Peak jitter of the edges, in ns.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_sim_pps_start(gpio_sim_pps_t *pps, gpio_num_t pin,
+                             double drift_ppb, double wander_ppb,
+                             uint32_t jitter_ns);
+
+/**
+ * @brief Run the virtual clock to the next true second and pulse the pin.
+ *
+ * @param pps Model.
+ */
+void gpio_sim_pps_pulse(gpio_sim_pps_t *pps);
+
+/**
+ * @brief True time of a local time after the last boundary.
+ *
+ * @param pps Model.
+ * @param cycles Local time, in virtual cycles.
+ * @return True time, in nanoseconds since second 0.
+ */
+double gpio_sim_pps_true_ns(const gpio_sim_pps_t *pps, double cycles);
+
+/**
+ * @brief Load a waveform file to be replayed on the simulated inputs.
+ *
+ * The file holds one transition per line, `<delta_ns> <pin> <level>`, where
+ * delta_ns is the time since the previous transition (or since the load for
+ * the first one). Empty lines and lines starting with `#` are skipped. This
+ * is also the format written by gpio_sim_rec_start(), so recorded outputs can
+ * be fed back as inputs. Any previously loaded waveform is discarded.
+ *
+ * @param path Waveform file.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_FOUND** if the file cannot be opened
+ * - **ESP_ERR_INVALID_ARG** if a line is malformed
+ * - **ESP_ERR_NO_MEM** if the waveform does not fit in memory
+ */
+esp_err_t gpio_sim_wave_load(const char *path);
+
+/**
+ * @brief Replay the loaded waveform up to a virtual time.
+ *
+ * Each transition jumps the virtual clock forward to its timestamp (or is
+ * applied late, if the code under test already went past it) and drives the
+ * pin through gpio_sim_set_input(), raising its interrupts. Nothing sleeps:
+ * a waveform runs as fast as the host can simulate it.
+ *
+ * @param until Virtual time, in CPU cycles, up to which to replay.
+ * @return Number of transitions applied.
+ */
+size_t gpio_sim_wave_run_until(uint64_t until);
+
+/**
+ * @brief Replay the rest of the loaded waveform.
+ *
+ * @return Number of transitions applied.
+ */
+size_t gpio_sim_wave_run(void);
+
+/**
+ * @brief Check whether every transition of the waveform has been applied.
+ */
+bool gpio_sim_wave_done(void);
+
+/**
+ * @brief Discard the loaded waveform.
+ */
+void gpio_sim_wave_unload(void);
+
+/**
+ * @brief Start recording the output transitions of some pins to a file.
+ *
+ * The file uses the waveform format of gpio_sim_wave_load(). A recording
+ * already in progress is stopped first.
+ *
+ * @param path File to write.
+ * @param pin_mask Pins to record, bit N being GPIO N.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_FOUND** if the file cannot be created
+ */
+esp_err_t gpio_sim_rec_start(const char *path, uint64_t pin_mask);
+
+/**
+ * @brief Stop recording and close the file.
+ *
+ * @return Number of transitions recorded.
+ */
+size_t gpio_sim_rec_stop(void);
+
+/**
+ * @brief Register read, as issued by the driver low-level layer.
+ */
+uint32_t gpio_sim_reg_read(gpio_sim_reg_t reg);
+
+/**
+ * @brief Register write, as issued by the driver low-level layer.
+ */
+void gpio_sim_reg_write(gpio_sim_reg_t reg, uint32_t value);
+
+/**
+ * @brief Mask the simulated interrupts, returning the previous state.
+ */
+uint32_t gpio_sim_irq_mask(void);
+
+/**
+ * @brief Restore the interrupt state, delivering any pending interrupt.
+ */
+void gpio_sim_irq_restore(uint32_t state);
+
+/**
+ * @brief Enter a driver critical section (the spinlock of the real chip).
+ *
+ * Masks interrupts of the calling context and excludes the other contexts.
+ * Critical sections nest.
+ */
+void gpio_sim_critical_enter(void);
+
+/**
+ * @brief Leave a driver critical section.
+ */
+void gpio_sim_critical_exit(void);
+
+#endif  // GPIO_SIM_H
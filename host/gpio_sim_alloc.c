@@ -0,0 +1,65 @@
+/**
+ * @file gpio_sim_alloc.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Heap allocation counter of the host simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stddef.h>
+
+#include "gpio_sim.h"
+#include "sdkconfig.h"
+
+#if CONFIG_GPIO_DRIVERS_SIM_COUNT_ALLOCS
+
+#ifndef __GLIBC__
+#error "CONFIG_GPIO_DRIVERS_SIM_COUNT_ALLOCS needs a glibc host"
+#endif
+
+// The glibc allocator, under the names it keeps when malloc is replaced
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static uint64_t s_allocs = 0;
+
+void *malloc(size_t size)
+{
+  __atomic_fetch_add(&s_allocs, 1, __ATOMIC_RELAXED);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+  __atomic_fetch_add(&s_allocs, 1, __ATOMIC_RELAXED);
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  __atomic_fetch_add(&s_allocs, 1, __ATOMIC_RELAXED);
+  return __libc_realloc(ptr, size);
+}
+
+esp_err_t gpio_sim_alloc_count(uint64_t *count)
+{
+  if (count == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  *count = __atomic_load_n(&s_allocs, __ATOMIC_RELAXED);
+  return ESP_OK;
+}
+
+#else
+
+esp_err_t gpio_sim_alloc_count(uint64_t *count)
+{
+  (void)count;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
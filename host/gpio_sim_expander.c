@@ -0,0 +1,235 @@
+/**
+ * @file gpio_sim_expander.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief I2C port expander models of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+// 400 kHz I2C: 9 clocks per byte (8 data + ACK), start and stop about one
+// more byte
+#define GPIO_SIM_I2C_NS_PER_BYTE 22500
+
+#define MCP23017_IODIR 0x00
+#define MCP23017_IPOL 0x02
+#define MCP23017_GPINTEN 0x04
+#define MCP23017_IOCON 0x0A
+#define MCP23017_IOCON_ALT 0x0B
+#define MCP23017_GPIO 0x12
+#define MCP23017_OLAT 0x14
+
+static uint16_t gpio_sim_mcp_reg16(const gpio_sim_expander_t *model,
+                                   uint8_t reg)
+{
+  return model->regs[reg] | (uint16_t)(model->regs[reg + 1] << 8);
+}
+
+// Levels seen on the pins of the chip
+static uint16_t gpio_sim_expander_pins(const gpio_sim_expander_t *model)
+{
+  if (model->type == GPIO_EXPANDER_PCF8574)
+  {
+    // Quasi-bidirectional: a latch written low pulls the pin down
+    return model->latch & model->ext;
+  }
+
+  uint16_t inputs = gpio_sim_mcp_reg16(model, MCP23017_IODIR);
+  return (model->ext & inputs) |
+         (gpio_sim_mcp_reg16(model, MCP23017_OLAT) & ~inputs);
+}
+
+static void gpio_sim_expander_set_int(gpio_sim_expander_t *model,
+                                      bool active)
+{
+  model->int_active = active;
+  if (model->int_pin != GPIO_NUM_NC)
+    gpio_sim_set_input(model->int_pin, active ? 0 : 1);
+}
+
+static void gpio_sim_expander_bus_time(gpio_sim_expander_t *model,
+                                       size_t bytes)
+{
+  // Address byte plus start/stop
+  uint64_t ns = (uint64_t)(bytes + 2) * GPIO_SIM_I2C_NS_PER_BYTE;
+  model->stats.bytes += bytes;
+  model->stats.bus_ns += ns;
+  gpio_sim_advance(gpio_sim_ns_to_cycles(ns));
+}
+
+static void gpio_sim_mcp_write_reg(gpio_sim_expander_t *model, uint8_t reg,
+                                   uint8_t value)
+{
+  switch (reg)
+  {
+    case MCP23017_IOCON:
+    case MCP23017_IOCON_ALT:
+    {
+      // One register at two addresses
+      model->regs[MCP23017_IOCON] = value;
+      model->regs[MCP23017_IOCON_ALT] = value;
+      break;
+    }
+    case MCP23017_GPIO:
+    case MCP23017_GPIO + 1:
+    {
+      // Writing the port writes the latch
+      model->regs[reg + 2] = value;
+      break;
+    }
+    case 0x0E: // INTF, INTCAP: read only
+    case 0x0F:
+    case 0x10:
+    case 0x11:
+    {
+      break;
+    }
+    default:
+    {
+      model->regs[reg] = value;
+      break;
+    }
+  }
+}
+
+static esp_err_t gpio_sim_expander_write(void *ctx, uint8_t addr,
+                                         const uint8_t *data, size_t len)
+{
+  gpio_sim_expander_t *model = ctx;
+  if (model == NULL || addr != model->addr || (len && data == NULL))
+    return ESP_FAIL;
+
+  gpio_sim_expander_bus_time(model, len);
+  model->stats.writes++;
+
+  if (model->type == GPIO_EXPANDER_PCF8574)
+  {
+    if (len)
+      model->latch = data[len - 1];
+    return ESP_OK;
+  }
+
+  // Register pointer, then sequential writes
+  if (len == 0)
+    return ESP_OK;
+  model->pointer = data[0];
+  for (size_t i = 1; i < len; i++)
+  {
+    if (model->pointer < sizeof(model->regs))
+      gpio_sim_mcp_write_reg(model, model->pointer, data[i]);
+    model->pointer++;
+  }
+
+  return ESP_OK;
+}
+
+static esp_err_t gpio_sim_expander_write_read(void *ctx, uint8_t addr,
+                                              const uint8_t *out,
+                                              size_t out_len, uint8_t *in,
+                                              size_t in_len)
+{
+  gpio_sim_expander_t *model = ctx;
+  if (model == NULL || addr != model->addr || in == NULL ||
+      (out_len && out == NULL))
+    return ESP_FAIL;
+
+  // The repeated start sends the address again
+  gpio_sim_expander_bus_time(model, out_len + 1 + in_len);
+  model->stats.reads++;
+
+  uint16_t pins = gpio_sim_expander_pins(model);
+
+  if (model->type == GPIO_EXPANDER_PCF8574)
+  {
+    for (size_t i = 0; i < in_len; i++)
+      in[i] = (uint8_t)pins;
+  }
+  else
+  {
+    if (out_len)
+      model->pointer = out[0];
+
+    uint16_t ipol = gpio_sim_mcp_reg16(model, MCP23017_IPOL);
+    for (size_t i = 0; i < in_len; i++, model->pointer++)
+    {
+      uint8_t reg = model->pointer;
+      if (reg == MCP23017_GPIO || reg == MCP23017_GPIO + 1)
+        in[i] = (uint8_t)((pins ^ ipol) >> (8 * (reg - MCP23017_GPIO)));
+      else
+        in[i] = reg < sizeof(model->regs) ? model->regs[reg] : 0;
+    }
+  }
+
+  // Reading the port clears the interrupt
+  model->last_pins = pins;
+  if (model->int_active)
+    gpio_sim_expander_set_int(model, false);
+
+  return ESP_OK;
+}
+
+const gpio_expander_bus_t gpio_sim_expander_bus = {
+    .write = gpio_sim_expander_write,
+    .write_read = gpio_sim_expander_write_read,
+};
+
+esp_err_t gpio_sim_expander_init(gpio_sim_expander_t *model,
+                                 gpio_expander_type_t type, uint8_t addr,
+                                 gpio_num_t int_pin)
+{
+  if (model == NULL || addr > 0x7F ||
+      (type != GPIO_EXPANDER_PCF8574 && type != GPIO_EXPANDER_MCP23017))
+    return ESP_ERR_INVALID_ARG;
+
+  // Power-on state: PCF8574 latches high, MCP23017 pins inputs
+  *model = (gpio_sim_expander_t){
+      .type = type,
+      .addr = addr,
+      .int_pin = int_pin,
+      .latch = 0xFF,
+      .ext = 0xFFFF,
+  };
+  model->regs[MCP23017_IODIR] = 0xFF;
+  model->regs[MCP23017_IODIR + 1] = 0xFF;
+  model->last_pins = gpio_sim_expander_pins(model);
+
+  gpio_sim_expander_set_int(model, false);
+
+  return ESP_OK;
+}
+
+void gpio_sim_expander_set_inputs(gpio_sim_expander_t *model, uint16_t levels)
+{
+  model->ext = levels;
+
+  uint16_t changed = gpio_sim_expander_pins(model) ^ model->last_pins;
+  if (model->type == GPIO_EXPANDER_MCP23017)
+  {
+    // INTCON 0: compare with the previous value; MIRROR assumed
+    changed &= gpio_sim_mcp_reg16(model, MCP23017_GPINTEN) &
+               gpio_sim_mcp_reg16(model, MCP23017_IODIR);
+  }
+  else
+  {
+    changed &= model->latch;
+  }
+
+  if (changed && !model->int_active)
+    gpio_sim_expander_set_int(model, true);
+}
+
+uint16_t gpio_sim_expander_get_outputs(const gpio_sim_expander_t *model)
+{
+  if (model->type == GPIO_EXPANDER_PCF8574)
+    return model->latch;
+
+  return gpio_sim_mcp_reg16(model, MCP23017_OLAT) &
+         ~gpio_sim_mcp_reg16(model, MCP23017_IODIR);
+}
@@ -0,0 +1,218 @@
+/**
+ * @file gpio_sim_fault.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Fault injection of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+#define GPIO_SIM_FAULT_EVENTS_MAX 32
+
+typedef enum
+{
+  GPIO_SIM_FAULT_GLITCH,
+  GPIO_SIM_FAULT_STORM,
+} gpio_sim_fault_kind_t;
+
+typedef struct
+{
+  gpio_sim_fault_kind_t kind;
+  uint8_t pin;
+  bool active;        /**< Slot in use */
+  bool inverted;      /**< A glitch is in progress */
+  uint64_t at;        /**< Time of the next flip */
+  uint32_t width;     /**< Glitch width, in cycles */
+  uint32_t period;    /**< Cycles between two glitches or storm edges */
+  uint32_t remaining; /**< Glitches or edges left */
+} gpio_sim_fault_event_t;
+
+typedef struct
+{
+  uint64_t stuck_mask;  /**< Pins stuck at a level */
+  uint64_t stuck_level; /**< Level of the stuck pins */
+  uint64_t flip_mask;   /**< Pins currently inverted by a glitch or storm */
+  gpio_sim_fault_event_t events[GPIO_SIM_FAULT_EVENTS_MAX];
+  esp_err_t fail_err[GPIO_SIM_FAIL_MAX];
+  uint32_t fail_count[GPIO_SIM_FAIL_MAX];
+  gpio_sim_fault_stats_t stats;
+} gpio_sim_fault_t;
+
+static gpio_sim_fault_t s_fault = {0};
+
+static esp_err_t gpio_sim_fault_schedule(const gpio_sim_fault_event_t *event)
+{
+  for (int i = 0; i < GPIO_SIM_FAULT_EVENTS_MAX; i++)
+  {
+    if (!s_fault.events[i].active)
+    {
+      s_fault.events[i] = *event;
+      s_fault.events[i].active = true;
+      return ESP_OK;
+    }
+  }
+
+  return ESP_ERR_NO_MEM;
+}
+
+void gpio_sim_fault_stuck(gpio_num_t pin, uint32_t level)
+{
+  if (!GPIO_IS_VALID_GPIO(pin))
+    return;
+
+  gpio_sim_lock();
+  s_fault.stuck_mask |= 1ULL << pin;
+  if (level)
+    s_fault.stuck_level |= 1ULL << pin;
+  else
+    s_fault.stuck_level &= ~(1ULL << pin);
+  gpio_sim_sense_locked();
+  gpio_sim_unlock();
+}
+
+esp_err_t gpio_sim_fault_glitch(gpio_num_t pin, uint64_t delay, uint32_t width,
+                                uint32_t period, uint32_t count)
+{
+  if (!GPIO_IS_VALID_GPIO(pin) || width == 0 || count == 0 ||
+      (count > 1 && period <= width))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_lock();
+  gpio_sim_fault_event_t event = {
+      .kind = GPIO_SIM_FAULT_GLITCH,
+      .pin = (uint8_t)pin,
+      .at = gpio_sim_now_locked() + delay,
+      .width = width,
+      .period = period,
+      .remaining = count,
+  };
+  esp_err_t err = gpio_sim_fault_schedule(&event);
+  gpio_sim_unlock();
+
+  return err;
+}
+
+esp_err_t gpio_sim_fault_storm(gpio_num_t pin, uint32_t rate_hz,
+                               uint32_t edges)
+{
+  if (!GPIO_IS_VALID_GPIO(pin) || rate_hz == 0 || edges == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t period = gpio_sim_ns_to_cycles(1000000000ULL / rate_hz);
+  if (period == 0)
+    period = 1;
+
+  gpio_sim_lock();
+  gpio_sim_fault_event_t event = {
+      .kind = GPIO_SIM_FAULT_STORM,
+      .pin = (uint8_t)pin,
+      .at = gpio_sim_now_locked() + period,
+      .period = (uint32_t)period,
+      .remaining = edges,
+  };
+  esp_err_t err = gpio_sim_fault_schedule(&event);
+  gpio_sim_unlock();
+
+  return err;
+}
+
+void gpio_sim_fault_fail(gpio_sim_fail_op_t op, esp_err_t err, uint32_t count)
+{
+  if (op >= GPIO_SIM_FAIL_MAX)
+    return;
+
+  gpio_sim_lock();
+  s_fault.fail_err[op] = err;
+  s_fault.fail_count[op] = err == ESP_OK ? 0 : count;
+  gpio_sim_unlock();
+}
+
+void gpio_sim_fault_clear(void)
+{
+  gpio_sim_lock();
+  memset(&s_fault, 0, sizeof(s_fault));
+  gpio_sim_sense_locked();
+  gpio_sim_unlock();
+}
+
+void gpio_sim_fault_get_stats(gpio_sim_fault_stats_t *stats)
+{
+  gpio_sim_lock();
+  *stats = s_fault.stats;
+  gpio_sim_unlock();
+}
+
+uint64_t gpio_sim_fault_levels(uint64_t levels)
+{
+  levels ^= s_fault.flip_mask;
+  return (levels & ~s_fault.stuck_mask) |
+         (s_fault.stuck_level & s_fault.stuck_mask);
+}
+
+bool gpio_sim_fault_next(uint64_t *at)
+{
+  bool found = false;
+
+  for (int i = 0; i < GPIO_SIM_FAULT_EVENTS_MAX; i++)
+  {
+    const gpio_sim_fault_event_t *event = &s_fault.events[i];
+    if (event->active && (!found || event->at < *at))
+    {
+      *at = event->at;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void gpio_sim_fault_fire(uint64_t now)
+{
+  for (int i = 0; i < GPIO_SIM_FAULT_EVENTS_MAX; i++)
+  {
+    gpio_sim_fault_event_t *event = &s_fault.events[i];
+    if (!event->active || event->at > now)
+      continue;
+
+    s_fault.flip_mask ^= 1ULL << event->pin;
+
+    if (event->kind == GPIO_SIM_FAULT_STORM)
+    {
+      s_fault.stats.storm_edges++;
+      event->at += event->period;
+      event->remaining--;
+    }
+    else if (!event->inverted)
+    {
+      s_fault.stats.glitches++;
+      event->inverted = true;
+      event->at += event->width;
+    }
+    else
+    {
+      event->inverted = false;
+      event->at += event->period - event->width;
+      event->remaining--;
+    }
+
+    if (event->remaining == 0)
+      event->active = false;
+  }
+}
+
+esp_err_t gpio_sim_fault_take_error(gpio_sim_fail_op_t op)
+{
+  if (s_fault.fail_count[op] == 0)
+    return ESP_OK;
+
+  s_fault.fail_count[op]--;
+  s_fault.stats.injected_errors++;
+  return s_fault.fail_err[op];
+}
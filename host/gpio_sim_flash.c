@@ -0,0 +1,188 @@
+/**
+ * @file gpio_sim_flash.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief File-backed flash partition of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <esp_partition.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gpio_sim.h"
+
+// Typical SPI NOR timings of the ESP32 modules, for the busy time estimate
+#define GPIO_SIM_FLASH_ERASE_US 45000
+#define GPIO_SIM_FLASH_PROGRAM_US 700
+#define GPIO_SIM_FLASH_PROGRAM_PAGE 256
+
+typedef struct
+{
+  FILE *file;
+  uint8_t *image;          /**< Partition contents, written through to file */
+  uint32_t *sector_erases; /**< Erases of each sector since the open */
+  esp_partition_t partition;
+  gpio_sim_flash_stats_t stats;
+} gpio_sim_flash_t;
+
+static gpio_sim_flash_t s_flash = {0};
+
+esp_err_t gpio_sim_flash_open(const char *path, const char *label,
+                              uint32_t size)
+{
+  if (path == NULL || label == NULL || size == 0 ||
+      size % SPI_FLASH_SEC_SIZE != 0 ||
+      strlen(label) >= sizeof(s_flash.partition.label))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_flash_close();
+
+  s_flash.image = malloc(size);
+  s_flash.sector_erases = calloc(size / SPI_FLASH_SEC_SIZE, sizeof(uint32_t));
+  if (s_flash.image == NULL || s_flash.sector_erases == NULL)
+  {
+    gpio_sim_flash_close();
+    return ESP_ERR_NO_MEM;
+  }
+
+  // Keep the contents of an existing file, as a reboot would; blank flash
+  // reads as 0xFF
+  memset(s_flash.image, 0xFF, size);
+  s_flash.file = fopen(path, "r+b");
+  if (s_flash.file != NULL)
+    (void)fread(s_flash.image, 1, size, s_flash.file);
+  else
+    s_flash.file = fopen(path, "w+b");
+
+  if (s_flash.file == NULL || fseek(s_flash.file, 0, SEEK_SET) != 0 ||
+      fwrite(s_flash.image, 1, size, s_flash.file) != size ||
+      fflush(s_flash.file) != 0)
+  {
+    gpio_sim_flash_close();
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  s_flash.partition = (esp_partition_t){
+      .type = ESP_PARTITION_TYPE_DATA,
+      .subtype = ESP_PARTITION_SUBTYPE_DATA_UNDEFINED,
+      .size = size,
+      .erase_size = SPI_FLASH_SEC_SIZE,
+  };
+  strcpy(s_flash.partition.label, label);
+
+  return ESP_OK;
+}
+
+void gpio_sim_flash_close(void)
+{
+  if (s_flash.file != NULL)
+    fclose(s_flash.file);
+  free(s_flash.image);
+  free(s_flash.sector_erases);
+  s_flash = (gpio_sim_flash_t){0};
+}
+
+void gpio_sim_flash_get_stats(gpio_sim_flash_stats_t *stats)
+{
+  *stats = s_flash.stats;
+  if (s_flash.image == NULL)
+    return;
+
+  uint32_t sectors = s_flash.partition.size / SPI_FLASH_SEC_SIZE;
+  stats->min_sector_erases = UINT32_MAX;
+  stats->max_sector_erases = 0;
+  for (uint32_t i = 0; i < sectors; i++)
+  {
+    if (s_flash.sector_erases[i] < stats->min_sector_erases)
+      stats->min_sector_erases = s_flash.sector_erases[i];
+    if (s_flash.sector_erases[i] > stats->max_sector_erases)
+      stats->max_sector_erases = s_flash.sector_erases[i];
+  }
+}
+
+static bool gpio_sim_flash_in_range(const esp_partition_t *partition,
+                                    size_t offset, size_t size)
+{
+  return partition == &s_flash.partition && s_flash.image != NULL &&
+         offset <= partition->size && size <= partition->size - offset;
+}
+
+static esp_err_t gpio_sim_flash_sync(size_t offset, size_t size)
+{
+  if (fseek(s_flash.file, (long)offset, SEEK_SET) != 0 ||
+      fwrite(s_flash.image + offset, 1, size, s_flash.file) != size ||
+      fflush(s_flash.file) != 0)
+    return ESP_FAIL;
+
+  return ESP_OK;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type,
+                                                esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+  if (s_flash.image == NULL ||
+      (type != ESP_PARTITION_TYPE_ANY && type != s_flash.partition.type) ||
+      (subtype != ESP_PARTITION_SUBTYPE_ANY &&
+       subtype != s_flash.partition.subtype) ||
+      (label != NULL && strcmp(label, s_flash.partition.label) != 0))
+    return NULL;
+
+  return &s_flash.partition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition,
+                             size_t src_offset, void *dst, size_t size)
+{
+  if (dst == NULL || !gpio_sim_flash_in_range(partition, src_offset, size))
+    return ESP_ERR_INVALID_ARG;
+
+  memcpy(dst, s_flash.image + src_offset, size);
+  s_flash.stats.reads++;
+
+  return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition,
+                              size_t dst_offset, const void *src, size_t size)
+{
+  if (src == NULL || !gpio_sim_flash_in_range(partition, dst_offset, size))
+    return ESP_ERR_INVALID_ARG;
+
+  // Programming only clears bits: writing over data without an erase ANDs it
+  const uint8_t *bytes = src;
+  for (size_t i = 0; i < size; i++)
+    s_flash.image[dst_offset + i] &= bytes[i];
+
+  s_flash.stats.writes++;
+  s_flash.stats.bytes_written += size;
+  s_flash.stats.busy_us +=
+      (uint64_t)GPIO_SIM_FLASH_PROGRAM_US *
+      ((size + GPIO_SIM_FLASH_PROGRAM_PAGE - 1) / GPIO_SIM_FLASH_PROGRAM_PAGE);
+
+  return gpio_sim_flash_sync(dst_offset, size);
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition,
+                                    size_t offset, size_t size)
+{
+  if (!gpio_sim_flash_in_range(partition, offset, size) ||
+      offset % SPI_FLASH_SEC_SIZE != 0 || size % SPI_FLASH_SEC_SIZE != 0)
+    return ESP_ERR_INVALID_ARG;
+
+  memset(s_flash.image + offset, 0xFF, size);
+  for (size_t sector = offset / SPI_FLASH_SEC_SIZE;
+       sector < (offset + size) / SPI_FLASH_SEC_SIZE; sector++)
+  {
+    s_flash.sector_erases[sector]++;
+    s_flash.stats.erases++;
+    s_flash.stats.busy_us += GPIO_SIM_FLASH_ERASE_US;
+  }
+
+  return gpio_sim_flash_sync(offset, size);
+}
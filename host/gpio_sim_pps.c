@@ -0,0 +1,71 @@
+/**
+ * @file gpio_sim_pps.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief PPS receiver model of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+#define GPIO_SIM_PPS_WIDTH_NS 100000
+
+// Local cycles in one true second at the current rate error
+static double gpio_sim_pps_cycles_per_s(const gpio_sim_pps_t *pps)
+{
+  return gpio_sim_get_cpu_freq() * 1e6 * (1.0 + pps->drift_ppb * 1e-9);
+}
+
+esp_err_t gpio_sim_pps_start(gpio_sim_pps_t *pps, gpio_num_t pin,
+                             double drift_ppb, double wander_ppb,
+                             uint32_t jitter_ns)
+{
+  if (pps == NULL || !GPIO_IS_VALID_GPIO(pin))
+    return ESP_ERR_INVALID_ARG;
+
+  *pps = (gpio_sim_pps_t){
+      .pin = pin,
+      .drift_ppb = drift_ppb,
+      .wander_ppb = wander_ppb,
+      .jitter_ns = jitter_ns,
+      .boundary = (double)gpio_sim_now(),
+      .lcg = 1,
+  };
+  gpio_sim_set_input(pin, 0);
+
+  return ESP_OK;
+}
+
+void gpio_sim_pps_pulse(gpio_sim_pps_t *pps)
+{
+  pps->boundary += gpio_sim_pps_cycles_per_s(pps);
+  pps->second++;
+  pps->drift_ppb += pps->wander_ppb;
+
+  double jitter = 0;
+  if (pps->jitter_ns)
+  {
+    pps->lcg = pps->lcg * 1664525 + 1013904223;
+    jitter = ((double)(pps->lcg >> 8) / (1 << 24) * 2 - 1) * pps->jitter_ns;
+  }
+
+  uint64_t at =
+      (uint64_t)(pps->boundary + jitter * gpio_sim_get_cpu_freq() / 1000);
+  uint64_t now = gpio_sim_now();
+  if (at > now)
+    gpio_sim_advance(at - now);
+
+  gpio_sim_set_input(pps->pin, 1);
+  gpio_sim_advance(gpio_sim_ns_to_cycles(GPIO_SIM_PPS_WIDTH_NS));
+  gpio_sim_set_input(pps->pin, 0);
+}
+
+double gpio_sim_pps_true_ns(const gpio_sim_pps_t *pps, double cycles)
+{
+  return (double)pps->second * 1e9 +
+         (cycles - pps->boundary) * 1e9 / gpio_sim_pps_cycles_per_s(pps);
+}
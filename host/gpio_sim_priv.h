@@ -0,0 +1,117 @@
+/**
+ * @file gpio_sim_priv.h
+ * @brief Internal hooks shared between the host simulator modules.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_PRIV_H
+#define GPIO_SIM_PRIV_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_sim.h"
+
+/**
+ * @brief Convert nanoseconds to cycles of the simulated CPU.
+ */
+uint64_t gpio_sim_ns_to_cycles(uint64_t ns);
+
+/**
+ * @brief Convert cycles of the simulated CPU to nanoseconds.
+ */
+uint64_t gpio_sim_cycles_to_ns(uint64_t cycles);
+
+/**
+ * @brief Take the lock serializing every access to the simulator state.
+ */
+void gpio_sim_lock(void);
+
+/**
+ * @brief Release the simulator state lock.
+ */
+void gpio_sim_unlock(void);
+
+/**
+ * @brief Current virtual time. Called with the simulator lock held.
+ */
+uint64_t gpio_sim_now_locked(void);
+
+/**
+ * @brief Re-evaluate the pin levels after an external change, latching and
+ * dispatching the resulting interrupts. Called with the simulator lock held.
+ */
+void gpio_sim_sense_locked(void);
+
+/**
+ * @brief Check whether a light-sleep wake-up pin is at its level.
+ *
+ * Called with the simulator lock held.
+ */
+bool gpio_sim_wakeup_locked(void);
+
+/**
+ * @brief Apply the next transition of the loaded waveform, at its time.
+ *
+ * @return false if every transition has been applied.
+ */
+bool gpio_sim_wave_step(void);
+
+/**
+ * @brief Notify the recorder that the output levels changed.
+ *
+ * Called with the simulator lock held.
+ */
+void gpio_sim_rec_outputs(uint64_t now_ns, uint64_t before, uint64_t after);
+
+/**
+ * @brief Clock the shift-register models on the output level changes.
+ *
+ * Called with the simulator lock held.
+ */
+void gpio_sim_shiftreg_outputs(uint64_t before, uint64_t after);
+
+/**
+ * @brief Apply the data lines driven by the shift-register models to the
+ * pin levels.
+ *
+ * Called with the simulator lock held.
+ */
+uint64_t gpio_sim_shiftreg_levels(uint64_t levels);
+
+/**
+ * @brief Apply the stuck-at and glitch faults to the pin levels.
+ *
+ * Called with the simulator lock held.
+ */
+uint64_t gpio_sim_fault_levels(uint64_t levels);
+
+/**
+ * @brief Get the time of the next scheduled fault event.
+ *
+ * Called with the simulator lock held.
+ *
+ * @return true if an event is scheduled.
+ */
+bool gpio_sim_fault_next(uint64_t *at);
+
+/**
+ * @brief Apply the fault events scheduled up to a time.
+ *
+ * Called with the simulator lock held.
+ */
+void gpio_sim_fault_fire(uint64_t now);
+
+/**
+ * @brief Consume one injected failure of a driver call.
+ *
+ * Called with the simulator lock held.
+ *
+ * @return Error to return, ESP_OK if none is injected.
+ */
+esp_err_t gpio_sim_fault_take_error(gpio_sim_fail_op_t op);
+
+#endif  // GPIO_SIM_PRIV_H
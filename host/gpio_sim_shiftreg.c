@@ -0,0 +1,145 @@
+/**
+ * @file gpio_sim_shiftreg.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Shift-register chain models of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+static gpio_sim_shiftreg_t *s_chains[GPIO_SIM_SHIFTREG_MAX] = {NULL};
+
+static uint64_t gpio_sim_shiftreg_mask(const gpio_sim_shiftreg_t *model)
+{
+  return model->length == 64 ? ~0ULL : (1ULL << model->length) - 1;
+}
+
+esp_err_t gpio_sim_shiftreg_attach(gpio_sim_shiftreg_t *model,
+                                   gpio_shiftreg_type_t type, gpio_num_t data,
+                                   gpio_num_t clock, gpio_num_t latch,
+                                   uint8_t length)
+{
+  if (model == NULL || length == 0 || length > 64 ||
+      (type != GPIO_SHIFTREG_74HC595 && type != GPIO_SHIFTREG_74HC165) ||
+      !GPIO_IS_VALID_GPIO(data) || !GPIO_IS_VALID_GPIO(clock) ||
+      !GPIO_IS_VALID_GPIO(latch))
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_lock();
+  esp_err_t err = ESP_ERR_NO_MEM;
+  for (int i = 0; i < GPIO_SIM_SHIFTREG_MAX; i++)
+  {
+    if (s_chains[i] == NULL)
+    {
+      *model = (gpio_sim_shiftreg_t){
+          .type = type,
+          .data = data,
+          .clock = clock,
+          .latch = latch,
+          .length = length,
+      };
+      s_chains[i] = model;
+      err = ESP_OK;
+      break;
+    }
+  }
+  if (err == ESP_OK)
+    gpio_sim_sense_locked();
+  gpio_sim_unlock();
+
+  return err;
+}
+
+void gpio_sim_shiftreg_detach_all(void)
+{
+  gpio_sim_lock();
+  for (int i = 0; i < GPIO_SIM_SHIFTREG_MAX; i++)
+    s_chains[i] = NULL;
+  gpio_sim_unlock();
+}
+
+void gpio_sim_shiftreg_set_inputs(gpio_sim_shiftreg_t *model, uint64_t levels)
+{
+  gpio_sim_lock();
+  model->inputs = levels & gpio_sim_shiftreg_mask(model);
+  gpio_sim_sense_locked();
+  gpio_sim_unlock();
+}
+
+uint64_t gpio_sim_shiftreg_get_outputs(const gpio_sim_shiftreg_t *model)
+{
+  gpio_sim_lock();
+  uint64_t outputs = model->outputs;
+  gpio_sim_unlock();
+  return outputs;
+}
+
+void gpio_sim_shiftreg_outputs(uint64_t before, uint64_t after)
+{
+  for (int i = 0; i < GPIO_SIM_SHIFTREG_MAX; i++)
+  {
+    gpio_sim_shiftreg_t *model = s_chains[i];
+    if (model == NULL)
+      continue;
+
+    uint64_t clock = 1ULL << model->clock;
+    uint64_t latch = 1ULL << model->latch;
+    bool clock_rise = (after & clock) && !(before & clock);
+    bool latch_rise = (after & latch) && !(before & latch);
+    uint64_t mask = gpio_sim_shiftreg_mask(model);
+
+    if (model->type == GPIO_SHIFTREG_74HC595)
+    {
+      // The first bit shifted in ends at the far end of the chain
+      if (clock_rise)
+      {
+        model->shift = ((model->shift << 1) | ((after >> model->data) & 1)) &
+                       mask;
+        model->clocks++;
+      }
+      if (latch_rise)
+      {
+        model->outputs = model->shift;
+        model->latches++;
+      }
+    }
+    else
+    {
+      // SH/LD low loads the inputs; high, each clock shifts toward QH with
+      // zeros coming in
+      if (!(after & latch))
+      {
+        model->shift = model->inputs;
+        if (!(before & latch))
+          continue;
+        model->latches++;
+      }
+      else if (clock_rise)
+      {
+        model->shift >>= 1;
+        model->clocks++;
+      }
+    }
+  }
+}
+
+uint64_t gpio_sim_shiftreg_levels(uint64_t levels)
+{
+  for (int i = 0; i < GPIO_SIM_SHIFTREG_MAX; i++)
+  {
+    const gpio_sim_shiftreg_t *model = s_chains[i];
+    if (model == NULL || model->type != GPIO_SHIFTREG_74HC165)
+      continue;
+
+    // QH drives the data line
+    uint64_t bit = 1ULL << model->data;
+    levels = (model->shift & 1) ? levels | bit : levels & ~bit;
+  }
+
+  return levels;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file gpio_sim_sleep.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Light-sleep model of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <esp_sleep.h>
+#include <stdbool.h>
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+static bool s_gpio_wakeup = false;
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void)
+{
+  s_gpio_wakeup = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source)
+{
+  if (source != ESP_SLEEP_WAKEUP_GPIO && source != ESP_SLEEP_WAKEUP_ALL)
+    return ESP_ERR_INVALID_STATE;
+
+  s_gpio_wakeup = false;
+  return ESP_OK;
+}
+
+// The CPU is stopped: no interrupt is taken until it wakes
+esp_err_t esp_light_sleep_start(void)
+{
+  if (!s_gpio_wakeup)
+    return ESP_ERR_INVALID_STATE;
+
+  uint32_t irq = gpio_sim_irq_mask();
+  esp_err_t err = ESP_OK;
+
+  while (true)
+  {
+    gpio_sim_lock();
+    bool woken = gpio_sim_wakeup_locked();
+    gpio_sim_unlock();
+
+    if (woken)
+      break;
+    if (!gpio_sim_wave_step())
+    {
+      err = ESP_ERR_INVALID_STATE;
+      break;
+    }
+  }
+
+  gpio_sim_irq_restore(irq);
+
+  return err;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file gpio_sim_wave.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Waveform player and output recorder of the host GPIO simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gpio_sim.h"
+#include "gpio_sim_priv.h"
+
+#define GPIO_SIM_WAVE_LINE_MAX 128
+#define GPIO_SIM_WAVE_INITIAL_CAPACITY 256
+
+typedef struct
+{
+  uint64_t at;   /**< Virtual time of the transition, in cycles */
+  uint8_t pin;   /**< GPIO number */
+  uint8_t level; /**< Level applied to the pin */
+} gpio_sim_transition_t;
+
+typedef struct
+{
+  gpio_sim_transition_t *transitions;
+  size_t count;
+  size_t next;
+} gpio_sim_wave_t;
+
+typedef struct
+{
+  FILE *file;
+  uint64_t pin_mask;
+  uint64_t last_ns;
+  size_t count;
+} gpio_sim_rec_t;
+
+static gpio_sim_wave_t s_wave = {0};
+static gpio_sim_rec_t s_rec = {0};
+
+esp_err_t gpio_sim_wave_load(const char *path)
+{
+  gpio_sim_wave_unload();
+
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+    return ESP_ERR_NOT_FOUND;
+
+  esp_err_t err = ESP_OK;
+  size_t capacity = 0;
+  uint64_t at_ns = 0;
+  uint64_t start = gpio_sim_now();
+  char line[GPIO_SIM_WAVE_LINE_MAX];
+
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    uint64_t delta_ns = 0;
+    unsigned int pin = 0;
+    unsigned int level = 0;
+    char first = 0;
+
+    if (sscanf(line, " %c", &first) != 1 || first == '#')
+      continue;
+    if (sscanf(line, "%" SCNu64 " %u %u", &delta_ns, &pin, &level) != 3 ||
+        !GPIO_IS_VALID_GPIO((int)pin) || level > 1)
+    {
+      err = ESP_ERR_INVALID_ARG;
+      break;
+    }
+
+    if (s_wave.count == capacity)
+    {
+      capacity = capacity ? capacity * 2 : GPIO_SIM_WAVE_INITIAL_CAPACITY;
+      gpio_sim_transition_t *grown =
+          realloc(s_wave.transitions, capacity * sizeof(*grown));
+      if (grown == NULL)
+      {
+        err = ESP_ERR_NO_MEM;
+        break;
+      }
+      s_wave.transitions = grown;
+    }
+
+    at_ns += delta_ns;
+    s_wave.transitions[s_wave.count++] = (gpio_sim_transition_t){
+        .at = start + gpio_sim_ns_to_cycles(at_ns),
+        .pin = (uint8_t)pin,
+        .level = (uint8_t)level,
+    };
+  }
+
+  fclose(file);
+  if (err != ESP_OK)
+    gpio_sim_wave_unload();
+
+  return err;
+}
+
+bool gpio_sim_wave_step(void)
+{
+  if (s_wave.next >= s_wave.count)
+    return false;
+
+  const gpio_sim_transition_t *t = &s_wave.transitions[s_wave.next++];
+
+  uint64_t now = gpio_sim_now();
+  if (t->at > now)
+    gpio_sim_advance(t->at - now);
+
+  gpio_sim_set_input((gpio_num_t)t->pin, t->level);
+  return true;
+}
+
+size_t gpio_sim_wave_run_until(uint64_t until)
+{
+  size_t applied = 0;
+
+  while (s_wave.next < s_wave.count && s_wave.transitions[s_wave.next].at <= until)
+  {
+    gpio_sim_wave_step();
+    applied++;
+  }
+
+  uint64_t now = gpio_sim_now();
+  if (until > now && until != UINT64_MAX)
+    gpio_sim_advance(until - now);
+
+  return applied;
+}
+
+size_t gpio_sim_wave_run(void)
+{
+  return gpio_sim_wave_run_until(UINT64_MAX);
+}
+
+bool gpio_sim_wave_done(void)
+{
+  return s_wave.next >= s_wave.count;
+}
+
+void gpio_sim_wave_unload(void)
+{
+  free(s_wave.transitions);
+  s_wave = (gpio_sim_wave_t){0};
+}
+
+esp_err_t gpio_sim_rec_start(const char *path, uint64_t pin_mask)
+{
+  gpio_sim_rec_stop();
+
+  FILE *file = fopen(path, "w");
+  if (file == NULL)
+    return ESP_ERR_NOT_FOUND;
+
+  fprintf(file, "# <delta_ns> <pin> <level>\n");
+  uint64_t now_ns = gpio_sim_now_ns();
+
+  gpio_sim_lock();
+  s_rec = (gpio_sim_rec_t){
+      .file = file,
+      .pin_mask = pin_mask,
+      .last_ns = now_ns,
+  };
+  gpio_sim_unlock();
+
+  return ESP_OK;
+}
+
+size_t gpio_sim_rec_stop(void)
+{
+  gpio_sim_lock();
+  gpio_sim_rec_t rec = s_rec;
+  s_rec = (gpio_sim_rec_t){0};
+  gpio_sim_unlock();
+
+  if (rec.file != NULL)
+    fclose(rec.file);
+
+  return rec.count;
+}
+
+void gpio_sim_rec_outputs(uint64_t now_ns, uint64_t before, uint64_t after)
+{
+  uint64_t changed = (before ^ after) & s_rec.pin_mask;
+  if (s_rec.file == NULL || changed == 0)
+    return;
+
+  while (changed)
+  {
+    int pin = __builtin_ctzll(changed);
+    changed &= changed - 1;
+
+    fprintf(s_rec.file, "%" PRIu64 " %d %d\n", now_ns - s_rec.last_ns, pin,
+            (int)((after >> pin) & 1));
+    s_rec.last_ns = now_ns;
+    s_rec.count++;
+  }
+}
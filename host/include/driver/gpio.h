@@ -0,0 +1,150 @@
+/**
+ * @file gpio.h
+ * @brief Host stand-in for the ESP-IDF `driver/gpio.h` API.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Only built for the `linux` IDF target. It declares the subset of the GPIO
+ * driver used by this component, backed by the simulated ESP32 GPIO block
+ * of gpio_sim.c. The simulator control API lives in gpio_sim.h.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_DRIVER_GPIO_H
+#define GPIO_SIM_DRIVER_GPIO_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief GPIO numbers of the ESP32.
+ */
+typedef enum
+{
+  GPIO_NUM_NC = -1,
+  GPIO_NUM_0 = 0,
+  GPIO_NUM_1 = 1,
+  GPIO_NUM_2 = 2,
+  GPIO_NUM_3 = 3,
+  GPIO_NUM_4 = 4,
+  GPIO_NUM_5 = 5,
+  GPIO_NUM_6 = 6,
+  GPIO_NUM_7 = 7,
+  GPIO_NUM_8 = 8,
+  GPIO_NUM_9 = 9,
+  GPIO_NUM_10 = 10,
+  GPIO_NUM_11 = 11,
+  GPIO_NUM_12 = 12,
+  GPIO_NUM_13 = 13,
+  GPIO_NUM_14 = 14,
+  GPIO_NUM_15 = 15,
+  GPIO_NUM_16 = 16,
+  GPIO_NUM_17 = 17,
+  GPIO_NUM_18 = 18,
+  GPIO_NUM_19 = 19,
+  GPIO_NUM_20 = 20,
+  GPIO_NUM_21 = 21,
+  GPIO_NUM_22 = 22,
+  GPIO_NUM_23 = 23,
+  GPIO_NUM_25 = 25,
+  GPIO_NUM_26 = 26,
+  GPIO_NUM_27 = 27,
+  GPIO_NUM_32 = 32,
+  GPIO_NUM_33 = 33,
+  GPIO_NUM_34 = 34,
+  GPIO_NUM_35 = 35,
+  GPIO_NUM_36 = 36,
+  GPIO_NUM_37 = 37,
+  GPIO_NUM_38 = 38,
+  GPIO_NUM_39 = 39,
+  GPIO_NUM_MAX,
+} gpio_num_t;
+
+#define SOC_GPIO_VALID_GPIO_MASK                                              \
+  (0xFFFFFFFFFFULL & ~((1ULL << 24) | (1ULL << 28) | (1ULL << 29) |           \
+                       (1ULL << 30) | (1ULL << 31)))
+#define SOC_GPIO_VALID_OUTPUT_GPIO_MASK (SOC_GPIO_VALID_GPIO_MASK & 0x3FFFFFFFFULL)
+
+// The masks only span 64 bits: bound the shift with a plain integer compare
+#define GPIO_IS_VALID_GPIO(gpio_num)                                          \
+  ((unsigned)(gpio_num) < 64U &&                                              \
+   ((1ULL << (gpio_num)) & SOC_GPIO_VALID_GPIO_MASK) != 0)
+#define GPIO_IS_VALID_OUTPUT_GPIO(gpio_num)                                   \
+  ((unsigned)(gpio_num) < 64U &&                                              \
+   ((1ULL << (gpio_num)) & SOC_GPIO_VALID_OUTPUT_GPIO_MASK) != 0)
+
+typedef enum
+{
+  GPIO_MODE_DISABLE = 0,
+  GPIO_MODE_INPUT = 1,
+  GPIO_MODE_OUTPUT = 2,
+  GPIO_MODE_INPUT_OUTPUT = 3,
+  GPIO_MODE_OUTPUT_OD = 6,
+  GPIO_MODE_INPUT_OUTPUT_OD = 7,
+} gpio_mode_t;
+
+typedef enum
+{
+  GPIO_PULLUP_DISABLE = 0,
+  GPIO_PULLUP_ENABLE = 1,
+} gpio_pullup_t;
+
+typedef enum
+{
+  GPIO_PULLDOWN_DISABLE = 0,
+  GPIO_PULLDOWN_ENABLE = 1,
+} gpio_pulldown_t;
+
+typedef enum
+{
+  GPIO_INTR_DISABLE = 0,
+  GPIO_INTR_POSEDGE = 1,
+  GPIO_INTR_NEGEDGE = 2,
+  GPIO_INTR_ANYEDGE = 3,
+  GPIO_INTR_LOW_LEVEL = 4,
+  GPIO_INTR_HIGH_LEVEL = 5,
+  GPIO_INTR_MAX,
+} gpio_int_type_t;
+
+typedef struct
+{
+  uint64_t pin_bit_mask;
+  gpio_mode_t mode;
+  gpio_pullup_t pull_up_en;
+  gpio_pulldown_t pull_down_en;
+  gpio_int_type_t intr_type;
+} gpio_config_t;
+
+typedef void (*gpio_isr_t)(void *arg);
+
+/**
+ * @brief Handle of a handler registered with gpio_isr_register().
+ */
+typedef struct gpio_sim_vector *gpio_isr_handle_t;
+
+// Flags of esp_intr_alloc.h understood by the simulator
+#define ESP_INTR_FLAG_SHARED (1 << 8)
+#define ESP_INTR_FLAG_IRAM (1 << 10)
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig);
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num);
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+int gpio_get_level(gpio_num_t gpio_num);
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type);
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num);
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num);
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type);
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num);
+esp_err_t gpio_install_isr_service(int intr_alloc_flags);
+void gpio_uninstall_isr_service(void);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler,
+                               void *args);
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num);
+esp_err_t gpio_isr_register(void (*fn)(void *), void *arg,
+                            int intr_alloc_flags, gpio_isr_handle_t *handle);
+esp_err_t gpio_hold_en(gpio_num_t gpio_num);
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num);
+
+#endif  // GPIO_SIM_DRIVER_GPIO_H
@@ -0,0 +1,58 @@
+/**
+ * @file esp_partition.h
+ * @brief Host stand-in for the ESP-IDF `esp_partition.h` API.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Only built for the `linux` IDF target. It declares the subset of the
+ * partition API used by this component, backed by the file-backed flash
+ * partition of gpio_sim_flash.c, opened with gpio_sim_flash_open(). Writes
+ * can only clear bits and erases set whole sectors back to 0xFF, as on NOR
+ * flash.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_ESP_PARTITION_H
+#define GPIO_SIM_ESP_PARTITION_H
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+typedef enum
+{
+  ESP_PARTITION_TYPE_APP = 0x00,
+  ESP_PARTITION_TYPE_DATA = 0x01,
+  ESP_PARTITION_TYPE_ANY = 0xff,
+} esp_partition_type_t;
+
+typedef enum
+{
+  ESP_PARTITION_SUBTYPE_DATA_UNDEFINED = 0x06,
+  ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct
+{
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  uint32_t erase_size;
+  char label[17];
+} esp_partition_t;
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type,
+                                                esp_partition_subtype_t subtype,
+                                                const char *label);
+esp_err_t esp_partition_read(const esp_partition_t *partition,
+                             size_t src_offset, void *dst, size_t size);
+esp_err_t esp_partition_write(const esp_partition_t *partition,
+                              size_t dst_offset, const void *src, size_t size);
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition,
+                                    size_t offset, size_t size);
+
+#endif  // GPIO_SIM_ESP_PARTITION_H
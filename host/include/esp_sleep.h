@@ -0,0 +1,40 @@
+/**
+ * @file esp_sleep.h
+ * @brief Host stand-in for the ESP-IDF `esp_sleep.h` API.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Only built for the `linux` IDF target. It declares the GPIO light-sleep
+ * subset used by this component, backed by gpio_sim_sleep.c. While asleep
+ * the CPU is stopped: the loaded waveform is replayed until a pin enabled
+ * with gpio_wakeup_enable() is at its level, and the interrupts latched
+ * meanwhile are delivered once it wakes.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_ESP_SLEEP_H
+#define GPIO_SIM_ESP_SLEEP_H
+
+#include <esp_err.h>
+
+typedef enum
+{
+  ESP_SLEEP_WAKEUP_ALL = 1,
+  ESP_SLEEP_WAKEUP_GPIO = 7,
+} esp_sleep_source_t;
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void);
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source);
+
+/**
+ * @brief Light-sleep until a GPIO wake-up pin is at its level.
+ *
+ * @return
+ * - **ESP_OK** once woken
+ * - **ESP_ERR_INVALID_STATE** if nothing would wake the chip: no GPIO
+ *   wake-up source, or a waveform that ends first
+ */
+esp_err_t esp_light_sleep_start(void);
+
+#endif  // GPIO_SIM_ESP_SLEEP_H
@@ -0,0 +1,684 @@
+/**
+ * @file gpio_sim_bench.h
+ * @brief Benchmarks and stress runs of the driver on the host simulator.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Each run sets the simulator up, drives the driver through one scenario
+ * and returns its figures; the test cases of the host test app check them.
+ * Most runs reset the simulator before and after, so they can run in any
+ * order.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SIM_BENCH_H
+#define GPIO_SIM_BENCH_H
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+#include "gpio_sim.h"
+
+/**
+ * @brief Simulated CPU frequency of the runs, in MHz.
+ */
+#define GPIO_SIM_BENCH_CPU_MHZ 240
+
+/**
+ * @brief Input with an ISR handler used by the runs.
+ */
+#define GPIO_SIM_BENCH_IRQ_PIN D12
+
+/**
+ * @brief Number of pins in gpio_sim_bench_pins.
+ */
+#define GPIO_SIM_BENCH_PINS 16
+
+/**
+ * @brief Pins used by the runs that need many of them, all outputs capable.
+ */
+extern const gpio_pinout_t gpio_sim_bench_pins[GPIO_SIM_BENCH_PINS];
+
+/**
+ * @brief Reset the simulator, and make the driver install its ISR service
+ * again on the next interrupt setup.
+ *
+ * gpio_sim_reset() removes the ISR service the driver installed once; every
+ * benchmark resets through this instead, so it can run after any other.
+ */
+void gpio_sim_bench_reset(void);
+
+/**
+ * @brief Result of gpio_sim_bench_concurrent_writes().
+ */
+typedef struct
+{
+  uint64_t writes;       /**< gpio_write and gpio_toggle calls issued */
+  double seconds;        /**< Host wall-clock time spent */
+  double writes_per_sec; /**< Host throughput */
+  uint64_t lost_toggles; /**< Toggles of the shared pin that were lost */
+} gpio_sim_bench_result_t;
+
+/**
+ * @brief Stress the driver with concurrent writes from both cores.
+ *
+ * Each core writes its own output pin and toggles a pin shared with the
+ * other core, while the interrupt context toggles the shared pin from an edge
+ * handler. Every lost toggle of the shared pin is a race in the driver.
+ * Resets the simulator before and after the run.
+ *
+ * @param iterations Iterations run by each core.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_concurrent_writes(uint32_t iterations,
+                                           gpio_sim_bench_result_t *result);
+
+/**
+ * @brief Faults exercised by gpio_sim_bench_faults().
+ */
+typedef enum
+{
+  GPIO_SIM_BENCH_FAULT_NONE,
+  GPIO_SIM_BENCH_FAULT_STUCK,
+  GPIO_SIM_BENCH_FAULT_GLITCH,
+  GPIO_SIM_BENCH_FAULT_STORM,
+  GPIO_SIM_BENCH_FAULT_MAX,
+} gpio_sim_bench_fault_t;
+
+/**
+ * @brief Hot path figures of the driver under one fault.
+ */
+typedef struct
+{
+  double cycles_per_write; /**< Virtual cycles per gpio_write, ISRs included */
+  uint64_t isrs;           /**< ISR handlers run during the benchmark */
+} gpio_sim_fault_bench_t;
+
+/**
+ * @brief Measure how the gpio_write hot path degrades under each fault.
+ *
+ * Runs the same output loop with the ESP32 cost model while faults hit an
+ * input with an ISR handler: none, stuck-at, a glitch train and an interrupt
+ * storm. Resets the simulator and clears the faults before and after, and
+ * leaves the ESP32 cost model set.
+ *
+ * @param writes gpio_write calls per fault.
+ * @param results One result per gpio_sim_bench_fault_t.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_faults(uint32_t writes,
+                                gpio_sim_fault_bench_t results[GPIO_SIM_BENCH_FAULT_MAX]);
+
+/**
+ * @brief Configuration calls compared by gpio_sim_bench_config().
+ */
+typedef enum
+{
+  GPIO_SIM_BENCH_CONFIG_OUTPUT,       /**< gpio_set_config_output */
+  GPIO_SIM_BENCH_CONFIG_OUTPUT_NOLOG, /**< gpio_set_config_output_nolog */
+  GPIO_SIM_BENCH_CONFIG_INPUT,        /**< gpio_set_config_input */
+  GPIO_SIM_BENCH_CONFIG_INPUT_NOLOG,  /**< gpio_set_config_input_nolog */
+  GPIO_SIM_BENCH_CONFIG_MAX,
+} gpio_sim_bench_config_t;
+
+/**
+ * @brief Cost of one configuration call.
+ */
+typedef struct
+{
+  double cycles_per_call; /**< Virtual cycles, from the cost model */
+  double ns_per_call;     /**< Host wall-clock time, logging included */
+} gpio_sim_config_bench_t;
+
+/**
+ * @brief Measure the cost of the logging and _nolog configuration calls.
+ *
+ * The virtual cycles, from the ESP32 cost model, only cover the simulated
+ * hardware; the logging cost shows in the host time. Resets the simulator
+ * before and after, and leaves the ESP32 cost model set.
+ *
+ * @param calls Calls per configuration function.
+ * @param results One result per gpio_sim_bench_config_t.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_config(uint32_t calls,
+                                gpio_sim_config_bench_t results[GPIO_SIM_BENCH_CONFIG_MAX]);
+
+/**
+ * @brief Result of gpio_sim_bench_backend(), in host nanoseconds per call.
+ */
+typedef struct
+{
+  uint32_t backends; /**< Pin backends built in (1: native only) */
+  double ll_ns;      /**< Register store alone, no driver call */
+  double write_ns;   /**< gpio_write_h() */
+  double read_ns;    /**< gpio_read_h() */
+  double toggle_ns;  /**< gpio_toggle_h() */
+  double object_ns;  /**< gpio_write() */
+  double dispatch_ns; /**< gpio_write_h() rejecting GPIO_NUM_MAX */
+} gpio_sim_backend_bench_t;
+
+/**
+ * @brief Measure the driver calls on a native pin, to compare the direct
+ * calls of a native-only build with the backend table of a build with
+ * virtual pins.
+ *
+ * The simulator registers cost far more than a real store, so compare
+ * dispatch_ns, which reaches no register, between the two configurations.
+ * Resets the simulator before and after.
+ *
+ * @param calls Calls of each function.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_backend(uint32_t calls,
+                                 gpio_sim_backend_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_fast_isr(), in virtual cycles.
+ */
+typedef struct
+{
+  double service_cycles; /**< Edge to handler through the ISR service */
+  double fast_cycles;    /**< Edge to handler through a trampoline */
+  uint32_t missed;       /**< Edges whose handler did not run (0 expected) */
+} gpio_sim_fast_isr_bench_t;
+
+/**
+ * @brief Compare the entry-to-handler latency of the ISR service with a
+ * generated trampoline, with the ESP32 cost model.
+ *
+ * The service costs isr_entry per handler. A trampoline costs isr_vector
+ * plus the status register read and clear it issues. Resets the simulator
+ * before and after, and leaves the ESP32 cost model set.
+ *
+ * @param edges Falling edges injected on each path.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_FAST_ISR is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_fast_isr(uint32_t edges,
+                                  gpio_sim_fast_isr_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_latch().
+ */
+typedef struct
+{
+  uint32_t isr_seen;   /**< Pulses handled by the ISR service */
+  uint32_t level_seen; /**< Pulses seen by reading the level at each poll */
+  uint32_t latched;    /**< Pulses returned by gpio_poll_edges() */
+  double isr_cycles;   /**< Virtual cycles per pulse in the ISR service */
+  double poll_cycles;  /**< Virtual cycles per gpio_poll_edges() */
+} gpio_sim_latch_bench_t;
+
+/**
+ * @brief Compare the capture of pulses narrower than the polling period by
+ * the ISR service, by a poll of the level and by the status latch of
+ * gpio_set_latch(), with the ESP32 cost model.
+ *
+ * Each pulse is a falling then rising edge injected between two polls. The
+ * level poll misses them all; the latch catches them all, for the cost of
+ * one status read and clear per poll instead of one interrupt per pulse.
+ * Resets the simulator before and after, and leaves the ESP32 cost model
+ * set.
+ *
+ * @param pulses Pulses injected on each path.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_latch(uint32_t pulses,
+                               gpio_sim_latch_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_edge_check().
+ */
+typedef struct
+{
+  uint32_t edges;           /**< Edges injected */
+  uint32_t raising;         /**< Edges of the interrupt type among them */
+  uint32_t handled;         /**< ISR handler calls */
+  uint32_t tail;            /**< Extra delay of the last call, in periods */
+  gpio_edge_check_t levels; /**< gpio_get_edge_check(), no period declared */
+  gpio_edge_check_t check;  /**< gpio_get_edge_check(), period declared */
+} gpio_sim_edge_check_bench_t;
+
+/**
+ * @brief Storm an input with an ISR handler and compare the interrupts it
+ * missed with what the edge sequence check reports, with the ESP32 cost
+ * model.
+ *
+ * Above about one edge per ISR run (250 cycles), edges merge, and raising
+ * minus handled interrupts are lost. The storm runs twice: with no period,
+ * where only a GPIO_INTR_ANYEDGE input counts losses, from its levels, as
+ * a lower bound; then with the period of the storm declared with
+ * gpio_set_edge_period(), where handled plus check.lost should match
+ * raising plus tail on every edge type. The storm stops, which the period
+ * check cannot tell from lost edges: the last interrupt, taken up to one ISR
+ * run after the last edge, counts as lost the periods it came later than
+ * the first one did after its edge (tail). Resets the simulator before and
+ * after, and leaves the ESP32 cost model set.
+ *
+ * @param edges Edges to inject.
+ * @param rate_hz Edges per second of simulated time; the edges are a whole
+ * number of cycles apart at 240 MHz if 1000000000 / @p rate_hz is a
+ * multiple of 25.
+ * @param type GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE or GPIO_INTR_ANYEDGE.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_edge_check(uint32_t edges, uint32_t rate_hz,
+                                    gpio_int_type_t type,
+                                    gpio_sim_edge_check_bench_t *result);
+
+/**
+ * @brief Count the heap allocations of the driver once running.
+ *
+ * Sets up pins from the static pin pool, runs one warm-up round, then counts
+ * the allocations of @p rounds rounds of writes, toggles, reads, multi-pin
+ * writes, interrupts and deferred logs. Zero is expected. Resets the
+ * simulator before and after.
+ *
+ * @param rounds Rounds of operations to run.
+ * @param allocs Where to store the number of allocations.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if the pin pool is too small
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_SIM_COUNT_ALLOCS is disabled
+ */
+esp_err_t gpio_sim_bench_allocs(uint32_t rounds, uint64_t *allocs);
+
+/**
+ * @brief Result of gpio_sim_bench_restore().
+ */
+typedef struct
+{
+  uint64_t cold_cycles;    /**< gpio_init_impl of every pin */
+  uint64_t restore_cycles; /**< gpio_snapshot_restore plus gpio_attach_impl */
+  uint32_t cold_configs;   /**< gpio_config calls of the cold init */
+  uint32_t restore_configs; /**< gpio_config calls of the restore */
+} gpio_sim_restore_bench_t;
+
+/**
+ * @brief Compare the wake-up cost of a snapshot restore with a cold init.
+ *
+ * Initializes @p pins pins, half inputs with an ISR handler and half
+ * outputs, with the ESP32 cost model, saves a snapshot, resets the simulator
+ * as a deep sleep would, then restores the snapshot. Fails if the restored
+ * pins snapshot differently, or drive other levels. Resets the simulator
+ * before and after, and leaves the ESP32 cost model set.
+ *
+ * @param pins Number of pins, 1 to 16.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_restore(uint32_t pins, gpio_sim_restore_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_wake().
+ */
+typedef struct
+{
+  uint32_t rejected;    /**< Wake-ups on a mismatch */
+  uint32_t asleep_isrs; /**< Handler calls until the pattern matched */
+  uint32_t awake_isrs;  /**< Handler calls on one edge after waking */
+  bool done;            /**< The match came on the last transition */
+} gpio_sim_wake_bench_t;
+
+/**
+ * @brief Light-sleep on a pattern of two inputs, one with an ISR handler.
+ *
+ * Writes a waveform to @p path that wakes the chip four times, the last one
+ * on the match, and sleeps with gpio_wake_light_sleep(). The handler input
+ * falls twice meanwhile, on the level it is armed on. Then pulses it once,
+ * awake, to check that its falling edge interrupt is back. Resets the
+ * simulator before and after.
+ *
+ * @param path Waveform file to write.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_wake(const char *path, gpio_sim_wake_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_evlog().
+ */
+typedef struct
+{
+  uint32_t events;            /**< Events stored in flash */
+  uint32_t dropped;           /**< Events lost in the edge event ring */
+  uint32_t pages;             /**< Pages written */
+  double bytes_per_event;     /**< Encoded size of an event */
+  double events_per_s;        /**< Edge rate the flash time can sustain */
+  double ns_per_event;        /**< Host time to drain and encode an event */
+  uint32_t min_sector_erases; /**< Erases of the least erased sector */
+  uint32_t max_sector_erases; /**< Erases of the most erased sector */
+  uint32_t reordered;         /**< Events stored before the previous one */
+  uint32_t stored;            /**< Events read back, in the pages kept */
+  uint32_t mismatches;        /**< Events read back wrong (0 expected) */
+} gpio_sim_evlog_bench_t;
+
+/**
+ * @brief Measure the throughput and the wear of the flash event log.
+ *
+ * Raises @p edges falling edges on an input, about @p period_us apart with
+ * some jitter, drains them to a fresh partition in @p path and syncs the
+ * last page, then reads the log back and checks the pin and the time since
+ * the previous edge of each event. Once the pages fill the partition, the
+ * oldest ones are overwritten: the events read back are then the last
+ * stored edges, from the sector after the newest page on, across the end of
+ * the partition. The sustainable rate is computed from the flash busy time
+ * of typical NOR timings. Resets the simulator before and after.
+ *
+ * @param path Backing file of the partition, overwritten.
+ * @param sectors Partition size, in 4 KB sectors (at least 2).
+ * @param edges Edges to log.
+ * @param period_us Mean time between two edges, in microseconds.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_evlog(const char *path, uint32_t sectors,
+                               uint32_t edges, uint32_t period_us,
+                               gpio_sim_evlog_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_telemetry().
+ */
+typedef struct
+{
+  uint64_t naive_bytes; /**< One 10-byte record (time, pin, level) per read */
+  uint64_t frame_bytes; /**< Telemetry frames */
+  uint32_t keyframes;   /**< Keyframes sent */
+  uint32_t deltas;      /**< Delta frames sent */
+  double ratio;         /**< naive_bytes / frame_bytes */
+  uint32_t mismatches;  /**< Samples decoded to wrong levels (0 expected) */
+  uint32_t event_mismatches; /**< Same, from the edge event frames */
+} gpio_sim_telemetry_bench_t;
+
+/**
+ * @brief Compare the telemetry frames with one record per pin read.
+ *
+ * Samples 8 inputs, every other one starting high, every @p period_us with
+ * gpio_telemetry_poll(), with a keyframe per second, while random pins
+ * toggle on @p changes_per_1000 of the samples. Each frame is decoded back
+ * and checked against the sampled levels. A second encoder is fed an edge
+ * event per toggle with gpio_telemetry_encode_event(), and its frames are
+ * checked the same way once its first keyframe is decoded. Resets the
+ * simulator before and after.
+ *
+ * @param samples Samples to take.
+ * @param period_us Time between two samples, in microseconds.
+ * @param changes_per_1000 Samples out of 1000 where a pin toggles.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_telemetry(uint32_t samples, uint32_t period_us,
+                                   uint32_t changes_per_1000,
+                                   gpio_sim_telemetry_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_filter().
+ */
+typedef struct
+{
+  uint32_t edges;           /**< Level changes driven on the inputs */
+  uint32_t raw_edges;       /**< Changes seen by one read per update */
+  uint32_t filtered_edges;  /**< Changes of gpio_filter_t::levels */
+  uint32_t raw_errors;      /**< Pin reads different from the driven level */
+  uint32_t filtered_errors; /**< Filtered pins different from the driven
+                                 level, past the debounce */
+  double read_cycles;       /**< Virtual cycles per single read */
+  double filter_cycles;     /**< Virtual cycles per gpio_filter_sample() */
+} gpio_sim_filter_bench_t;
+
+/**
+ * @brief Compare single reads with gpio_filter_sample() on noisy inputs.
+ *
+ * Updates 8 inputs every 100 us, random pins toggling on 2% of the updates,
+ * while each pin gets spikes of @p noise_width cycles about every
+ * @p noise_period cycles (a slightly different period per pin). Each update
+ * reads the pins once, then filters them with 5 snapshots
+ * 2 * @p noise_width cycles apart, a hysteresis of 1 and a debounce of 2
+ * updates. The updates are jittered by up to @p noise_period cycles, so
+ * they do not sample the spikes at one phase. Resets the simulator before
+ * and after.
+ *
+ * @param updates Updates to run.
+ * @param noise_width Width of the spikes, in cycles.
+ * @param noise_period Cycles between two spikes of a pin.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_filter(uint32_t updates, uint32_t noise_width,
+                                uint32_t noise_period,
+                                gpio_sim_filter_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_expander().
+ */
+typedef struct
+{
+  double immediate_us;  /**< Bus time per round, flush after each write */
+  double batched_us;    /**< Bus time per round, batched and cached */
+  double immediate_txn; /**< Bus transactions per round, immediate */
+  double batched_txn;   /**< Bus transactions per round, batched */
+  uint32_t mismatches;  /**< Wrong outputs or reads (0 expected) */
+} gpio_sim_expander_bench_t;
+
+/**
+ * @brief Compare flushing an expander after every write with one batched
+ * flush and INT-cached reads.
+ *
+ * A MCP23017 model drives 8 outputs and reads 8 inputs. Each round writes
+ * a random pattern to the outputs and reads every input, with an input
+ * toggling on one round out of four. The immediate run flushes after every
+ * gpio_write() and has no INT line, so every read is a bus transaction; the
+ * batched run flushes once per round and reads the bus only after an INT
+ * edge. Resets the simulator before and after.
+ *
+ * @param rounds Rounds of each run.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_expander(uint32_t rounds,
+                                  gpio_sim_expander_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_shiftreg(), in microseconds per update.
+ */
+typedef struct
+{
+  uint8_t chain_bits;  /**< Length of the single chains */
+  uint8_t lane_bits;   /**< Length of each of the 4 lanes */
+  double naive_us;     /**< 74HC595 chain clocked with gpio_write() */
+  double chain_us;     /**< 74HC595 chain with gpio_vport_flush() */
+  double unchanged_us; /**< gpio_vport_flush() with nothing changed */
+  double read_us;      /**< 74HC165 chain refresh */
+  double serial_us;    /**< 4 lane-sized chains flushed one by one */
+  double lanes_us;     /**< 4 lanes with gpio_shiftreg_flush() */
+  uint32_t mismatches; /**< Wrong outputs or reads (0 expected) */
+} gpio_sim_shiftreg_bench_t;
+
+/**
+ * @brief Time shift-register chain updates with the ESP32 cost model.
+ *
+ * With GPIO_SIM_COST_ESP32_DEFAULT at 240 MHz, compares clocking a 74HC595
+ * chain bit by bit with gpio_write() against a chain flush, times a
+ * 74HC165 refresh, and compares four chains flushed in turn against one
+ * group of four lanes. The chains are 64 bits, or shorter to fit in
+ * CONFIG_GPIO_DRIVERS_VPIN_COUNT (the lanes take a quarter each). Every
+ * update writes random bits. Resets the simulator before and after.
+ *
+ * @param rounds Updates of each kind.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_shiftreg(uint32_t rounds,
+                                  gpio_sim_shiftreg_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_pps().
+ */
+typedef struct
+{
+  double drift_ppb;      /**< Local clock rate error at the end */
+  int32_t estimated_ppb; /**< Rate error tracked by gpio_pps */
+  double raw_error_ns;   /**< Error of the raw timestamps at the end */
+  double max_error_ns;   /**< Worst gpio_pps_to_ns() error once locked */
+  uint32_t lock_s;       /**< Seconds until locked */
+  uint32_t rejected;     /**< Edges rejected by the loop */
+} gpio_sim_pps_bench_t;
+
+/**
+ * @brief Discipline the driver timestamps to a simulated PPS receiver.
+ *
+ * Each second, half-way between two pulses, converts the current raw
+ * timestamp with gpio_pps_to_ns() and compares it with the true time of
+ * that same microsecond, so the microsecond quantization does not count.
+ * A glitch is injected after a quarter of the run. Runs with the all-zero
+ * cost model, so the ISR latency adds no error. Resets the simulator before
+ * and after.
+ *
+ * @param seconds Seconds to run.
+ * @param drift_ppb Local clock rate error, in ppb.
+ * @param wander_ppb Change of the rate error each second, in ppb.
+ * @param jitter_ns Peak jitter of the PPS edges, in ns.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_pps(uint32_t seconds, double drift_ppb,
+                             double wander_ppb, uint32_t jitter_ns,
+                             gpio_sim_pps_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_timestamp().
+ */
+typedef struct
+{
+  double ts_cycles;         /**< Virtual cycles per gpio_ts_now() */
+  double timer_cycles;      /**< Virtual cycles per esp_timer_get_time() */
+  uint32_t raw_inversions;  /**< Stamps out of order with the raw counters */
+  uint32_t timer_ties;      /**< Stamps of both cores in the same us */
+  uint32_t ts_inversions;   /**< Stamps out of order with gpio_ts_now()
+                                 (0 expected) */
+  uint32_t held;            /**< Stamps gpio_ts_now() raised to an earlier
+                                 one of the other core */
+  int32_t max_error_cycles; /**< Worst gpio_ts_now() error */
+  uint32_t steps;           /**< Timescale steps (0 expected) */
+} gpio_sim_timestamp_bench_t;
+
+/**
+ * @brief Stamp events on both cores, whose cycle counters are offset.
+ *
+ * With GPIO_SIM_COST_ESP32_DEFAULT at 240 MHz, takes @p stamps timestamps
+ * alternating randomly between the cores, 0 to 2 us apart, calibrating
+ * again every sixteenth of the run. Counts the stamps that land out of
+ * order with the raw cycle counters and with gpio_ts_now(), and the ones
+ * from both cores within the same esp_timer microsecond, which it cannot
+ * order. The cores' timescales disagree by a few cycles: the stamps
+ * gpio_ts_now() raised to keep its order are counted as held, and add to
+ * max_error_cycles.
+ * The cost model only charges the counter and timer reads, not the few
+ * instructions around them. Resets the simulator before and after.
+ *
+ * @param stamps Timestamps to take.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_TIMESTAMP is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_timestamp(uint32_t stamps,
+                                   gpio_sim_timestamp_bench_t *result);
+
+/**
+ * @brief Result of gpio_sim_bench_debounce().
+ */
+typedef struct
+{
+  uint32_t edges;            /**< Press and release edges, bounces aside */
+  uint32_t fixed_handled;    /**< Handler calls, window fixed at the min */
+  uint32_t adaptive_handled; /**< Handler calls, learned window */
+  uint32_t late_extra;       /**< Extra calls over the last half, learned */
+  uint32_t window_us;        /**< Learned window at the end */
+  uint32_t percentile_us;    /**< Learned burst percentile at the end */
+  uint32_t max_burst_us;     /**< Longest burst measured */
+} gpio_sim_debounce_bench_t;
+
+/**
+ * @brief Debounce a simulated switch whose contacts wear out.
+ *
+ * Each press and release bounces for up to @p bounce_us, plus up to
+ * @p wear_us more by the end of the run, with 1 to 9 edges. The presses
+ * are run twice: with a window fixed at 100 us, then with a window learned
+ * between 100 us and 20 ms. Resets the simulator before and after.
+ *
+ * @param presses Presses of the switch.
+ * @param bounce_us Longest bounce at the start, in microseconds.
+ * @param wear_us Bounce added by the end of the run, in microseconds.
+ * @param result Where to store the result.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_DEBOUNCE is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_sim_bench_debounce(uint32_t presses, uint32_t bounce_us,
+                                  uint32_t wear_us,
+                                  gpio_sim_debounce_bench_t *result);
+
+#endif  // GPIO_SIM_BENCH_H
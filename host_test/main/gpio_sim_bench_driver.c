@@ -0,0 +1,823 @@
+/**
+ * @file gpio_sim_bench_driver.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Benchmarks of the driver core on the host simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "gpio_drivers.h"
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+#include "gpio_log.h"
+#include "gpio_sim.h"
+#include "gpio_sim_bench.h"
+#include "gpio_sleep.h"
+#include "gpio_wake.h"
+
+#define GPIO_SIM_BENCH_SHARED_PIN D27
+#define GPIO_SIM_BENCH_STORM_HZ 1000000
+#define GPIO_SIM_BENCH_WAKE_PIN D14
+#define GPIO_SIM_BENCH_WAKE_STEP_NS 100000
+
+typedef struct
+{
+  gpio_t own;     /**< Pin written only by this core */
+  gpio_t *shared; /**< Pin toggled by both cores and the ISR */
+  uint32_t iterations;
+  bool stimulus; /**< This core also drives the interrupt pin */
+} gpio_sim_bench_core_t;
+
+static void gpio_sim_bench_isr(void *arg)
+{
+  gpio_toggle((gpio_t *)arg);
+}
+
+static void gpio_sim_bench_core(void *arg)
+{
+  gpio_sim_bench_core_t *core = arg;
+
+  for (uint32_t i = 0; i < core->iterations; i++)
+  {
+    gpio_write(&core->own, (i & 1) ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+    gpio_toggle(core->shared);
+    if (core->stimulus)
+      gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, i & 1);
+  }
+}
+
+esp_err_t gpio_sim_bench_concurrent_writes(uint32_t iterations,
+                                           gpio_sim_bench_result_t *result)
+{
+  if (result == NULL || iterations == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_bench_reset();
+  gpio_install_isr_service(0);
+
+  gpio_t shared = {.pin = GPIO_SIM_BENCH_SHARED_PIN};
+  gpio_sim_bench_core_t cores[GPIO_SIM_CORE_MAX] = {
+      {.own = {.pin = D13}, .shared = &shared, .iterations = iterations},
+      {.own = {.pin = D14},
+       .shared = &shared,
+       .iterations = iterations,
+       .stimulus = true},
+  };
+
+  if (gpio_set_config_output(cores[0].own.pin) != ESP_OK ||
+      gpio_set_config_output(cores[1].own.pin) != ESP_OK ||
+      gpio_set_config_output(shared.pin) != ESP_OK ||
+      gpio_set_config_input(GPIO_SIM_BENCH_IRQ_PIN, gpio_sim_bench_isr,
+                            &shared) != ESP_OK)
+    return ESP_FAIL;
+
+  struct timespec start;
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  esp_err_t err = gpio_sim_run_cores(gpio_sim_bench_core, &cores[0],
+                                     gpio_sim_bench_core, &cores[1],
+                                     GPIO_SIM_CORE_0);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  if (err != ESP_OK)
+    return err;
+
+  gpio_sim_stats_t stats;
+  gpio_sim_get_stats(&stats);
+
+  uint64_t toggles = 2ULL * iterations + stats.isrs;
+  uint64_t edges = gpio_sim_get_output_edges(GPIO_SIM_BENCH_SHARED_PIN);
+
+  result->writes = 4ULL * iterations + stats.isrs;
+  result->seconds = (double)(end.tv_sec - start.tv_sec) +
+                    (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+  result->writes_per_sec =
+      result->seconds > 0 ? (double)result->writes / result->seconds : 0;
+  result->lost_toggles = toggles > edges ? toggles - edges : 0;
+
+  gpio_sim_bench_reset();
+
+  return ESP_OK;
+}
+
+static void gpio_sim_bench_fault_isr(void *arg)
+{
+  (void)arg;
+}
+
+static esp_err_t gpio_sim_bench_fault_run(gpio_sim_bench_fault_t fault,
+                                          uint32_t writes,
+                                          gpio_sim_fault_bench_t *result)
+{
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  // One write every 100 cycles; the faults span the whole run
+  const uint32_t spacing = 100;
+  const uint64_t span = (uint64_t)writes * spacing;
+
+  gpio_sim_bench_reset();
+  gpio_sim_fault_clear();
+  gpio_sim_set_cost(&cost);
+  gpio_install_isr_service(0);
+
+  gpio_t out = {.pin = D13};
+  if (gpio_set_config_output(out.pin) != ESP_OK ||
+      gpio_set_config_input(GPIO_SIM_BENCH_IRQ_PIN, gpio_sim_bench_fault_isr,
+                            NULL) != ESP_OK)
+    return ESP_FAIL;
+
+  esp_err_t err = ESP_OK;
+  switch (fault)
+  {
+    case GPIO_SIM_BENCH_FAULT_STUCK:
+      gpio_sim_fault_stuck(GPIO_SIM_BENCH_IRQ_PIN, 0);
+      break;
+    case GPIO_SIM_BENCH_FAULT_GLITCH:
+      err = gpio_sim_fault_glitch(GPIO_SIM_BENCH_IRQ_PIN, 0, spacing / 4,
+                                  spacing * 8, writes / 8 + 1);
+      break;
+    case GPIO_SIM_BENCH_FAULT_STORM:
+      err = gpio_sim_fault_storm(GPIO_SIM_BENCH_IRQ_PIN,
+                                 GPIO_SIM_BENCH_STORM_HZ, writes);
+      break;
+    default:
+      break;
+  }
+  if (err != ESP_OK)
+    return err;
+
+  gpio_sim_stats_t before;
+  gpio_sim_get_stats(&before);
+  uint64_t start = gpio_sim_now();
+
+  for (uint32_t i = 0; i < writes; i++)
+  {
+    gpio_write(&out, (i & 1) ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+    gpio_sim_advance(spacing);
+  }
+
+  gpio_sim_stats_t after;
+  gpio_sim_get_stats(&after);
+
+  // The spacing is idle time, not part of the hot path
+  uint64_t busy = gpio_sim_now() - start - span;
+  result->cycles_per_write = (double)busy / writes;
+  result->isrs = after.isrs - before.isrs;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_bench_faults(uint32_t writes,
+                                gpio_sim_fault_bench_t results[GPIO_SIM_BENCH_FAULT_MAX])
+{
+  if (results == NULL || writes == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  esp_err_t err = ESP_OK;
+  for (int fault = 0; fault < GPIO_SIM_BENCH_FAULT_MAX && err == ESP_OK; fault++)
+    err = gpio_sim_bench_fault_run(fault, writes, &results[fault]);
+
+  gpio_sim_fault_clear();
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+static esp_err_t gpio_sim_bench_config_call(gpio_sim_bench_config_t config)
+{
+  switch (config)
+  {
+    case GPIO_SIM_BENCH_CONFIG_OUTPUT:
+      return gpio_set_config_output(D13);
+    case GPIO_SIM_BENCH_CONFIG_OUTPUT_NOLOG:
+      return gpio_set_config_output_nolog(D13);
+    case GPIO_SIM_BENCH_CONFIG_INPUT:
+      return gpio_set_config_input(GPIO_SIM_BENCH_IRQ_PIN, NULL, NULL);
+    case GPIO_SIM_BENCH_CONFIG_INPUT_NOLOG:
+      return gpio_set_config_input_nolog(GPIO_SIM_BENCH_IRQ_PIN, NULL, NULL);
+    default:
+      return ESP_ERR_INVALID_ARG;
+  }
+}
+
+esp_err_t gpio_sim_bench_config(uint32_t calls,
+                                gpio_sim_config_bench_t results[GPIO_SIM_BENCH_CONFIG_MAX])
+{
+  if (results == NULL || calls == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_set_cost(&cost);
+
+  for (int config = 0; config < GPIO_SIM_BENCH_CONFIG_MAX; config++)
+  {
+    gpio_sim_bench_reset();
+
+    struct timespec start;
+    struct timespec end;
+    uint64_t cycles = gpio_sim_now();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < calls; i++)
+    {
+      if (gpio_sim_bench_config_call(config) != ESP_OK)
+        return ESP_FAIL;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    cycles = gpio_sim_now() - cycles;
+
+    results[config].cycles_per_call = (double)cycles / calls;
+    results[config].ns_per_call =
+        ((double)(end.tv_sec - start.tv_sec) * 1e9 +
+         (double)(end.tv_nsec - start.tv_nsec)) / calls;
+  }
+
+  gpio_sim_bench_reset();
+
+  return ESP_OK;
+}
+
+static double gpio_sim_bench_ns(const struct timespec *start,
+                                const struct timespec *end, uint32_t calls)
+{
+  return ((double)(end->tv_sec - start->tv_sec) * 1e9 +
+          (double)(end->tv_nsec - start->tv_nsec)) / calls;
+}
+
+esp_err_t gpio_sim_bench_backend(uint32_t calls,
+                                 gpio_sim_backend_bench_t *result)
+{
+  if (result == NULL || calls == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_bench_reset();
+
+  gpio_t out = {.pin = D13, ._mode = GPIO_MODE_OUTPUT};
+  if (gpio_init_impl_nolog(&out) != ESP_OK)
+    return ESP_FAIL;
+
+  gpio_hdl_t hdl = gpio_get_handle(&out);
+  volatile uint32_t sink = 0;
+  struct timespec start;
+  struct timespec end;
+
+  *result = (gpio_sim_backend_bench_t){.backends = GPIO_DRV_BACKENDS};
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    gpio_drv_ll_write_pin(out.pin, i & 1);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->ll_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    gpio_write_h(hdl, i & 1 ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->write_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    sink += gpio_read_h(hdl);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->read_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    gpio_toggle_h(hdl);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->toggle_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    gpio_write(&out, i & 1 ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->object_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  // GPIO_NUM_MAX is a native pin number with no pin: dispatch and range
+  // check only, no register access
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < calls; i++)
+    sink += gpio_write_h(GPIO_NUM_MAX, GPIO_STATE_HIGH);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  result->dispatch_ns = gpio_sim_bench_ns(&start, &end, calls);
+
+  (void)sink;
+  gpio_sim_bench_reset();
+
+  return hdl != GPIO_HDL_INVALID ? ESP_OK : ESP_FAIL;
+}
+
+#if CONFIG_GPIO_DRIVERS_FAST_ISR
+typedef struct
+{
+  uint64_t at;    /**< Virtual time of the last call */
+  uint32_t calls; /**< Calls so far */
+} gpio_sim_bench_latency_t;
+
+static gpio_sim_bench_latency_t s_bench_latency;
+
+static void gpio_sim_bench_latency_isr(void *arg)
+{
+  gpio_sim_bench_latency_t *latency = arg;
+  latency->at = gpio_sim_now();
+  latency->calls++;
+}
+
+#define GPIO_SIM_BENCH_FAST_ISRS(X)                                           \
+  X(GPIO_SIM_BENCH_IRQ_PIN, gpio_sim_bench_latency_isr, &s_bench_latency)
+
+GPIO_DRV_FAST_ISR_DEFINE(gpio_sim_bench_fast_entry, GPIO_SIM_BENCH_FAST_ISRS)
+
+// Average cycles from a falling edge to the handler, through a trampoline
+// or through the ISR service
+static esp_err_t gpio_sim_bench_latency_run(uint32_t edges, bool fast,
+                                            double *cycles,
+                                            uint32_t *missed)
+{
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+
+  esp_err_t err = gpio_set_config_input_nolog(
+      GPIO_SIM_BENCH_IRQ_PIN, fast ? NULL : gpio_sim_bench_latency_isr,
+      fast ? NULL : &s_bench_latency);
+  if (err == ESP_OK && fast)
+    err = gpio_drv_fast_isr_register(gpio_sim_bench_fast_entry,
+                                     gpio_sim_bench_fast_entry_mask);
+  if (err != ESP_OK)
+    return err;
+
+  s_bench_latency = (gpio_sim_bench_latency_t){0};
+  uint64_t total = 0;
+
+  for (uint32_t i = 0; i < edges; i++)
+  {
+    uint32_t calls = s_bench_latency.calls;
+    uint64_t start = gpio_sim_now();
+    gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 0);
+    if (s_bench_latency.calls != calls)
+      total += s_bench_latency.at - start;
+    gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+  }
+
+  *cycles = s_bench_latency.calls ? (double)total / s_bench_latency.calls : 0;
+  *missed += edges - s_bench_latency.calls;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_bench_fast_isr(uint32_t edges,
+                                  gpio_sim_fast_isr_bench_t *result)
+{
+  if (result == NULL || edges == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_fast_isr_bench_t){0};
+
+  esp_err_t err = gpio_sim_bench_latency_run(
+      edges, false, &result->service_cycles, &result->missed);
+  if (err == ESP_OK)
+    err = gpio_sim_bench_latency_run(edges, true, &result->fast_cycles,
+                                     &result->missed);
+
+  gpio_sim_bench_reset();
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_fast_isr(uint32_t edges,
+                                  gpio_sim_fast_isr_bench_t *result)
+{
+  (void)edges;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
+
+static uint32_t s_bench_latch_isrs;
+
+static void gpio_sim_bench_latch_isr(void *arg)
+{
+  (void)arg;
+  s_bench_latch_isrs++;
+}
+
+// A pulse too narrow for any poll to see its level
+static void gpio_sim_bench_pulse(void)
+{
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 0);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+}
+
+static void gpio_sim_bench_latch_reset(void)
+{
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+}
+
+esp_err_t gpio_sim_bench_latch(uint32_t pulses,
+                               gpio_sim_latch_bench_t *result)
+{
+  if (result == NULL || pulses == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_latch_bench_t){0};
+  const uint64_t bit = 1ULL << GPIO_SIM_BENCH_IRQ_PIN;
+
+  // ISR service: the pulses cost the CPU while it does something else
+  gpio_sim_bench_latch_reset();
+  esp_err_t err = gpio_set_config_input_nolog(
+      GPIO_SIM_BENCH_IRQ_PIN, gpio_sim_bench_latch_isr, NULL);
+  if (err != ESP_OK)
+    goto exit;
+
+  s_bench_latch_isrs = 0;
+  uint64_t start = gpio_sim_now();
+  for (uint32_t i = 0; i < pulses; i++)
+    gpio_sim_bench_pulse();
+  result->isr_cycles = (double)(gpio_sim_now() - start) / pulses;
+  result->isr_seen = s_bench_latch_isrs;
+
+  // Latch: nothing runs until the poll, which reads the level too
+  gpio_sim_bench_latch_reset();
+  err = gpio_set_config_input_nolog(GPIO_SIM_BENCH_IRQ_PIN, NULL, NULL);
+  gpio_t in = {.pin = GPIO_SIM_BENCH_IRQ_PIN, ._mode = GPIO_MODE_INPUT};
+  if (err == ESP_OK)
+    err = gpio_set_latch(&in, GPIO_INTR_NEGEDGE);
+  if (err != ESP_OK)
+    goto exit;
+
+  uint64_t poll_cycles = 0;
+  for (uint32_t i = 0; i < pulses; i++)
+  {
+    gpio_sim_bench_pulse();
+
+    if (!(gpio_read_mask(bit) & bit))
+      result->level_seen++;
+
+    start = gpio_sim_now();
+    if (gpio_poll_edges(bit) & bit)
+      result->latched++;
+    poll_cycles += gpio_sim_now() - start;
+  }
+  result->poll_cycles = (double)poll_cycles / pulses;
+
+exit:
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+#if CONFIG_GPIO_DRIVERS_EDGE_CHECK
+typedef struct
+{
+  uint32_t calls;
+  uint64_t first; /**< Simulated time of the first call */
+  uint64_t last;  /**< Simulated time of the last call */
+} gpio_sim_bench_edge_isr_t;
+
+static void gpio_sim_bench_edge_isr(void *arg)
+{
+  gpio_sim_bench_edge_isr_t *isr = arg;
+  isr->last = gpio_sim_now();
+  if (isr->calls++ == 0)
+    isr->first = isr->last;
+}
+
+// Storm the input once, checking its edges with a declared period or none.
+// Returns in *after how much later after its edge the last handler call came
+// than the first
+static esp_err_t gpio_sim_bench_edge_storm(uint32_t edges, uint32_t rate_hz,
+                                           gpio_int_type_t type,
+                                           uint32_t period_ns,
+                                           uint32_t *handled,
+                                           uint64_t *after,
+                                           gpio_edge_check_t *check)
+{
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_fault_clear();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+
+  gpio_sim_bench_edge_isr_t isr = {0};
+  gpio_t input = {
+      .pin = GPIO_SIM_BENCH_IRQ_PIN,
+      ._mode = GPIO_MODE_INPUT,
+      .isr_handler = gpio_sim_bench_edge_isr,
+      .isr_handler_arg = &isr,
+  };
+  esp_err_t err = gpio_init_impl_nolog(&input);
+  if (err == ESP_OK)
+    err = gpio_set_edge(&input, type);
+  if (err == ESP_OK)
+    err = gpio_reset_edge_check();
+  if (err == ESP_OK)
+    err = gpio_set_edge_period(&input, period_ns);
+  uint64_t start = gpio_sim_now();
+  if (err == ESP_OK)
+    err = gpio_sim_fault_storm(input.pin, rate_hz, edges);
+  if (err != ESP_OK)
+    goto exit;
+
+  // Run past the last edge, one period at a time
+  uint64_t period = (uint64_t)GPIO_SIM_BENCH_CPU_MHZ * 1000000 / rate_hz;
+  for (uint32_t i = 0; i <= edges; i++)
+    gpio_sim_advance(period ? period : 1);
+
+  err = gpio_get_edge_check(input.pin, check);
+  *handled = isr.calls;
+  // The first call anchors the check, so only the extra delay of the last
+  // one counts. The storm spaces the edges by whole nanoseconds
+  uint64_t spacing =
+      (uint64_t)(1000000000 / rate_hz) * GPIO_SIM_BENCH_CPU_MHZ / 1000;
+  int64_t delay = (int64_t)(isr.last - (start + edges * spacing)) -
+                  (int64_t)(isr.first - (start + spacing));
+  *after = delay > 0 ? (uint64_t)delay : 0;
+
+exit:
+  gpio_sim_fault_clear();
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+esp_err_t gpio_sim_bench_edge_check(uint32_t edges, uint32_t rate_hz,
+                                    gpio_int_type_t type,
+                                    gpio_sim_edge_check_bench_t *result)
+{
+  if (result == NULL || edges == 0 || rate_hz == 0 ||
+      (type != GPIO_INTR_POSEDGE && type != GPIO_INTR_NEGEDGE &&
+       type != GPIO_INTR_ANYEDGE))
+    return ESP_ERR_INVALID_ARG;
+
+  // The storm starts high, so its first edge falls
+  *result = (gpio_sim_edge_check_bench_t){
+      .edges = edges,
+      .raising = type == GPIO_INTR_ANYEDGE   ? edges
+                 : type == GPIO_INTR_NEGEDGE ? (edges + 1) / 2
+                                             : edges / 2,
+  };
+
+  uint32_t period_ns = 1000000000 / rate_hz;
+  if (type != GPIO_INTR_ANYEDGE)
+    period_ns *= 2;
+
+  uint64_t after = 0;
+  esp_err_t err =
+      gpio_sim_bench_edge_storm(edges, rate_hz, type, 0, &result->handled,
+                                &after, &result->levels);
+  if (err == ESP_OK)
+    err = gpio_sim_bench_edge_storm(edges, rate_hz, type, period_ns,
+                                    &result->handled, &after, &result->check);
+
+  // The periods the last interrupt came after the last edge, to the nearest
+  uint64_t period = (uint64_t)period_ns * GPIO_SIM_BENCH_CPU_MHZ / 1000;
+  result->tail = (uint32_t)((after + period / 2) / period);
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_edge_check(uint32_t edges, uint32_t rate_hz,
+                                    gpio_int_type_t type,
+                                    gpio_sim_edge_check_bench_t *result)
+{
+  (void)edges;
+  (void)rate_hz;
+  (void)type;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
+
+static void gpio_sim_bench_alloc_round(gpio_t *out, gpio_t *in, uint32_t i)
+{
+  gpio_write(out, (i & 1) ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+  gpio_toggle(out);
+  gpio_read(in);
+  gpio_write_mask(1ULL << out->pin, i & 1 ? 0 : UINT64_MAX);
+  gpio_sim_set_input(in->pin, i & 1);
+  GPIO_LOG_DEFERRED(ESP_LOG_INFO, "BENCH", "round %d", (int)i);
+  gpio_log_flush();
+}
+
+esp_err_t gpio_sim_bench_allocs(uint32_t rounds, uint64_t *allocs)
+{
+  if (allocs == NULL || rounds == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  uint64_t before;
+  esp_err_t err = gpio_sim_alloc_count(&before);
+  if (err != ESP_OK)
+    return err;
+
+  gpio_sim_bench_reset();
+
+  gpio_t *out = gpio_alloc();
+  gpio_t *in = gpio_alloc();
+  if (out == NULL || in == NULL)
+  {
+    err = ESP_ERR_NO_MEM;
+    goto exit;
+  }
+
+  out->pin = D13;
+  out->_mode = GPIO_MODE_OUTPUT;
+  in->pin = GPIO_SIM_BENCH_IRQ_PIN;
+  in->_mode = GPIO_MODE_INPUT;
+  in->isr_handler = gpio_sim_bench_fault_isr;
+
+  if (gpio_init_impl_nolog(out) != ESP_OK || gpio_init_impl_nolog(in) != ESP_OK)
+  {
+    err = ESP_FAIL;
+    goto exit;
+  }
+
+  // Let the logs and the host C library do their one-time allocations
+  gpio_sim_bench_alloc_round(out, in, 0);
+
+  gpio_sim_alloc_count(&before);
+  for (uint32_t i = 1; i <= rounds; i++)
+    gpio_sim_bench_alloc_round(out, in, i);
+
+  uint64_t after;
+  gpio_sim_alloc_count(&after);
+  *allocs = after - before;
+
+exit:
+  if (out != NULL)
+    gpio_free(out);
+  if (in != NULL)
+    gpio_free(in);
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+void gpio_sim_bench_reset(void)
+{
+  gpio_sim_reset();
+  gpio_drv_isr_service_reset();
+}
+
+const gpio_pinout_t gpio_sim_bench_pins[GPIO_SIM_BENCH_PINS] = {
+    D13, D12, D14, D27, D26, D25, D33, D32,
+    D23, D22, D21, D19, D18, D5, D4, D15,
+};
+
+static esp_err_t gpio_sim_bench_restore_pins(gpio_t *pins, uint32_t count,
+                                             bool cold)
+{
+  for (uint32_t i = 0; i < count; i++)
+  {
+    pins[i] = (gpio_t){
+        .pin = gpio_sim_bench_pins[i],
+        ._mode = (i & 1) ? GPIO_MODE_INPUT : GPIO_MODE_OUTPUT,
+        ._act_state = (i & 2) ? GPIO_STATE_HIGH : GPIO_STATE_LOW,
+        .isr_handler = (i & 1) ? gpio_sim_bench_fault_isr : NULL,
+    };
+
+    if (cold)
+      gpio_init_impl(&pins[i]);
+    else if (gpio_attach_impl(&pins[i]) != ESP_OK)
+      return ESP_FAIL;
+  }
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_bench_restore(uint32_t pins, gpio_sim_restore_bench_t *result)
+{
+  if (result == NULL || pins == 0 || pins > GPIO_SIM_BENCH_PINS)
+    return ESP_ERR_INVALID_ARG;
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_t objects[GPIO_SIM_BENCH_PINS];
+  gpio_snapshot_t snapshot;
+  gpio_sim_stats_t stats;
+
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+
+  uint64_t start = gpio_sim_now();
+  gpio_sim_bench_restore_pins(objects, pins, true);
+  result->cold_cycles = gpio_sim_now() - start;
+  gpio_sim_get_stats(&stats);
+  result->cold_configs = (uint32_t)stats.configs;
+
+  uint64_t levels = gpio_sim_get_outputs();
+  gpio_snapshot_save(&snapshot);
+
+  // Deep sleep: the chip comes back with every pin and the ISR service
+  // reset, and gpio_attach_impl() installs the service again
+  gpio_sim_bench_reset();
+
+  start = gpio_sim_now();
+  esp_err_t err = gpio_snapshot_restore(&snapshot);
+
+  // The restored configuration snapshots the same, ISR pins included, before
+  // gpio_attach_impl() adds the handlers; not timed
+  uint64_t check = gpio_sim_now();
+  gpio_snapshot_t restored;
+  gpio_snapshot_save(&restored);
+  if (err == ESP_OK && memcmp(&restored, &snapshot, sizeof(snapshot)) != 0)
+    err = ESP_FAIL;
+  start += gpio_sim_now() - check;
+
+  if (err == ESP_OK)
+    err = gpio_sim_bench_restore_pins(objects, pins, false);
+  result->restore_cycles = gpio_sim_now() - start;
+  gpio_sim_get_stats(&stats);
+  result->restore_configs = (uint32_t)stats.configs;
+
+  if (err == ESP_OK && gpio_sim_get_outputs() != levels)
+    err = ESP_FAIL;
+
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+static void gpio_sim_bench_count_isr(void *arg)
+{
+  (*(uint32_t *)arg)++;
+}
+
+esp_err_t gpio_sim_bench_wake(const char *path, gpio_sim_wake_bench_t *result)
+{
+  if (path == NULL || result == NULL)
+    return ESP_ERR_INVALID_ARG;
+
+  // Wait for the interrupt pin low with the other one high. Each transition
+  // wakes the chip, and only the last one makes the pattern match
+  static const uint8_t steps[][2] = {
+      {GPIO_SIM_BENCH_IRQ_PIN, 0},
+      {GPIO_SIM_BENCH_IRQ_PIN, 1},
+      {GPIO_SIM_BENCH_WAKE_PIN, 1},
+      {GPIO_SIM_BENCH_IRQ_PIN, 0},
+  };
+  const gpio_wake_pattern_t pattern = {
+      .pin_mask = (1ULL << GPIO_SIM_BENCH_IRQ_PIN) |
+                  (1ULL << GPIO_SIM_BENCH_WAKE_PIN),
+      .levels = 1ULL << GPIO_SIM_BENCH_WAKE_PIN,
+  };
+
+  FILE *file = fopen(path, "w");
+  if (file == NULL)
+    return ESP_FAIL;
+  fputs("# delta_ns pin level\n", file);
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    fprintf(file, "%u %u %u\n", (unsigned)GPIO_SIM_BENCH_WAKE_STEP_NS,
+            (unsigned)steps[i][0], (unsigned)steps[i][1]);
+  fclose(file);
+
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(NULL);
+  gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+  gpio_sim_set_input(GPIO_SIM_BENCH_WAKE_PIN, 0);
+
+  uint32_t calls = 0;
+  gpio_t irq = {
+      .pin = GPIO_SIM_BENCH_IRQ_PIN,
+      ._mode = GPIO_MODE_INPUT,
+      .isr_handler = gpio_sim_bench_count_isr,
+      .isr_handler_arg = &calls,
+  };
+  gpio_t other = {.pin = GPIO_SIM_BENCH_WAKE_PIN, ._mode = GPIO_MODE_INPUT};
+
+  esp_err_t err = gpio_init_impl_nolog(&irq);
+  if (err == ESP_OK)
+    err = gpio_init_impl_nolog(&other);
+  if (err == ESP_OK)
+    err = gpio_sim_wave_load(path);
+  if (err == ESP_OK)
+    err = gpio_wake_light_sleep(&pattern, &result->rejected);
+  result->asleep_isrs = calls;
+  result->done = gpio_sim_wave_done();
+
+  // Back on its falling edge interrupt, and unmasked
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+  gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 0);
+  result->awake_isrs = calls - result->asleep_isrs;
+
+  gpio_sim_wave_unload();
+  gpio_sim_bench_reset();
+
+  return err;
+}
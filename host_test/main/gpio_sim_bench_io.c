@@ -0,0 +1,725 @@
+/**
+ * @file gpio_sim_bench_io.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Benchmarks of the logging, telemetry and I/O expansion modules on
+ * the host simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "gpio_drivers.h"
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+#include "gpio_evlog.h"
+#include "gpio_filter.h"
+#include "gpio_sim.h"
+#include "gpio_sim_bench.h"
+#include "gpio_telemetry.h"
+
+#define GPIO_SIM_BENCH_EVLOG_LABEL "gpio_evlog"
+#define GPIO_SIM_BENCH_EVLOG_BATCH 16
+#define GPIO_SIM_BENCH_TELEMETRY_PINS 8
+#define GPIO_SIM_BENCH_TELEMETRY_KEY_US 1000000
+#define GPIO_SIM_BENCH_FILTER_PERIOD_US 100
+#define GPIO_SIM_BENCH_FILTER_CHANGES 20
+#define GPIO_SIM_BENCH_FILTER_SAMPLES 5
+#define GPIO_SIM_BENCH_FILTER_HYSTERESIS 1
+#define GPIO_SIM_BENCH_FILTER_DEBOUNCE 2
+#define GPIO_SIM_BENCH_NAIVE_RECORD 10
+#define GPIO_SIM_BENCH_EXPANDER_ADDR 0x20
+#define GPIO_SIM_BENCH_EXPANDER_OUTPUTS 8
+#define GPIO_SIM_BENCH_SHIFTREG_LANES 4
+#define GPIO_SIM_BENCH_SHIFTREG_CLOCK D18
+#define GPIO_SIM_BENCH_SHIFTREG_LATCH D19
+
+#if CONFIG_GPIO_DRIVERS_EVLOG
+// Time from one edge of the evlog benchmark to the next, in microseconds:
+// up to a quarter of a period of jitter either way
+static uint64_t gpio_sim_bench_evlog_gap(uint32_t period_us, uint32_t *lcg)
+{
+  *lcg = *lcg * 1664525 + 1013904223;
+  return period_us - period_us / 4 + (*lcg >> 8) % (period_us / 2 + 1);
+}
+
+// Count the events stored in the log
+static uint32_t gpio_sim_bench_evlog_count(void)
+{
+  gpio_evlog_reader_t reader;
+  gpio_edge_event_t event;
+  uint32_t count = 0;
+
+  if (gpio_evlog_reader_init(&reader) != ESP_OK)
+    return 0;
+  while (gpio_evlog_read(&reader, &event) == ESP_OK)
+    count++;
+
+  return count;
+}
+
+// Read the log back, from its oldest page on, and count the events other
+// than the last stored edges raised. Once the log wrapped, the oldest page
+// comes after the newest one in the partition
+static uint32_t gpio_sim_bench_evlog_check(gpio_num_t pin, uint32_t edges,
+                                           uint32_t period_us,
+                                           uint32_t stored)
+{
+  gpio_evlog_reader_t reader;
+  if (stored == 0 || stored > edges ||
+      gpio_evlog_reader_init(&reader) != ESP_OK)
+    return edges;
+
+  // Skip the gaps before the first stored edge
+  uint32_t lcg = 1;
+  for (uint32_t i = 0; i < edges - stored; i++)
+    gpio_sim_bench_evlog_gap(period_us, &lcg);
+
+  gpio_edge_event_t event;
+  int64_t last_us = 0;
+  uint32_t mismatches = 0;
+  uint32_t read = 0;
+
+  for (; read < stored && gpio_evlog_read(&reader, &event) == ESP_OK; read++)
+  {
+    uint64_t gap_us = gpio_sim_bench_evlog_gap(period_us, &lcg);
+    if (event.pin != pin ||
+        (read > 0 && event.time_us - last_us != (int64_t)gap_us))
+      mismatches++;
+    last_us = event.time_us;
+  }
+
+  return mismatches + (stored - read);
+}
+
+esp_err_t gpio_sim_bench_evlog(const char *path, uint32_t sectors,
+                               uint32_t edges, uint32_t period_us,
+                               gpio_sim_evlog_bench_t *result)
+{
+  if (path == NULL || result == NULL || sectors < 2 || edges == 0 ||
+      period_us == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  // Free ISRs: the edges are exactly the gaps apart
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(NULL);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(0);
+  gpio_drv_evlog_unmount();
+
+  remove(path);
+  esp_err_t err = gpio_sim_flash_open(path, GPIO_SIM_BENCH_EVLOG_LABEL,
+                                      sectors * 4096);
+  if (err != ESP_OK)
+    return err;
+
+  gpio_t input = {
+      .pin = GPIO_SIM_BENCH_IRQ_PIN,
+      ._mode = GPIO_MODE_INPUT,
+  };
+  gpio_sim_set_input(input.pin, 1);
+  if (gpio_init_impl_nolog(&input) != ESP_OK ||
+      gpio_evlog_init(GPIO_SIM_BENCH_EVLOG_LABEL) != ESP_OK)
+  {
+    err = ESP_FAIL;
+    goto exit;
+  }
+
+  // Drain events left by a previous benchmark
+  gpio_edge_event_t stale;
+  while (gpio_event_pop(&stale))
+    ;
+
+  uint32_t dropped = gpio_event_get_dropped();
+  uint32_t lcg = 1;
+  uint64_t drain_ns = 0;
+  struct timespec start;
+  struct timespec end;
+
+  for (uint32_t i = 0; i < edges; i++)
+  {
+    uint64_t gap_us = gpio_sim_bench_evlog_gap(period_us, &lcg);
+    gpio_sim_advance(gap_us * GPIO_SIM_BENCH_CPU_MHZ);
+    gpio_sim_set_input(input.pin, 0);
+    gpio_sim_set_input(input.pin, 1);
+
+    if ((i + 1) % GPIO_SIM_BENCH_EVLOG_BATCH == 0 || i + 1 == edges)
+    {
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      gpio_evlog_drain();
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      drain_ns += (uint64_t)((end.tv_sec - start.tv_sec) * 1000000000LL +
+                             (end.tv_nsec - start.tv_nsec));
+    }
+  }
+
+  if (gpio_evlog_sync() != ESP_OK)
+  {
+    err = ESP_FAIL;
+    goto exit;
+  }
+
+  gpio_evlog_stats_t stats;
+  gpio_sim_flash_stats_t flash;
+  gpio_evlog_get_stats(&stats);
+  gpio_sim_flash_get_stats(&flash);
+
+  *result = (gpio_sim_evlog_bench_t){
+      .events = stats.events,
+      .dropped = gpio_event_get_dropped() - dropped,
+      .pages = stats.pages,
+      .bytes_per_event = stats.events ? (double)stats.bytes / stats.events : 0,
+      .events_per_s =
+          flash.busy_us ? stats.events * 1e6 / (double)flash.busy_us : 0,
+      .ns_per_event = stats.events ? (double)drain_ns / stats.events : 0,
+      .min_sector_erases = flash.min_sector_erases,
+      .max_sector_erases = flash.max_sector_erases,
+      .reordered = stats.reordered,
+      .stored = gpio_sim_bench_evlog_count(),
+  };
+  result->mismatches = gpio_sim_bench_evlog_check(input.pin, edges, period_us,
+                                                  result->stored);
+
+exit:
+  gpio_drv_evlog_unmount();
+  gpio_sim_flash_close();
+  gpio_sim_bench_reset();
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_evlog(const char *path, uint32_t sectors,
+                               uint32_t edges, uint32_t period_us,
+                               gpio_sim_evlog_bench_t *result)
+{
+  (void)path;
+  (void)sectors;
+  (void)edges;
+  (void)period_us;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
+
+esp_err_t gpio_sim_bench_telemetry(uint32_t samples, uint32_t period_us,
+                                   uint32_t changes_per_1000,
+                                   gpio_sim_telemetry_bench_t *result)
+{
+  if (result == NULL || samples == 0 || period_us == 0 ||
+      changes_per_1000 > 1000)
+    return ESP_ERR_INVALID_ARG;
+
+  gpio_sim_bench_reset();
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+
+  esp_err_t err = ESP_OK;
+  uint64_t pin_mask = 0;
+  uint64_t levels = 0;
+  for (int i = 0; i < GPIO_SIM_BENCH_TELEMETRY_PINS; i++)
+  {
+    gpio_sim_set_input(gpio_sim_bench_pins[i], i & 1);
+    if (gpio_set_config_input_nolog(gpio_sim_bench_pins[i], NULL, NULL) != ESP_OK)
+      err = ESP_FAIL;
+    pin_mask |= 1ULL << gpio_sim_bench_pins[i];
+    levels |= (uint64_t)(i & 1) << gpio_sim_bench_pins[i];
+  }
+
+  gpio_telemetry_enc_t enc;
+  gpio_telemetry_enc_t enc_events;
+  gpio_telemetry_dec_t dec;
+  gpio_telemetry_dec_t dec_events;
+  if (err != ESP_OK ||
+      gpio_telemetry_init(&enc, pin_mask, GPIO_SIM_BENCH_TELEMETRY_KEY_US) !=
+          ESP_OK ||
+      gpio_telemetry_init(&enc_events, pin_mask,
+                          GPIO_SIM_BENCH_TELEMETRY_KEY_US) != ESP_OK)
+  {
+    gpio_sim_bench_reset();
+    return ESP_FAIL;
+  }
+  gpio_telemetry_decoder_init(&dec);
+  gpio_telemetry_decoder_init(&dec_events);
+
+  *result = (gpio_sim_telemetry_bench_t){0};
+  uint32_t lcg = 1;
+
+  for (uint32_t i = 0; i < samples; i++)
+  {
+    lcg = lcg * 1664525 + 1013904223;
+    if ((lcg >> 8) % 1000 < changes_per_1000)
+    {
+      gpio_pinout_t pin =
+          gpio_sim_bench_pins[(lcg >> 20) % GPIO_SIM_BENCH_TELEMETRY_PINS];
+      levels ^= 1ULL << pin;
+      gpio_sim_set_input(pin, (levels >> pin) & 1);
+
+      gpio_edge_event_t event = {
+          .time_us = gpio_sim_timer_us(),
+          .pin = (uint8_t)pin,
+          .level = (levels >> pin) & 1,
+      };
+      uint8_t frame[GPIO_TELEMETRY_FRAME_MAX];
+      size_t len;
+      size_t used;
+      if (gpio_telemetry_encode_event(&enc_events, &event, frame,
+                                      sizeof(frame), &len) != ESP_OK ||
+          (len > 0 && (gpio_telemetry_decode(&dec_events, frame, len,
+                                             &used) != ESP_OK ||
+                       used != len)))
+      {
+        err = ESP_FAIL;
+        break;
+      }
+    }
+    gpio_sim_advance((uint64_t)period_us * GPIO_SIM_BENCH_CPU_MHZ);
+
+    uint8_t frame[GPIO_TELEMETRY_FRAME_MAX];
+    size_t len;
+    size_t used;
+    if (gpio_telemetry_poll(&enc, frame, sizeof(frame), &len) != ESP_OK)
+    {
+      err = ESP_FAIL;
+      break;
+    }
+
+    if (len > 0)
+    {
+      // The low bit of the first byte tells keyframes from delta frames
+      if (frame[0] & 1)
+        result->keyframes++;
+      else
+        result->deltas++;
+      result->frame_bytes += len;
+
+      if (gpio_telemetry_decode(&dec, frame, len, &used) != ESP_OK ||
+          used != len)
+        err = ESP_FAIL;
+    }
+
+    result->naive_bytes +=
+        GPIO_SIM_BENCH_TELEMETRY_PINS * GPIO_SIM_BENCH_NAIVE_RECORD;
+    if (dec.levels != levels)
+      result->mismatches++;
+    if (dec_events.synced && dec_events.levels != levels)
+      result->event_mismatches++;
+  }
+
+  if (result->frame_bytes)
+    result->ratio = (double)result->naive_bytes / result->frame_bytes;
+
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+esp_err_t gpio_sim_bench_filter(uint32_t updates, uint32_t noise_width,
+                                uint32_t noise_period,
+                                gpio_sim_filter_bench_t *result)
+{
+  if (result == NULL || updates == 0 || noise_width == 0 ||
+      noise_period <= noise_width)
+    return ESP_ERR_INVALID_ARG;
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+
+  const uint64_t update_cycles =
+      (uint64_t)GPIO_SIM_BENCH_FILTER_PERIOD_US * GPIO_SIM_BENCH_CPU_MHZ;
+  const uint64_t run_cycles = (update_cycles + noise_period) * (updates + 1);
+  esp_err_t err = ESP_OK;
+  uint64_t pin_mask = 0;
+
+  for (int i = 0; i < GPIO_SIM_BENCH_TELEMETRY_PINS && err == ESP_OK; i++)
+  {
+    gpio_pinout_t pin = gpio_sim_bench_pins[i];
+    gpio_sim_set_input(pin, 0);
+    if (gpio_set_config_input_nolog(pin, NULL, NULL) != ESP_OK)
+      err = ESP_FAIL;
+    pin_mask |= 1ULL << pin;
+
+    // Periods a few cycles apart, so the spikes of the pins drift apart
+    uint32_t period = noise_period + 7 * i;
+    if (err == ESP_OK)
+      err = gpio_sim_fault_glitch(pin, noise_period / 8 * i, noise_width,
+                                  period, (uint32_t)(run_cycles / period) + 1);
+  }
+
+  gpio_filter_t filter;
+  if (err != ESP_OK ||
+      gpio_filter_init(&filter, pin_mask, GPIO_SIM_BENCH_FILTER_SAMPLES,
+                       GPIO_SIM_BENCH_FILTER_HYSTERESIS, 2 * noise_width,
+                       GPIO_SIM_BENCH_FILTER_DEBOUNCE) != ESP_OK)
+  {
+    gpio_sim_fault_clear();
+    gpio_sim_bench_reset();
+    return ESP_FAIL;
+  }
+
+  *result = (gpio_sim_filter_bench_t){0};
+  uint32_t held[GPIO_SIM_BENCH_TELEMETRY_PINS] = {0};
+  uint64_t read_cycles = 0;
+  uint64_t filter_cycles = 0;
+  uint64_t levels = 0;
+  uint64_t raw_last = 0;
+  uint32_t lcg = 1;
+
+  for (uint32_t i = 0; i < updates; i++)
+  {
+    lcg = lcg * 1664525 + 1013904223;
+    if (i > 0 && (lcg >> 8) % 1000 < GPIO_SIM_BENCH_FILTER_CHANGES)
+    {
+      int index = (lcg >> 20) % GPIO_SIM_BENCH_TELEMETRY_PINS;
+      gpio_pinout_t pin = gpio_sim_bench_pins[index];
+      levels ^= 1ULL << pin;
+      gpio_sim_set_input(pin, (levels >> pin) & 1);
+      held[index] = 0;
+      result->edges++;
+    }
+    uint64_t start = gpio_sim_now();
+
+    uint64_t raw = gpio_read_mask(pin_mask);
+    read_cycles += gpio_sim_now() - start;
+    result->raw_errors += __builtin_popcountll(raw ^ levels);
+    if (i > 0)
+      result->raw_edges += __builtin_popcountll(raw ^ raw_last);
+    raw_last = raw;
+
+    uint64_t before = gpio_sim_now();
+    gpio_filter_sample(&filter);
+    filter_cycles += gpio_sim_now() - before;
+    result->filtered_edges += __builtin_popcountll(filter.changed);
+
+    for (int p = 0; p < GPIO_SIM_BENCH_TELEMETRY_PINS; p++)
+    {
+      uint64_t bit = 1ULL << gpio_sim_bench_pins[p];
+      if (held[p]++ >= GPIO_SIM_BENCH_FILTER_DEBOUNCE &&
+          ((filter.levels ^ levels) & bit))
+        result->filtered_errors++;
+    }
+
+    // Jitter the updates, so they do not sample the spikes at one phase
+    uint64_t spent = gpio_sim_now() - start;
+    uint64_t jitter = (lcg >> 4) % noise_period;
+    if (spent < update_cycles + jitter)
+      gpio_sim_advance(update_cycles + jitter - spent);
+  }
+
+  result->read_cycles = (double)read_cycles / updates;
+  result->filter_cycles = (double)filter_cycles / updates;
+
+  gpio_sim_fault_clear();
+  gpio_sim_bench_reset();
+
+  return ESP_OK;
+}
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+// Static: the driver registry keeps pointers to the pins and the INT line
+static gpio_sim_expander_t s_bench_model;
+static gpio_expander_t s_bench_expander;
+static gpio_t s_bench_vpins[2 * GPIO_SIM_BENCH_EXPANDER_OUTPUTS];
+
+// One run of gpio_sim_bench_expander(); outputs on pins 0-7, inputs on 8-15
+static esp_err_t gpio_sim_bench_expander_run(uint32_t rounds, bool batched,
+                                             double *us, double *txn,
+                                             uint32_t *mismatches)
+{
+  gpio_sim_bench_reset();
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(0);
+  gpio_drv_vport_reset();
+
+  gpio_num_t int_pin = batched ? (gpio_num_t)GPIO_SIM_BENCH_IRQ_PIN
+                               : GPIO_NUM_NC;
+  gpio_expander_config_t config = {
+      .type = GPIO_EXPANDER_MCP23017,
+      .addr = GPIO_SIM_BENCH_EXPANDER_ADDR,
+      .bus = &gpio_sim_expander_bus,
+      .bus_ctx = &s_bench_model,
+      .int_pin = batched ? GPIO_SIM_BENCH_IRQ_PIN : DISABLE,
+  };
+  if (gpio_sim_expander_init(&s_bench_model, GPIO_EXPANDER_MCP23017,
+                             GPIO_SIM_BENCH_EXPANDER_ADDR, int_pin) != ESP_OK ||
+      gpio_expander_init(&s_bench_expander, &config) != ESP_OK)
+    return ESP_FAIL;
+
+  const uint32_t outputs = GPIO_SIM_BENCH_EXPANDER_OUTPUTS;
+  for (uint32_t i = 0; i < 2 * outputs; i++)
+  {
+    s_bench_vpins[i] = (gpio_t){
+        .pin = GPIO_EXPANDER_PIN(&s_bench_expander, i),
+        ._mode = i < outputs ? GPIO_MODE_OUTPUT : GPIO_MODE_INPUT,
+    };
+    if (gpio_init_impl_nolog(&s_bench_vpins[i]) != ESP_OK)
+      return ESP_FAIL;
+  }
+
+  uint16_t inputs = 0;
+  gpio_sim_expander_set_inputs(&s_bench_model, inputs);
+  gpio_sim_expander_stats_t start = s_bench_model.stats;
+  uint32_t lcg = 1;
+
+  for (uint32_t r = 0; r < rounds; r++)
+  {
+    lcg = lcg * 1664525 + 1013904223;
+    uint8_t pattern = (uint8_t)(lcg >> 24);
+
+    for (uint32_t i = 0; i < outputs; i++)
+    {
+      gpio_write(&s_bench_vpins[i], (pattern >> i) & 1);
+      if (!batched)
+        gpio_vport_flush(&s_bench_expander.port);
+    }
+    if (batched)
+      gpio_vport_flush(&s_bench_expander.port);
+
+    if ((uint8_t)gpio_sim_expander_get_outputs(&s_bench_model) != pattern)
+      (*mismatches)++;
+
+    if ((lcg >> 8) % 4 == 0)
+    {
+      inputs ^= 1 << (outputs + (lcg >> 12) % outputs);
+      gpio_sim_expander_set_inputs(&s_bench_model, inputs);
+    }
+
+    for (uint32_t i = outputs; i < 2 * outputs; i++)
+    {
+      if (gpio_read(&s_bench_vpins[i]) != ((inputs >> i) & 1))
+        (*mismatches)++;
+    }
+  }
+
+  gpio_sim_expander_stats_t *end = &s_bench_model.stats;
+  *us = (end->bus_ns - start.bus_ns) / 1000.0 / rounds;
+  *txn = (double)(end->writes - start.writes + end->reads - start.reads) /
+         rounds;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_bench_expander(uint32_t rounds,
+                                  gpio_sim_expander_bench_t *result)
+{
+  if (result == NULL || rounds == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_expander_bench_t){0};
+
+  esp_err_t err = gpio_sim_bench_expander_run(rounds, false,
+                                              &result->immediate_us,
+                                              &result->immediate_txn,
+                                              &result->mismatches);
+  if (err == ESP_OK)
+    err = gpio_sim_bench_expander_run(rounds, true, &result->batched_us,
+                                      &result->batched_txn,
+                                      &result->mismatches);
+
+  gpio_drv_vport_reset();
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+// Lanes 0-3 are 74HC595 chains sharing a clock and a latch, 4 a 74HC165
+static const gpio_pinout_t s_shiftreg_data[GPIO_SIM_BENCH_SHIFTREG_LANES] = {
+    D21, D22, D23, D25,
+};
+static gpio_sim_shiftreg_t s_bench_models[GPIO_SIM_BENCH_SHIFTREG_LANES + 1];
+static gpio_shiftreg_t s_bench_chains[GPIO_SIM_BENCH_SHIFTREG_LANES + 1];
+
+static uint64_t gpio_sim_bench_next_word(uint64_t *lcg, uint8_t bits)
+{
+  *lcg = *lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+  return bits == 64 ? *lcg : *lcg & ((1ULL << bits) - 1);
+}
+
+static void gpio_sim_bench_set_chain(gpio_shiftreg_t *chain, uint64_t word)
+{
+  for (uint32_t bit = 0; bit < chain->config.length; bit++)
+    gpio_write_h(chain->port.base + bit, (word >> bit) & 1);
+}
+
+// Forget the previous chains so each phase has every virtual pin
+static void gpio_sim_bench_shiftreg_clear(void)
+{
+  gpio_sim_shiftreg_detach_all();
+  gpio_drv_shiftreg_reset();
+  gpio_drv_vport_reset();
+}
+
+static esp_err_t gpio_sim_bench_shiftreg_init(uint32_t lane, uint8_t bits)
+{
+  bool out = lane < GPIO_SIM_BENCH_SHIFTREG_LANES;
+  gpio_shiftreg_config_t config = {
+      .type = out ? GPIO_SHIFTREG_74HC595 : GPIO_SHIFTREG_74HC165,
+      .data = out ? s_shiftreg_data[lane] : D26,
+      .clock = out ? GPIO_SIM_BENCH_SHIFTREG_CLOCK : D4,
+      .latch = out ? GPIO_SIM_BENCH_SHIFTREG_LATCH : D5,
+      .length = bits,
+  };
+
+  if (gpio_sim_shiftreg_attach(&s_bench_models[lane], config.type,
+                               (gpio_num_t)config.data,
+                               (gpio_num_t)config.clock,
+                               (gpio_num_t)config.latch,
+                               config.length) != ESP_OK ||
+      gpio_shiftreg_init(&s_bench_chains[lane], &config) != ESP_OK)
+    return ESP_FAIL;
+
+  return ESP_OK;
+}
+
+esp_err_t gpio_sim_bench_shiftreg(uint32_t rounds,
+                                  gpio_sim_shiftreg_bench_t *result)
+{
+  if (result == NULL || rounds == 0)
+    return ESP_ERR_INVALID_ARG;
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(0);
+  gpio_sim_bench_shiftreg_clear();
+
+  const uint32_t lanes = GPIO_SIM_BENCH_SHIFTREG_LANES;
+  const uint32_t vpins = CONFIG_GPIO_DRIVERS_VPIN_COUNT;
+  *result = (gpio_sim_shiftreg_bench_t){
+      .chain_bits = vpins < 64 ? vpins : 64,
+      .lane_bits = vpins / lanes < 64 ? vpins / lanes : 64,
+  };
+  const uint8_t bits = result->chain_bits;
+  uint64_t naive = 0, chain = 0, unchanged = 0, serial = 0, lanes_t = 0;
+  uint64_t read = 0;
+  uint64_t lcg = 1;
+  uint64_t start;
+
+  // One chain, alone in its group
+  esp_err_t err = gpio_sim_bench_shiftreg_init(0, bits);
+  gpio_t data = {.pin = s_shiftreg_data[0]};
+  gpio_t clock = {.pin = GPIO_SIM_BENCH_SHIFTREG_CLOCK};
+  gpio_t latch = {.pin = GPIO_SIM_BENCH_SHIFTREG_LATCH};
+
+  for (uint32_t r = 0; r < rounds && err == ESP_OK; r++)
+  {
+    // Per-bit clocking from application code
+    uint64_t word = gpio_sim_bench_next_word(&lcg, bits);
+    start = gpio_sim_now();
+    for (int bit = bits - 1; bit >= 0; bit--)
+    {
+      gpio_write(&data, (word >> bit) & 1);
+      gpio_write(&clock, GPIO_STATE_HIGH);
+      gpio_write(&clock, GPIO_STATE_LOW);
+    }
+    gpio_write(&latch, GPIO_STATE_HIGH);
+    gpio_write(&latch, GPIO_STATE_LOW);
+    naive += gpio_sim_now() - start;
+    if (gpio_sim_shiftreg_get_outputs(&s_bench_models[0]) != word)
+      result->mismatches++;
+
+    // The same update as a chain flush, then a flush with nothing changed
+    word = gpio_sim_bench_next_word(&lcg, bits);
+    gpio_sim_bench_set_chain(&s_bench_chains[0], word);
+    start = gpio_sim_now();
+    gpio_vport_flush(&s_bench_chains[0].port);
+    chain += gpio_sim_now() - start;
+    if (gpio_sim_shiftreg_get_outputs(&s_bench_models[0]) != word)
+      result->mismatches++;
+
+    start = gpio_sim_now();
+    gpio_vport_flush(&s_bench_chains[0].port);
+    unchanged += gpio_sim_now() - start;
+  }
+
+  // A 74HC165 chain of the same length
+  gpio_sim_bench_shiftreg_clear();
+  if (err == ESP_OK)
+    err = gpio_sim_bench_shiftreg_init(lanes, bits);
+
+  for (uint32_t r = 0; r < rounds && err == ESP_OK; r++)
+  {
+    uint64_t word = gpio_sim_bench_next_word(&lcg, bits);
+    gpio_sim_shiftreg_set_inputs(&s_bench_models[lanes], word);
+    start = gpio_sim_now();
+    gpio_vport_refresh(&s_bench_chains[lanes].port);
+    read += gpio_sim_now() - start;
+    if (s_bench_chains[lanes].port.inputs != word)
+      result->mismatches++;
+  }
+
+  // Chains of lane_bits: one alone flushed once per lane, then the lanes
+  // flushed as one group
+  gpio_sim_bench_shiftreg_clear();
+  if (err == ESP_OK)
+    err = gpio_sim_bench_shiftreg_init(0, result->lane_bits);
+
+  for (uint32_t r = 0; r < rounds && err == ESP_OK; r++)
+  {
+    for (uint32_t i = 0; i < lanes; i++)
+    {
+      gpio_sim_bench_set_chain(
+          &s_bench_chains[0],
+          gpio_sim_bench_next_word(&lcg, result->lane_bits));
+      start = gpio_sim_now();
+      gpio_vport_flush(&s_bench_chains[0].port);
+      serial += gpio_sim_now() - start;
+    }
+  }
+
+  for (uint32_t i = 1; i < lanes && err == ESP_OK; i++)
+    err = gpio_sim_bench_shiftreg_init(i, result->lane_bits);
+
+  uint64_t words[GPIO_SIM_BENCH_SHIFTREG_LANES];
+  for (uint32_t r = 0; r < rounds && err == ESP_OK; r++)
+  {
+    for (uint32_t i = 0; i < lanes; i++)
+    {
+      words[i] = gpio_sim_bench_next_word(&lcg, result->lane_bits);
+      gpio_sim_bench_set_chain(&s_bench_chains[i], words[i]);
+    }
+    start = gpio_sim_now();
+    gpio_shiftreg_flush(&s_bench_chains[0]);
+    lanes_t += gpio_sim_now() - start;
+    for (uint32_t i = 0; i < lanes; i++)
+    {
+      if (gpio_sim_shiftreg_get_outputs(&s_bench_models[i]) != words[i])
+        result->mismatches++;
+    }
+  }
+
+  double per_round = (double)GPIO_SIM_BENCH_CPU_MHZ * rounds;
+  result->naive_us = naive / per_round;
+  result->chain_us = chain / per_round;
+  result->unchanged_us = unchanged / per_round;
+  result->read_us = read / per_round;
+  result->serial_us = serial / per_round;
+  result->lanes_us = lanes_t / per_round;
+
+  gpio_sim_bench_shiftreg_clear();
+  gpio_sim_bench_reset();
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_expander(uint32_t rounds,
+                                  gpio_sim_expander_bench_t *result)
+{
+  (void)rounds;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t gpio_sim_bench_shiftreg(uint32_t rounds,
+                                  gpio_sim_shiftreg_bench_t *result)
+{
+  (void)rounds;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
@@ -0,0 +1,354 @@
+/**
+ * @file gpio_sim_bench_time.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Benchmarks of the timing modules on the host simulator.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "gpio_debounce.h"
+#include "gpio_drivers.h"
+#include "gpio_drivers_ll.h"
+#include "gpio_drivers_priv.h"
+#include "gpio_pps.h"
+#include "gpio_sim.h"
+#include "gpio_sim_bench.h"
+#include "gpio_timestamp.h"
+
+#define GPIO_SIM_BENCH_TS_CALLS 1000
+#define GPIO_SIM_BENCH_TS_MAX_GAP 480
+#define GPIO_SIM_BENCH_DEBOUNCE_MIN_US 100
+#define GPIO_SIM_BENCH_DEBOUNCE_MAX_US 20000
+#define GPIO_SIM_BENCH_DEBOUNCE_HOLD_US 30000
+#define GPIO_SIM_BENCH_DEBOUNCE_MAX_EDGES 9
+
+esp_err_t gpio_sim_bench_pps(uint32_t seconds, double drift_ppb,
+                             double wander_ppb, uint32_t jitter_ns,
+                             gpio_sim_pps_bench_t *result)
+{
+  if (result == NULL || seconds < 4)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_pps_bench_t){0};
+
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(NULL);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+  gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+
+  gpio_sim_pps_t pps;
+  esp_err_t err = gpio_sim_pps_start(&pps, GPIO_SIM_BENCH_IRQ_PIN, drift_ppb,
+                                     wander_ppb, jitter_ns);
+  if (err == ESP_OK)
+    err = gpio_pps_init(GPIO_SIM_BENCH_IRQ_PIN, GPIO_INTR_POSEDGE);
+  if (err != ESP_OK)
+    goto exit;
+
+  // Both timescales start at the first pulse: second 0 of gpio_pps, and
+  // the raw esp_timer time
+  gpio_sim_pps_pulse(&pps);
+  double true_start_ns = (double)pps.second * 1e9;
+  int64_t raw_start_us = GPIO_DRV_TIME_US();
+  double raw_true_ns = gpio_sim_pps_true_ns(&pps, (double)raw_start_us *
+                                                      GPIO_SIM_BENCH_CPU_MHZ);
+
+  for (uint32_t s = 1; s < seconds; s++)
+  {
+    if (s == seconds / 4)
+    {
+      gpio_sim_advance(GPIO_SIM_BENCH_CPU_MHZ * 300000);
+      gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 1);
+      gpio_sim_set_input(GPIO_SIM_BENCH_IRQ_PIN, 0);
+    }
+    gpio_sim_pps_pulse(&pps);
+
+    uint64_t now = gpio_sim_now();
+    double half = (pps.boundary - (double)now) +
+                  GPIO_SIM_BENCH_CPU_MHZ * 500000.0;
+    if (half > 0)
+      gpio_sim_advance((uint64_t)half);
+
+    // True time of the microsecond the raw timestamp stands for
+    int64_t time_us = GPIO_DRV_TIME_US();
+    double true_ns =
+        gpio_sim_pps_true_ns(&pps, (double)time_us * GPIO_SIM_BENCH_CPU_MHZ) -
+        true_start_ns;
+
+    int64_t ns;
+    gpio_pps_stats_t stats;
+    if (gpio_pps_to_ns(time_us, &ns) != ESP_OK ||
+        gpio_pps_get_stats(&stats) != ESP_OK)
+      continue;
+
+    if (stats.locked && result->lock_s == 0)
+      result->lock_s = s;
+    if (stats.locked)
+    {
+      double error = (double)ns - true_ns;
+      if (error < 0)
+        error = -error;
+      if (error > result->max_error_ns)
+        result->max_error_ns = error;
+    }
+
+    result->raw_error_ns = (double)(time_us - raw_start_us) * 1000 -
+                           (true_ns + true_start_ns - raw_true_ns);
+    result->estimated_ppb = stats.drift_ppb;
+    result->rejected = stats.rejected;
+  }
+  result->drift_ppb = pps.drift_ppb;
+
+  if (result->lock_s == 0)
+    err = ESP_FAIL;
+
+exit:
+  gpio_sim_bench_reset();
+
+  return err;
+}
+
+#if CONFIG_GPIO_DRIVERS_TIMESTAMP
+typedef struct
+{
+  uint64_t ts;
+  uint32_t raw;
+} gpio_sim_bench_stamp_t;
+
+static void gpio_sim_bench_stamp(void *arg)
+{
+  gpio_sim_bench_stamp_t *stamp = arg;
+
+  stamp->ts = gpio_ts_now();
+  stamp->raw = GPIO_DRV_CYCLES();
+}
+
+esp_err_t gpio_sim_bench_timestamp(uint32_t stamps,
+                                   gpio_sim_timestamp_bench_t *result)
+{
+  if (result == NULL || stamps < 4)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_timestamp_bench_t){0};
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  gpio_sim_bench_reset();
+  gpio_sim_set_cost(&cost);
+  gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+
+  // Core 1 started a while after core 0, and esp_timer before both
+  gpio_sim_set_cycle_offset(GPIO_SIM_CORE_0, 0x00F00000);
+  gpio_sim_set_cycle_offset(GPIO_SIM_CORE_1, 0x9E3779B9);
+  gpio_sim_advance(GPIO_SIM_BENCH_CPU_MHZ * 1000000);
+
+  // The timescale of a previous run steps back to the new clock here
+  gpio_ts_stats_t stats;
+  esp_err_t err = gpio_ts_init();
+  if (err == ESP_OK)
+    err = gpio_ts_get_stats(&stats);
+  if (err != ESP_OK)
+    goto exit;
+  uint32_t steps = stats.steps;
+  uint32_t held = stats.held;
+
+  uint64_t start = gpio_sim_now();
+  for (uint32_t i = 0; i < GPIO_SIM_BENCH_TS_CALLS; i++)
+    (void)gpio_ts_now();
+  result->ts_cycles =
+      (double)(gpio_sim_now() - start) / GPIO_SIM_BENCH_TS_CALLS;
+
+  start = gpio_sim_now();
+  for (uint32_t i = 0; i < GPIO_SIM_BENCH_TS_CALLS; i++)
+    (void)GPIO_DRV_TIME_US();
+  result->timer_cycles =
+      (double)(gpio_sim_now() - start) / GPIO_SIM_BENCH_TS_CALLS;
+
+  gpio_sim_bench_stamp_t prev = {0};
+  gpio_sim_core_t prev_core = GPIO_SIM_CORE_0;
+  uint64_t prev_us = 0;
+  uint32_t lcg = 1;
+
+  for (uint32_t i = 0; i < stamps; i++)
+  {
+    if (i > 0 && i % (stamps / 16) == 0 && (err = gpio_ts_sync()) != ESP_OK)
+      goto exit;
+
+    lcg = lcg * 1664525 + 1013904223;
+    gpio_sim_core_t core = (lcg >> 31) ? GPIO_SIM_CORE_1 : GPIO_SIM_CORE_0;
+    gpio_sim_advance((lcg >> 8) % GPIO_SIM_BENCH_TS_MAX_GAP);
+
+    gpio_sim_bench_stamp_t stamp;
+    err = gpio_sim_run_on_core(core, gpio_sim_bench_stamp, &stamp);
+    if (err != ESP_OK)
+      goto exit;
+
+    // The counter read costs a cycle: the stamp was taken one before now
+    int64_t error = (int64_t)stamp.ts - (int64_t)(gpio_sim_now() - 1);
+    if (error < 0)
+      error = -error;
+    if (error > result->max_error_cycles)
+      result->max_error_cycles = (int32_t)error;
+
+    uint64_t time_us = stamp.ts / GPIO_SIM_BENCH_CPU_MHZ;
+    if (i > 0)
+    {
+      if ((int32_t)(stamp.raw - prev.raw) < 0)
+        result->raw_inversions++;
+      if (stamp.ts < prev.ts)
+        result->ts_inversions++;
+      if (core != prev_core && time_us == prev_us)
+        result->timer_ties++;
+    }
+    prev = stamp;
+    prev_core = core;
+    prev_us = time_us;
+  }
+
+  err = gpio_ts_get_stats(&stats);
+  result->steps = stats.steps - steps;
+  result->held = stats.held - held;
+
+exit:
+  gpio_sim_bench_reset();
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_timestamp(uint32_t stamps,
+                                   gpio_sim_timestamp_bench_t *result)
+{
+  (void)stamps;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
+
+#if CONFIG_GPIO_DRIVERS_DEBOUNCE
+static void gpio_sim_bench_debounce_isr(void *arg)
+{
+  (*(uint32_t *)arg)++;
+}
+
+// Settle the pin at level after a burst of up to bounce_us, then hold it
+static void gpio_sim_bench_bounce(gpio_num_t pin, uint32_t level,
+                                  uint32_t bounce_us, uint32_t *lcg)
+{
+  *lcg = *lcg * 1664525 + 1013904223;
+  uint32_t edges = 1 + 2 * ((*lcg >> 24) % (GPIO_SIM_BENCH_DEBOUNCE_MAX_EDGES /
+                                            2 + 1));
+  uint32_t gap_us = edges > 1 ? bounce_us / (edges - 1) : 0;
+
+  for (uint32_t i = 0; i < edges; i++)
+  {
+    if (i > 0)
+    {
+      // Gaps of 50% to 100% of the even split
+      *lcg = *lcg * 1664525 + 1013904223;
+      uint64_t gap = (uint64_t)gap_us * GPIO_SIM_BENCH_CPU_MHZ;
+      gpio_sim_advance(gap / 2 + ((*lcg >> 8) % (gap / 2 + 1)) + 1);
+    }
+    gpio_sim_set_input(pin, (i & 1) ? !level : level);
+  }
+  gpio_sim_advance((uint64_t)GPIO_SIM_BENCH_DEBOUNCE_HOLD_US *
+                   GPIO_SIM_BENCH_CPU_MHZ);
+}
+
+// Press and release the switch, the handler counting its calls in handled;
+// first_half gets the count at half the presses
+static void gpio_sim_bench_presses(gpio_t *input, uint32_t presses,
+                                   uint32_t bounce_us, uint32_t wear_us,
+                                   uint32_t *handled, uint32_t *first_half)
+{
+  uint32_t lcg = 1;
+
+  *handled = 0;
+  for (uint32_t i = 0; i < presses; i++)
+  {
+    if (i == presses / 2)
+      *first_half = *handled;
+
+    uint32_t bounce =
+        bounce_us + (uint32_t)((uint64_t)wear_us * i / presses);
+    gpio_sim_bench_bounce(input->pin, 0, bounce, &lcg);
+    gpio_sim_bench_bounce(input->pin, 1, bounce, &lcg);
+  }
+}
+
+esp_err_t gpio_sim_bench_debounce(uint32_t presses, uint32_t bounce_us,
+                                  uint32_t wear_us,
+                                  gpio_sim_debounce_bench_t *result)
+{
+  if (result == NULL || presses < 2 ||
+      bounce_us + wear_us >= GPIO_SIM_BENCH_DEBOUNCE_HOLD_US)
+    return ESP_ERR_INVALID_ARG;
+
+  *result = (gpio_sim_debounce_bench_t){.edges = 2 * presses};
+
+  const gpio_sim_cost_t cost = GPIO_SIM_COST_ESP32_DEFAULT;
+  uint32_t handled = 0;
+  uint32_t first_half = 0;
+  gpio_t input = {
+      .pin = GPIO_SIM_BENCH_IRQ_PIN,
+      ._mode = GPIO_MODE_INPUT,
+      .isr_handler = gpio_sim_bench_debounce_isr,
+      .isr_handler_arg = &handled,
+  };
+  esp_err_t err = ESP_OK;
+
+  for (int adaptive = 0; adaptive < 2 && err == ESP_OK; adaptive++)
+  {
+    gpio_sim_bench_reset();
+    gpio_sim_set_cost(&cost);
+    gpio_sim_set_cpu_freq(GPIO_SIM_BENCH_CPU_MHZ);
+    gpio_install_isr_service(GPIO_DRV_ISR_FLAGS);
+    gpio_sim_set_input(input.pin, 1);
+
+    err = gpio_init_impl_nolog(&input);
+    if (err == ESP_OK)
+      err = gpio_set_edge(&input, GPIO_INTR_ANYEDGE);
+    if (err == ESP_OK)
+      err = gpio_set_debounce(&input, GPIO_SIM_BENCH_DEBOUNCE_MIN_US,
+                              adaptive ? GPIO_SIM_BENCH_DEBOUNCE_MAX_US
+                                       : GPIO_SIM_BENCH_DEBOUNCE_MIN_US);
+    if (err != ESP_OK)
+      break;
+
+    gpio_sim_bench_presses(&input, presses, bounce_us, wear_us, &handled,
+                           &first_half);
+    if (!adaptive)
+    {
+      result->fixed_handled = handled;
+      continue;
+    }
+
+    result->adaptive_handled = handled;
+    uint32_t late = handled - first_half;
+    uint32_t late_edges = 2 * (presses - presses / 2);
+    result->late_extra = late > late_edges ? late - late_edges : 0;
+
+    gpio_debounce_stats_t stats;
+    err = gpio_get_debounce(input.pin, &stats);
+    result->window_us = stats.window_us;
+    result->percentile_us = stats.percentile_us;
+    result->max_burst_us = stats.max_burst_us;
+  }
+
+  gpio_set_debounce(&input, 0, 0);
+  gpio_sim_bench_reset();
+
+  return err;
+}
+#else
+esp_err_t gpio_sim_bench_debounce(uint32_t presses, uint32_t bounce_us,
+                                  uint32_t wear_us,
+                                  gpio_sim_debounce_bench_t *result)
+{
+  (void)presses;
+  (void)bounce_us;
+  (void)wear_us;
+  (void)result;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
@@ -0,0 +1,181 @@
+/**
+ * @file test_driver.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Host tests of the driver core: races, faults, configuration,
+ * backends, ISR paths and edge latches.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "gpio_sim_bench.h"
+
+TEST_CASE("concurrent writes lose no toggle", "[driver][cores]")
+{
+  gpio_sim_bench_result_t r;
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_concurrent_writes(20000, &r));
+  printf("%llu writes, %.0f writes/s\n", (unsigned long long)r.writes,
+         r.writes_per_sec);
+
+  TEST_ASSERT_GREATER_THAN(0, r.writes);
+  TEST_ASSERT_EQUAL_UINT64(0, r.lost_toggles);
+}
+
+TEST_CASE("faults slow the write hot path through their ISRs",
+          "[driver][fault]")
+{
+  gpio_sim_fault_bench_t r[GPIO_SIM_BENCH_FAULT_MAX];
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_faults(2000, r));
+  for (int i = 0; i < GPIO_SIM_BENCH_FAULT_MAX; i++)
+    printf("fault %d: %.1f cycles/write, %llu ISRs\n", i,
+           r[i].cycles_per_write, (unsigned long long)r[i].isrs);
+
+  // A stuck pin raises no interrupt; glitches and storms do, and cost
+  TEST_ASSERT_EQUAL_UINT64(0, r[GPIO_SIM_BENCH_FAULT_NONE].isrs);
+  TEST_ASSERT_EQUAL_UINT64(0, r[GPIO_SIM_BENCH_FAULT_STUCK].isrs);
+  TEST_ASSERT_GREATER_THAN(0, r[GPIO_SIM_BENCH_FAULT_GLITCH].isrs);
+  TEST_ASSERT_GREATER_THAN(0, r[GPIO_SIM_BENCH_FAULT_STORM].isrs);
+  TEST_ASSERT_TRUE(r[GPIO_SIM_BENCH_FAULT_STORM].cycles_per_write >
+                   r[GPIO_SIM_BENCH_FAULT_NONE].cycles_per_write);
+}
+
+TEST_CASE("_nolog configuration calls cost no more than logging ones",
+          "[driver][config]")
+{
+  gpio_sim_config_bench_t r[GPIO_SIM_BENCH_CONFIG_MAX];
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_config(200, r));
+  for (int i = 0; i < GPIO_SIM_BENCH_CONFIG_MAX; i++)
+  {
+    printf("config %d: %.1f cycles, %.0f ns\n", i, r[i].cycles_per_call,
+           r[i].ns_per_call);
+    TEST_ASSERT_TRUE(r[i].cycles_per_call > 0);
+  }
+
+  TEST_ASSERT_TRUE(r[GPIO_SIM_BENCH_CONFIG_OUTPUT_NOLOG].cycles_per_call <=
+                   r[GPIO_SIM_BENCH_CONFIG_OUTPUT].cycles_per_call);
+  TEST_ASSERT_TRUE(r[GPIO_SIM_BENCH_CONFIG_INPUT_NOLOG].cycles_per_call <=
+                   r[GPIO_SIM_BENCH_CONFIG_INPUT].cycles_per_call);
+}
+
+TEST_CASE("pin handle calls reach the native backend", "[driver][backend]")
+{
+  gpio_sim_backend_bench_t r;
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_backend(100000, &r));
+  printf("%u backends: write %.1f ns, dispatch %.1f ns\n",
+         (unsigned)r.backends, r.write_ns, r.dispatch_ns);
+
+  TEST_ASSERT_GREATER_OR_EQUAL(1, r.backends);
+  TEST_ASSERT_TRUE(r.write_ns > 0 && r.read_ns > 0 && r.toggle_ns > 0);
+}
+
+TEST_CASE("fast ISR trampolines run every handler sooner",
+          "[driver][isr]")
+{
+  gpio_sim_fast_isr_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_fast_isr(1000, &r);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_FAST_ISR is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("service %.1f cycles, trampoline %.1f cycles\n", r.service_cycles,
+         r.fast_cycles);
+
+  TEST_ASSERT_EQUAL_UINT32(0, r.missed);
+  TEST_ASSERT_TRUE(r.fast_cycles < r.service_cycles);
+}
+
+TEST_CASE("the status latch catches pulses a level poll misses",
+          "[driver][latch]")
+{
+  const uint32_t pulses = 1000;
+  gpio_sim_latch_bench_t r;
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_latch(pulses, &r));
+  printf("ISR %.1f cycles/pulse, poll %.1f cycles\n", r.isr_cycles,
+         r.poll_cycles);
+
+  TEST_ASSERT_EQUAL_UINT32(pulses, r.isr_seen);
+  TEST_ASSERT_EQUAL_UINT32(0, r.level_seen);
+  TEST_ASSERT_EQUAL_UINT32(pulses, r.latched);
+}
+
+TEST_CASE("the driver does not allocate once running", "[driver][heap]")
+{
+  uint64_t allocs = 0;
+
+  esp_err_t err = gpio_sim_bench_allocs(1000, &allocs);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_SIM_COUNT_ALLOCS is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+
+  TEST_ASSERT_EQUAL_UINT64(0, allocs);
+}
+
+TEST_CASE("a snapshot restore is cheaper than a cold init",
+          "[driver][sleep]")
+{
+  gpio_sim_restore_bench_t r;
+
+  // Twice: the driver must set its ISR service up again after a reset
+  for (int i = 0; i < 2; i++)
+  {
+    TEST_ASSERT_EQUAL(ESP_OK,
+                      gpio_sim_bench_restore(GPIO_SIM_BENCH_PINS, &r));
+    printf("cold %llu cycles, %u configs; restore %llu cycles, %u configs\n",
+           (unsigned long long)r.cold_cycles, (unsigned)r.cold_configs,
+           (unsigned long long)r.restore_cycles, (unsigned)r.restore_configs);
+
+    TEST_ASSERT_LESS_THAN_UINT32(r.cold_configs, r.restore_configs);
+    TEST_ASSERT_TRUE(r.restore_cycles < r.cold_cycles);
+  }
+}
+
+TEST_CASE("the edge check counts the interrupts merged edges lose",
+          "[driver][edge_check]")
+{
+  static const gpio_int_type_t types[] = {GPIO_INTR_ANYEDGE,
+                                          GPIO_INTR_NEGEDGE,
+                                          GPIO_INTR_POSEDGE};
+  const uint32_t edges = 2000;
+  gpio_sim_edge_check_bench_t r;
+
+  for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+  {
+    esp_err_t err = gpio_sim_bench_edge_check(edges, 10000, types[i], &r);
+    if (err == ESP_ERR_NOT_SUPPORTED)
+      TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled");
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+
+    // Slow edges: every one handled, none reported lost or early
+    TEST_ASSERT_EQUAL_UINT32(r.raising, r.handled);
+    TEST_ASSERT_EQUAL_UINT32(0, r.levels.lost);
+    TEST_ASSERT_EQUAL_UINT32(0, r.check.lost);
+    TEST_ASSERT_EQUAL_UINT32(0, r.check.early);
+
+    // Edges faster than the ISR: with the period, every lost one is counted,
+    // plus the tail after the storm stopped
+    TEST_ASSERT_EQUAL(ESP_OK,
+                      gpio_sim_bench_edge_check(edges, 4000000, types[i], &r));
+    printf("type %d, %u edges: %u handled, lost %u (levels %u), early %u\n",
+           (int)types[i], (unsigned)r.raising, (unsigned)r.handled,
+           (unsigned)r.check.lost, (unsigned)r.levels.lost,
+           (unsigned)r.check.early);
+    TEST_ASSERT_LESS_THAN_UINT32(r.raising, r.handled);
+    TEST_ASSERT_UINT32_WITHIN(1, r.raising + r.tail, r.handled + r.check.lost);
+    TEST_ASSERT_EQUAL_UINT32(0, r.check.early);
+
+    // Without it, the levels give a lower bound on any edge, nothing else
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(r.raising - r.handled, r.levels.lost);
+    if (types[i] != GPIO_INTR_ANYEDGE)
+      TEST_ASSERT_EQUAL_UINT32(0, r.levels.lost);
+  }
+}
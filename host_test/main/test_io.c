@@ -0,0 +1,122 @@
+/**
+ * @file test_io.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Host tests of the logging, telemetry, filtering and I/O expansion
+ * modules.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "gpio_sim_bench.h"
+
+#define TEST_IO_EVLOG_PATH "gpio_evlog_test.bin"
+
+TEST_CASE("the event log stores every edge and wears evenly", "[io][evlog]")
+{
+  const uint32_t sectors = 4;
+  const uint32_t edges = 20000;
+  gpio_sim_evlog_bench_t r;
+
+  // About 15 pages: the log wraps the partition three times
+  esp_err_t err =
+      gpio_sim_bench_evlog(TEST_IO_EVLOG_PATH, sectors, edges, 1000, &r);
+  remove(TEST_IO_EVLOG_PATH);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_EVLOG is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("%.2f B/event, %.0f events/s, %u pages, erases %u..%u, "
+         "%u read back\n",
+         r.bytes_per_event, r.events_per_s, (unsigned)r.pages,
+         (unsigned)r.min_sector_erases, (unsigned)r.max_sector_erases,
+         (unsigned)r.stored);
+
+  TEST_ASSERT_EQUAL_UINT32(edges, r.events);
+  TEST_ASSERT_EQUAL_UINT32(0, r.dropped);
+  TEST_ASSERT_TRUE(r.bytes_per_event <= 4.0);
+
+  // Every sector erased at least twice, none more than once ahead
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * sectors, r.pages);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, r.min_sector_erases);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(r.min_sector_erases + 1,
+                                   r.max_sector_erases);
+
+  // The pages kept read back in order across the wrap point
+  TEST_ASSERT_GREATER_THAN(edges / r.pages * (sectors - 1), r.stored);
+  TEST_ASSERT_EQUAL_UINT32(0, r.mismatches);
+}
+
+TEST_CASE("telemetry frames decode to the sampled levels",
+          "[io][telemetry]")
+{
+  static const uint32_t changes[] = {0, 10, 100, 1000};
+  gpio_sim_telemetry_bench_t r;
+
+  for (size_t i = 0; i < sizeof(changes) / sizeof(changes[0]); i++)
+  {
+    TEST_ASSERT_EQUAL(ESP_OK,
+                      gpio_sim_bench_telemetry(20000, 1000, changes[i], &r));
+    printf("%u changes/1000: %llu frame bytes, ratio %.1f\n",
+           (unsigned)changes[i], (unsigned long long)r.frame_bytes, r.ratio);
+
+    TEST_ASSERT_EQUAL_UINT32(0, r.mismatches);
+    // Half the inputs start high, which no edge event tells
+    TEST_ASSERT_EQUAL_UINT32(0, r.event_mismatches);
+    TEST_ASSERT_TRUE(r.frame_bytes < r.naive_bytes);
+  }
+}
+
+TEST_CASE("the filter rejects spikes single reads let through",
+          "[io][filter]")
+{
+  gpio_sim_filter_bench_t r;
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_filter(5000, 60, 1000, &r));
+  printf("%u edges: raw %u (%u errors), filtered %u (%u errors)\n",
+         (unsigned)r.edges, (unsigned)r.raw_edges, (unsigned)r.raw_errors,
+         (unsigned)r.filtered_edges, (unsigned)r.filtered_errors);
+
+  TEST_ASSERT_EQUAL_UINT32(0, r.filtered_errors);
+  TEST_ASSERT_GREATER_THAN(0, r.raw_errors);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(r.edges, r.filtered_edges);
+}
+
+TEST_CASE("batched expander access takes fewer bus transactions",
+          "[io][vpins]")
+{
+  gpio_sim_expander_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_expander(2000, &r);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_VPINS is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("immediate %.1f us, batched %.1f us\n", r.immediate_us,
+         r.batched_us);
+
+  TEST_ASSERT_EQUAL_UINT32(0, r.mismatches);
+  TEST_ASSERT_TRUE(r.batched_txn < r.immediate_txn);
+  TEST_ASSERT_TRUE(r.batched_us < r.immediate_us);
+}
+
+TEST_CASE("shift register lanes flush faster than single chains",
+          "[io][vpins]")
+{
+  gpio_sim_shiftreg_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_shiftreg(200, &r);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_VPINS is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("naive %.2f us, chain %.2f us, serial %.2f us, lanes %.2f us\n",
+         r.naive_us, r.chain_us, r.serial_us, r.lanes_us);
+
+  TEST_ASSERT_EQUAL_UINT32(0, r.mismatches);
+  TEST_ASSERT_TRUE(r.chain_us < r.naive_us);
+  TEST_ASSERT_TRUE(r.lanes_us < r.serial_us);
+  TEST_ASSERT_TRUE(r.unchanged_us == 0.0);
+}
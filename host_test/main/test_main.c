@@ -0,0 +1,20 @@
+/**
+ * @file test_main.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Entry point of the host test app: runs every test case.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdlib.h>
+#include <unity.h>
+
+void app_main(void)
+{
+  UNITY_BEGIN();
+  unity_run_all_tests();
+  exit(UNITY_END());
+}
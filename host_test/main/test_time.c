@@ -0,0 +1,71 @@
+/**
+ * @file test_time.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Host tests of the timing modules: PPS discipline, cross-core
+ * timestamps and debounce.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "gpio_sim_bench.h"
+
+TEST_CASE("the PPS loop locks and tracks the drift", "[time][pps]")
+{
+  gpio_sim_pps_bench_t r;
+
+  TEST_ASSERT_EQUAL(ESP_OK, gpio_sim_bench_pps(120, 20000, 0, 50, &r));
+  printf("drift %.0f ppb, tracked %d ppb, raw %.0f ns, max %.1f ns\n",
+         r.drift_ppb, (int)r.estimated_ppb, r.raw_error_ns, r.max_error_ns);
+
+  TEST_ASSERT_GREATER_THAN(0, r.lock_s);
+  TEST_ASSERT_LESS_THAN_UINT32(120, r.lock_s);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, r.rejected);
+  TEST_ASSERT_INT32_WITHIN(100, (int32_t)r.drift_ppb, r.estimated_ppb);
+  TEST_ASSERT_TRUE(r.max_error_ns < 1000.0);
+}
+
+TEST_CASE("cross-core timestamps keep one timescale in order",
+          "[time][timestamp]")
+{
+  gpio_sim_timestamp_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_timestamp(100000, &r);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_TIMESTAMP is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("inversions: raw %u, gpio_ts_now %u (%u held, max error %d "
+         "cycles)\n",
+         (unsigned)r.raw_inversions, (unsigned)r.ts_inversions,
+         (unsigned)r.held, (int)r.max_error_cycles);
+
+  TEST_ASSERT_EQUAL_UINT32(0, r.steps);
+  TEST_ASSERT_TRUE(r.ts_cycles < r.timer_cycles);
+  TEST_ASSERT_GREATER_THAN(0, r.raw_inversions);
+  TEST_ASSERT_EQUAL_UINT32(0, r.ts_inversions);
+  TEST_ASSERT_LESS_THAN(16, r.max_error_cycles);
+}
+
+TEST_CASE("a learned debounce window follows worn contacts",
+          "[time][debounce]")
+{
+  gpio_sim_debounce_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_debounce(400, 500, 4000, &r);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+    TEST_IGNORE_MESSAGE("CONFIG_GPIO_DRIVERS_DEBOUNCE is disabled");
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("%u edges: fixed %u calls, learned %u calls, window %u us\n",
+         (unsigned)r.edges, (unsigned)r.fixed_handled,
+         (unsigned)r.adaptive_handled, (unsigned)r.window_us);
+
+  TEST_ASSERT_LESS_THAN_UINT32(r.fixed_handled, r.adaptive_handled);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(r.edges, r.adaptive_handled);
+  TEST_ASSERT_EQUAL_UINT32(0, r.late_extra);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(r.max_burst_us, r.window_us);
+}
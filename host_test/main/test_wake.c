@@ -0,0 +1,99 @@
+/**
+ * @file test_wake.c
+ * @author Marcos Henrique Silveira Barbosa
+ * @brief Host tests of the light-sleep wake-ups and the deep-sleep wake
+ * conditions.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "gpio_sim_bench.h"
+#include "gpio_wake.h"
+
+#define TEST_WAKE_WAVE_PATH "gpio_wake_test.txt"
+
+// Spread the 4 bits of a test value over pins of both banks
+static uint64_t test_wake_pins(uint32_t bits)
+{
+  static const int pins[] = {D4, D15, D32, D33};
+  uint64_t mask = 0;
+
+  for (int i = 0; i < 4; i++)
+  {
+    if ((bits >> i) & 1)
+      mask |= 1ULL << pins[i];
+  }
+
+  return mask;
+}
+
+static bool test_wake_ext1_holds(gpio_wake_ext1_t ext1, uint64_t inputs)
+{
+  return ext1.any_high ? (inputs & ext1.pin_mask) != 0
+                       : (inputs & ext1.pin_mask) == 0;
+}
+
+TEST_CASE("the deep-sleep wake condition is false now and needed to match",
+          "[wake]")
+{
+  for (uint32_t mask = 1; mask < 16; mask++)
+  {
+    for (uint32_t levels = 0; levels < 16; levels++)
+    {
+      if (levels & ~mask)
+        continue;
+
+      gpio_wake_pattern_t pattern = {
+          .pin_mask = test_wake_pins(mask),
+          .levels = test_wake_pins(levels),
+      };
+
+      for (uint32_t now = 0; now < 16; now++)
+      {
+        uint64_t inputs = test_wake_pins(now);
+        if (gpio_wake_pattern_match(&pattern, inputs))
+          continue;
+
+        gpio_wake_ext1_t ext1 = gpio_wake_ext1_next(&pattern, inputs);
+
+        // Re-arming on a condition that holds would wake the chip at once
+        TEST_ASSERT_TRUE(ext1.pin_mask != 0);
+        TEST_ASSERT_EQUAL_UINT64(0, ext1.pin_mask & ~pattern.pin_mask);
+        TEST_ASSERT_TRUE(!test_wake_ext1_holds(ext1, inputs));
+
+        // No input matching the pattern can be slept through
+        for (uint32_t then = 0; then < 16; then++)
+        {
+          uint64_t later = test_wake_pins(then);
+          if (gpio_wake_pattern_match(&pattern, later))
+            TEST_ASSERT_TRUE(test_wake_ext1_holds(ext1, later));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("light sleep masks the handlers of the pattern inputs until it "
+          "matches", "[wake]")
+{
+  gpio_sim_wake_bench_t r;
+
+  esp_err_t err = gpio_sim_bench_wake(TEST_WAKE_WAVE_PATH, &r);
+  remove(TEST_WAKE_WAVE_PATH);
+  TEST_ASSERT_EQUAL(ESP_OK, err);
+  printf("%u rejected, %u ISRs asleep, %u awake\n", (unsigned)r.rejected,
+         (unsigned)r.asleep_isrs, (unsigned)r.awake_isrs);
+
+  TEST_ASSERT_TRUE(r.done);
+  TEST_ASSERT_EQUAL_UINT32(3, r.rejected);
+  // Armed on its level type, an unmasked handler would run over and over
+  TEST_ASSERT_EQUAL_UINT32(0, r.asleep_isrs);
+  // Then its own type is back, unmasked: once on the falling edge only
+  TEST_ASSERT_EQUAL_UINT32(1, r.awake_isrs);
+}
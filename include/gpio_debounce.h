@@ -0,0 +1,92 @@
+/**
+ * @file gpio_debounce.h
+ * @brief Debounce windows learned from the bounce of each input.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A contact bounces for a while after it closes or opens: an input sees a
+ * burst of edges instead of one. With CONFIG_GPIO_DRIVERS_DEBOUNCE, the
+ * driver ISR dispatch passes the first edge of a burst to the ISR handler
+ * of the pin and drops the edges within the debounce window after it,
+ * counting them in gpio_metrics_t::debounced.
+ *
+ * A fixed window is either long, and merges fast legitimate edges, or
+ * short, and lets the chatter of a worn contact through. gpio_set_debounce()
+ * instead learns it per pin from the edge timestamps (gpio_ts_now()):
+ *
+ * - a burst runs from an edge after at least max_us of quiet to the last
+ *   edge before the next such quiet period;
+ * - each burst duration updates a running estimate of a high percentile
+ *   (CONFIG_GPIO_DRIVERS_DEBOUNCE_PERCENTILE) of the durations, with a
+ *   step that scales with the estimate, so it adapts as the contact ages;
+ * - the window is the estimate plus 25%, within [min_us, max_us].
+ *
+ * gpio_get_debounce() reports the learned values, e.g. for the telemetry:
+ * a window creeping up towards max_us flags a switch wearing out before it
+ * fails.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_DEBOUNCE_H
+#define GPIO_DEBOUNCE_H
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Learned debounce of one input.
+ */
+typedef struct
+{
+  uint32_t window_us;     /**< Current debounce window */
+  uint32_t percentile_us; /**< Running percentile of the burst durations */
+  uint32_t last_burst_us; /**< Duration of the last complete burst */
+  uint32_t max_burst_us;  /**< Longest burst seen */
+  uint32_t bursts;        /**< Complete bursts measured */
+  uint32_t debounced;     /**< Edges dropped */
+} gpio_debounce_stats_t;
+
+/**
+ * @brief Debounce the ISR handler of an input.
+ *
+ * The pin must have been set up by gpio_init_impl() with an ISR handler.
+ * Starts learning from scratch, with the window at @p min_us. With
+ * @p min_us equal to @p max_us the window stays fixed; 0 and 0 turn the
+ * debounce off.
+ *
+ * @param self Input to debounce.
+ * @param min_us Shortest window, in microseconds.
+ * @param max_us Longest window, in microseconds; also the quiet time that
+ * ends a burst.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_DEBOUNCE is disabled
+ */
+esp_err_t gpio_set_debounce(gpio_t *self, uint32_t min_us, uint32_t max_us);
+
+/**
+ * @brief Get the learned debounce of an input.
+ *
+ * @param pin GPIO number.
+ * @param stats Where to store the learned values.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** if the pin is not debounced
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_DEBOUNCE is disabled
+ */
+esp_err_t gpio_get_debounce(gpio_pinout_t pin, gpio_debounce_stats_t *stats);
+
+/**
+ * @brief Pins whose window reached their max_us, bit N being GPIO N.
+ *
+ * Their bursts are about as long as the bounds allow: the contact is worn
+ * or the bounds too tight. 0 if CONFIG_GPIO_DRIVERS_DEBOUNCE is disabled.
+ */
+uint64_t gpio_get_debounce_saturated(void);
+
+#endif  // GPIO_DEBOUNCE_H
@@ -15,6 +15,8 @@
 
 #include <driver/gpio.h>
 #include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Enumeration of GPIO pin definitions.
@@ -203,13 +205,306 @@ typedef struct gpio
   esp_err_t (*toggle)(struct gpio *self);
 } gpio_t;
 
+/**
+ * @brief Compact handle of a GPIO object registered by gpio_init_impl().
+ *
+ * One byte instead of a pointer, for queues, tables and event records. The
+ * handle is the index of the object in the pin registry, which is its GPIO
+ * number, so the handle-based functions reach the registers without
+ * dereferencing the object.
+ */
+typedef uint8_t gpio_hdl_t;
+
+/**
+ * @brief Handle of no GPIO object.
+ */
+#define GPIO_HDL_INVALID ((gpio_hdl_t)0xFF)
+
+/**
+ * @brief Inter-bank skew statistics of multi-pin writes.
+ *
+ * Only collected when CONFIG_GPIO_DRIVERS_SKEW_TRACE is enabled.
+ */
+typedef struct
+{
+  uint32_t last;   /**< Skew of the last multi-pin write, in CPU cycles */
+  uint32_t max;    /**< Worst skew seen so far, in CPU cycles */
+  uint32_t writes; /**< Number of multi-pin writes measured */
+} gpio_skew_stats_t;
+
+/**
+ * @brief Operation counters of one pin, summed over both cores.
+ *
+ * Only collected when CONFIG_GPIO_DRIVERS_METRICS is enabled.
+ */
+typedef struct
+{
+  uint32_t writes;     /**< gpio_write calls */
+  uint32_t toggles;    /**< gpio_toggle calls */
+  uint32_t interrupts; /**< Interrupts dispatched to the ISR handler */
+  uint32_t dropped;    /**< Interrupts taken with no ISR handler to run */
+  uint32_t debounced;  /**< Edges discarded by a debounce filter */
+  uint32_t reconfigs;  /**< gpio_set_config_output/input calls */
+} gpio_metrics_t;
+
+/**
+ * @brief Edge sequence check of one input.
+ *
+ * Only collected when CONFIG_GPIO_DRIVERS_EDGE_CHECK is enabled.
+ */
+typedef struct
+{
+  uint32_t interrupts; /**< Interrupts checked */
+  uint32_t lost;       /**< Interrupts missed (a lower bound with no period) */
+  uint32_t early;      /**< Interrupts sooner than the period allows */
+} gpio_edge_check_t;
+
+/**
+ * @brief Statically sized pools of the driver.
+ */
+typedef enum
+{
+  GPIO_POOL_PINS,   /**< gpio_t objects handed out by gpio_alloc() */
+  GPIO_POOL_LOG,    /**< Deferred log ring entries */
+  GPIO_POOL_EVENTS, /**< Edge event ring entries */
+  GPIO_POOL_MAX,
+} gpio_pool_t;
+
+/**
+ * @brief Occupancy of a pool.
+ */
+typedef struct
+{
+  uint32_t capacity;   /**< Entries in the pool, from Kconfig */
+  uint32_t used;       /**< Entries in use */
+  uint32_t high_water; /**< Most entries ever in use at once */
+} gpio_pool_stats_t;
+
+/**
+ * @brief Configure a pin as output.
+ *
+ * @param pin GPIO pin number.
+ * @return
+ * - **ESP_OK** on success
+ */
+esp_err_t gpio_set_config_output(gpio_pinout_t pin);
+
+/**
+ * @brief Configure a pin as input, with pull-up and falling edge interrupt.
+ *
+ * The ISR service must be installed when @p isr_handler is not NULL.
+ *
+ * @param pin GPIO pin number.
+ * @param isr_handler ISR handler function, NULL for none.
+ * @param isr_handler_arg Argument to the ISR handler function.
+ * @return
+ * - **ESP_OK** on success
+ */
+esp_err_t gpio_set_config_input(gpio_pinout_t pin, void isr_handler(void *),
+                                void *isr_handler_arg);
+
+/**
+ * @brief Configure a pin as output, without logging nor aborting on failure.
+ *
+ * Same as gpio_set_config_output(), for reconfiguration in control loops.
+ *
+ * @param pin GPIO pin number.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the pin cannot be an output
+ */
+esp_err_t gpio_set_config_output_nolog(gpio_pinout_t pin);
+
+/**
+ * @brief Configure a pin as input, without logging nor aborting on failure.
+ *
+ * Same as gpio_set_config_input(), for reconfiguration in control loops.
+ *
+ * @param pin GPIO pin number.
+ * @param isr_handler ISR handler function, NULL for none.
+ * @param isr_handler_arg Argument to the ISR handler function.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the pin is invalid
+ * - **ESP_ERR_INVALID_STATE** if the ISR service is not installed
+ */
+esp_err_t gpio_set_config_input_nolog(gpio_pinout_t pin,
+                                      void isr_handler(void *),
+                                      void *isr_handler_arg);
+
+/**
+ * @brief Set the state of the GPIO pin.
+ *
+ * @param self Pointer to the GPIO object.
+ * @param state Desired state of the GPIO pin.
+ * @return
+ * - **ESP_OK** on success
+ */
+esp_err_t gpio_write(gpio_t *self, gpio_state_t state);
+
+/**
+ * @brief Get the current state of the GPIO pin.
+ *
+ * @param self Pointer to the GPIO object.
+ * @return
+ * - Current state of the GPIO pin
+ */
+gpio_state_t gpio_read(gpio_t *self);
+
+/**
+ * @brief Toggle the state of the GPIO pin.
+ *
+ * Safe to call from both cores and from ISRs at once: the read of the output
+ * register and the write back are done in one critical section.
+ *
+ * @param self Pointer to the GPIO object.
+ */
+void gpio_toggle(gpio_t *self);
+
 /**
  * @brief Initialize the GPIO implementation.
  *
+ * Registers the object in the pin registry and installs the ISR service on
+ * first use. Safe to call from both cores.
+ *
  * @param self Pointer to the GPIO object.
  */
 void gpio_init_impl(gpio_t *self);
 
+/**
+ * @brief Initialize the GPIO implementation, without logging nor aborting on
+ * failure.
+ *
+ * Same as gpio_init_impl().
+ *
+ * @param self Pointer to the GPIO object.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the pin or the mode is invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_init_impl_nolog(gpio_t *self);
+
+/**
+ * @brief Set up a GPIO object whose pin is already configured.
+ *
+ * Same as gpio_init_impl_nolog() without touching the pin configuration:
+ * registers the object and adds the ISR handler of an input. Used after
+ * gpio_snapshot_restore() on wake from sleep.
+ *
+ * @param self Pointer to the GPIO object.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the pin or the mode is invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_attach_impl(gpio_t *self);
+
+/**
+ * @brief Hold the pad state of a pin, through resets and sleep, or release it.
+ *
+ * @param self Pointer to the GPIO object.
+ * @param hold true to hold the pin, false to release it.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the pin is invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if the pin cannot be held
+ */
+esp_err_t gpio_set_hold(gpio_t *self, bool hold);
+
+/**
+ * @brief Get the GPIO object registered for a pin by gpio_init_impl().
+ *
+ * @param pin GPIO pin number.
+ * @return
+ * - Pointer to the GPIO object, NULL if none is registered
+ */
+gpio_t *gpio_get_instance(gpio_pinout_t pin);
+
+/**
+ * @brief Get the handle of a GPIO object registered by gpio_init_impl().
+ *
+ * @param self Pointer to the GPIO object.
+ * @return
+ * - Handle of the object, GPIO_HDL_INVALID if it is not registered
+ */
+gpio_hdl_t gpio_get_handle(const gpio_t *self);
+
+/**
+ * @brief Get the GPIO object of a handle.
+ *
+ * @param hdl Handle from gpio_get_handle().
+ * @return
+ * - Pointer to the GPIO object, NULL if the handle is invalid
+ */
+gpio_t *gpio_from_handle(gpio_hdl_t hdl);
+
+/**
+ * @brief Set the state of a GPIO pin from its handle.
+ *
+ * A single store to the pin's set or clear register: cheaper than
+ * gpio_write(), and safe from both cores and from ISRs.
+ *
+ * @param hdl Handle from gpio_get_handle().
+ * @param state Desired state of the GPIO pin.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the handle is invalid
+ */
+esp_err_t gpio_write_h(gpio_hdl_t hdl, gpio_state_t state);
+
+/**
+ * @brief Read the state of a GPIO pin from its handle.
+ *
+ * @param hdl Handle from gpio_get_handle().
+ * @return
+ * - Current state of the GPIO pin, GPIO_STATE_LOW if the handle is invalid
+ */
+gpio_state_t gpio_read_h(gpio_hdl_t hdl);
+
+/**
+ * @brief Toggle the state of a GPIO pin from its handle.
+ *
+ * Same guarantees as gpio_toggle().
+ *
+ * @param hdl Handle from gpio_get_handle().
+ */
+void gpio_toggle_h(gpio_hdl_t hdl);
+
+/**
+ * @brief Take a zeroed GPIO object from the static pin pool.
+ *
+ * The pool holds CONFIG_GPIO_DRIVERS_PIN_POOL_SIZE objects; no heap is used.
+ *
+ * @return
+ * - Pointer to the GPIO object, NULL if the pool is exhausted
+ */
+gpio_t *gpio_alloc(void);
+
+/**
+ * @brief Return a GPIO object to the static pin pool.
+ *
+ * Also removes it from the pin registry. The pin keeps its configuration.
+ *
+ * @param self GPIO object taken with gpio_alloc().
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if @p self does not come from gpio_alloc()
+ */
+esp_err_t gpio_free(gpio_t *self);
+
+/**
+ * @brief Get the occupancy of one of the driver pools.
+ *
+ * @param pool Pool to query.
+ * @param stats Where to store the occupancy.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if the pool is not built in
+ */
+esp_err_t gpio_get_pool_stats(gpio_pool_t pool, gpio_pool_stats_t *stats);
+
 /**
  * @brief Disable the ISR for the specified GPIO.
  *
@@ -224,6 +519,8 @@ esp_err_t gpio_disable_isr(gpio_t *self);
 /**
  * @brief Enable the ISR for the specified GPIO.
  *
+ * Also takes the pin out of the latch mode of gpio_set_latch().
+ *
  * @param self Pointer to the GPIO object.
  * @return
  * - **ESP_OK** on success
@@ -232,4 +529,189 @@ esp_err_t gpio_disable_isr(gpio_t *self);
  */
 esp_err_t gpio_enable_isr(gpio_t *self);
 
+/**
+ * @brief Change the edge an input interrupts on.
+ *
+ * Unlike gpio_set_intr_type(), the driver keeps track of the new type for
+ * the sleep snapshots, the wake patterns and the edge sequence check of
+ * gpio_get_edge_check(). The CPU interrupt is left as it is.
+ *
+ * @param self Pointer to the GPIO object, a native input.
+ * @param type GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE or GPIO_INTR_ANYEDGE.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_set_edge(gpio_t *self, gpio_int_type_t type);
+
+/**
+ * @brief Declare the period of a periodic input, for the edge check.
+ *
+ * The period is the time between two edges that raise the interrupt: any
+ * two edges on a GPIO_INTR_ANYEDGE input, two rising (or falling) edges
+ * otherwise. gpio_get_edge_check() then counts the interrupts lost from the
+ * time between interrupts, on any edge type. Suits continuous signals, such
+ * as a clock, a tachometer or an encoder at a steady speed: declare the
+ * period again after the signal stopped, or its gap counts as lost edges.
+ * Restarts the check of the pin; setting the pin up again drops the period.
+ *
+ * @param self Pointer to the GPIO object, a native input.
+ * @param period_ns Period, in nanoseconds; 0 for none.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid, or the period is
+ *   shorter than a CPU cycle or longer than 2^31 of them
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled
+ */
+esp_err_t gpio_set_edge_period(gpio_t *self, uint32_t period_ns);
+
+/**
+ * @brief Latch the edges of an input in the interrupt status register,
+ * with its CPU interrupt masked.
+ *
+ * The hardware keeps latching the edges of @p type, however narrow, while
+ * no interrupt is taken: gpio_poll_edges() then collects them in bulk, so a
+ * pulse shorter than the polling period is never missed, at the CPU cost of
+ * a poll. Several edges between two polls count as one. The mode lasts until
+ * the pin is reconfigured or gpio_enable_isr() hands it back to the ISR
+ * service, and is kept by the sleep snapshots.
+ *
+ * @param self Pointer to the GPIO object, a native input.
+ * @param type GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE or GPIO_INTR_ANYEDGE.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_set_latch(gpio_t *self, gpio_int_type_t type);
+
+/**
+ * @brief Collect and clear the edges latched since the last poll.
+ *
+ * Reads the status register banks @p pin_mask touches, one load each, and
+ * clears the bits found set. Only pass pins in the latch mode of
+ * gpio_set_latch(): the edges of the other pins belong to the ISR service.
+ * Safe from an ISR.
+ *
+ * @param pin_mask Pins to poll (bit N is GPIO N).
+ * @return Pins of @p pin_mask that saw an edge since the last poll.
+ */
+uint64_t gpio_poll_edges(uint64_t pin_mask);
+
+/**
+ * @brief Set several output pins at once.
+ *
+ * Pins in @p pin_mask take the level of the matching bit in @p levels (bit N
+ * is GPIO N). Writes spanning GPIO 0-31 and GPIO 32-39 are issued back to back
+ * in a fixed order with interrupts masked, to keep the skew between both
+ * register banks to a few cycles.
+ *
+ * @param pin_mask Pins to write.
+ * @param levels Levels of the pins.
+ * @return
+ * - **ESP_OK** on success
+ */
+esp_err_t gpio_write_mask(uint64_t pin_mask, uint64_t levels);
+
+/**
+ * @brief Read the input levels of several pins at once.
+ *
+ * Both register banks are read back to back, so the result is a snapshot of
+ * the pins within a few cycles.
+ *
+ * @param pin_mask Pins to read (bit N is GPIO N).
+ * @return Levels of the pins in @p pin_mask, other bits cleared.
+ */
+uint64_t gpio_read_mask(uint64_t pin_mask);
+
+/**
+ * @brief Get the inter-bank skew statistics of multi-pin writes.
+ *
+ * @param stats Where to store the statistics.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_SKEW_TRACE is disabled
+ */
+esp_err_t gpio_get_write_skew(gpio_skew_stats_t *stats);
+
+/**
+ * @brief Get the operation counters of a pin.
+ *
+ * Sums the counters of both cores. Taken while the pin is in use, the
+ * snapshot may miss the operations in flight.
+ *
+ * @param pin GPIO number.
+ * @param metrics Where to store the counters.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_METRICS is disabled
+ */
+esp_err_t gpio_get_metrics(gpio_pinout_t pin, gpio_metrics_t *metrics);
+
+/**
+ * @brief Clear the operation counters of every pin.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_METRICS is disabled
+ */
+esp_err_t gpio_reset_metrics(void);
+
+/**
+ * @brief Get the edge sequence check of an input.
+ *
+ * The interrupt of an edge is only latched once until it is serviced, so
+ * edges coming faster than the ISRs merge and their interrupts are lost.
+ * The ISR never sees the merged edges; the check infers them:
+ *
+ * - with a period declared by gpio_set_edge_period(), from the time of each
+ *   interrupt: the edges expected since the previous one, less the one
+ *   taken, were lost. The expected edge times follow a grid, so the
+ *   rounding does not add up over the interrupts. The count is exact while
+ *   the signal keeps its period; one off by a fraction e of it adds about
+ *   one count every 1/e edges. An interrupt less than half a period after
+ *   the last expected edge counts as early, and restarts the grid;
+ * - without a period, on a GPIO_INTR_ANYEDGE input only, from the level
+ *   read at ISR entry. The same level at two interrupts in a row means an
+ *   odd number of edges merged. An even number leaves the levels
+ *   alternating and goes unseen, so this is a lower bound only, and far
+ *   below the real losses once edges come faster than the ISRs.
+ *
+ * The level of a GPIO_INTR_NEGEDGE or POSEDGE input tells nothing: a pulse
+ * shorter than the interrupt latency is back to idle when read, whether
+ * interrupts were lost or not. Declare its period to check it.
+ *
+ * Only the inputs set up by gpio_init_impl() with an ISR handler are
+ * checked. A lost count growing means the input needs a hardware counter or
+ * polling; an early count, that the declared period is wrong.
+ *
+ * @param pin GPIO number.
+ * @param check Where to store the check.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled
+ */
+esp_err_t gpio_get_edge_check(gpio_pinout_t pin, gpio_edge_check_t *check);
+
+/**
+ * @brief Get the inputs with lost or early interrupts.
+ *
+ * @return Pins whose gpio_edge_check_t counts lost or early interrupts (bit
+ * N is GPIO N); 0 if CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled.
+ */
+uint64_t gpio_get_edge_check_flags(void);
+
+/**
+ * @brief Clear the edge sequence check of every input.
+ *
+ * An interrupt in flight may be counted either before or after the reset.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EDGE_CHECK is disabled
+ */
+esp_err_t gpio_reset_edge_check(void);
+
 #endif  // GPIO_DRIVERS_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file gpio_events.h
+ * @brief Timestamped edge events of the driver inputs.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * With CONFIG_GPIO_DRIVERS_EDGE_EVENTS, the ISR dispatch of every input set
+ * up by gpio_init_impl() records each interrupt as an event (pin, level read
+ * in the ISR, timestamp) in a lock-free ring, before running the pin's ISR
+ * handler. One task drains the ring with gpio_event_pop(), e.g. the flash
+ * event log of gpio_evlog.h. Events recorded while the ring is full are
+ * dropped and counted.
+ *
+ * With CONFIG_GPIO_DRIVERS_TIMESTAMP the events are stamped with
+ * gpio_ts_now() (gpio_timestamp.h): ordering them by time_us then cycles
+ * merges the interrupts of both cores in the order they were taken. The
+ * ring order may differ from it by a few cycles: an ISR can queue its event
+ * between the stamp and the queuing of another, on the other core or nested
+ * in it.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_EVENTS_H
+#define GPIO_EVENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief One edge seen by the driver ISR dispatch.
+ */
+typedef struct
+{
+  int64_t time_us; /**< esp_timer time of the interrupt */
+  uint8_t pin;     /**< GPIO number */
+  uint8_t level;   /**< Input level read in the ISR */
+  uint16_t cycles; /**< CPU cycles past time_us, with
+                        CONFIG_GPIO_DRIVERS_TIMESTAMP (0 otherwise) */
+} gpio_edge_event_t;
+
+/**
+ * @brief Take the oldest edge event out of the ring.
+ *
+ * Single consumer: call it from one task only.
+ *
+ * @param event Where to store the event.
+ * @return true if an event was taken, false if the ring is empty or the
+ * feature is disabled.
+ */
+bool gpio_event_pop(gpio_edge_event_t *event);
+
+/**
+ * @brief Number of edge events dropped because the ring was full.
+ */
+uint32_t gpio_event_get_dropped(void);
+
+#endif  // GPIO_EVENTS_H
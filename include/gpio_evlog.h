@@ -0,0 +1,160 @@
+/**
+ * @file gpio_evlog.h
+ * @brief Persistent log of the edge events in a flash partition.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Drains the edge events of gpio_events.h into a RAM page, each event coded
+ * as one varint of its signed time delta to the previous event, pin and
+ * level (two or three bytes for edges a few ms apart), and writes every full
+ * page to one sector of a dedicated data partition. The sectors are used in
+ * a circle, so each one is erased once per lap and the wear is spread
+ * evenly; a sector still blank is written without an erase. The ISRs only
+ * fill the event ring: all flash I/O runs in the task started by
+ * gpio_evlog_init().
+ *
+ * A sector erase turns the flash cache off for up to a few hundred ms. So
+ * that the GPIO interrupt keeps being taken meanwhile, the driver installs
+ * the ISR service with ESP_INTR_FLAG_IRAM when the log is enabled: the ISR
+ * handlers given to gpio_init_impl() and gpio_set_config_input() must then
+ * be IRAM_ATTR functions touching only DRAM data. An ISR service installed
+ * by the application before the driver must use the same flag.
+ *
+ * The events are stored, and read back, in the order of the ring, with
+ * their exact times. That order is not quite the time order: an ISR nested
+ * in another, or on the other core, may queue its event between the stamp
+ * and the queuing of an earlier one, and a timestamp calibration step
+ * (gpio_timestamp.h) moves the times back. Such events, counted as
+ * reordered, are apart by the length of an ISR at most, but for a step: sort
+ * the events read back by time where the order matters.
+ *
+ * Add the partition to the partition table, e.g.
+ * `gpio_evlog, data, 0x40, , 64K`, and read the log back after a reboot
+ * with gpio_evlog_reader_init() and gpio_evlog_read().
+ *
+ * Only available when CONFIG_GPIO_DRIVERS_EVLOG is enabled; otherwise the
+ * functions return ESP_ERR_NOT_SUPPORTED.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_EVLOG_H
+#define GPIO_EVLOG_H
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include "gpio_events.h"
+
+/**
+ * @brief Counters of the event log since gpio_evlog_init().
+ */
+typedef struct
+{
+  uint32_t events;         /**< Events stored in pages */
+  uint32_t pages;          /**< Pages written to flash */
+  uint32_t erases;         /**< Sectors erased */
+  uint32_t erases_skipped; /**< Sectors found blank and written as is */
+  uint32_t bytes;          /**< Event bytes in the written pages */
+  uint32_t reordered;      /**< Events earlier than the one before them */
+} gpio_evlog_stats_t;
+
+/**
+ * @brief Position of a reader in the event log.
+ */
+typedef struct
+{
+  uint32_t slot;    /**< Sector being read */
+  uint32_t visited; /**< Sectors visited so far */
+  uint32_t seq;     /**< Sequence number of the page being read */
+  uint32_t offset;  /**< Partition offset of the next event byte */
+  uint32_t end;     /**< Partition offset of the end of the page events */
+  int64_t time_us;  /**< Time of the last event read */
+} gpio_evlog_reader_t;
+
+/**
+ * @brief Mount the event log partition and start the task that writes it.
+ *
+ * Scans the page headers to resume after the newest page. On the `linux`
+ * target no task is started: call gpio_evlog_drain() instead.
+ *
+ * @param label Label of the data partition.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_FOUND** if the partition does not exist
+ * - **ESP_ERR_INVALID_SIZE** if the partition is smaller than two sectors
+ * - **ESP_ERR_NO_MEM** if the task cannot be created
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ */
+esp_err_t gpio_evlog_init(const char *label);
+
+/**
+ * @brief Move the pending edge events to the RAM page, writing each page
+ * that fills up.
+ *
+ * Called periodically by the task of gpio_evlog_init().
+ *
+ * @return Number of events moved.
+ */
+uint32_t gpio_evlog_drain(void);
+
+/**
+ * @brief Drain the edge events and write the partly filled page, e.g.
+ * before a planned reset.
+ *
+ * The page is closed: the next events start a new sector, so syncing often
+ * wears the flash as much as full pages would.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_STATE** if the log is not mounted
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ * - Flash errors of esp_partition_write() and esp_partition_erase_range()
+ */
+esp_err_t gpio_evlog_sync(void);
+
+/**
+ * @brief Get the counters of the event log.
+ *
+ * @param stats Where to store the counters.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ */
+esp_err_t gpio_evlog_get_stats(gpio_evlog_stats_t *stats);
+
+/**
+ * @brief Start reading the stored events, oldest page first.
+ *
+ * Events still in RAM are not seen: call gpio_evlog_sync() first to include
+ * them.
+ *
+ * @param reader Reader to set up.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** if the log is not mounted
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ */
+esp_err_t gpio_evlog_reader_init(gpio_evlog_reader_t *reader);
+
+/**
+ * @brief Read the next stored event.
+ *
+ * The events come in the order they were stored, which may put one a
+ * little before the previous (see gpio_evlog_stats_t::reordered).
+ *
+ * @param reader Reader set up by gpio_evlog_reader_init().
+ * @param event Where to store the event.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_FOUND** past the newest stored event
+ * - **ESP_ERR_INVALID_CRC** if a page holds a malformed event
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_EVLOG is disabled
+ */
+esp_err_t gpio_evlog_read(gpio_evlog_reader_t *reader, gpio_edge_event_t *event);
+
+#endif  // GPIO_EVLOG_H
@@ -0,0 +1,137 @@
+/**
+ * @file gpio_expander.h
+ * @brief I2C port expanders (PCF8574, MCP23017) as virtual pins.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Registers an expander as a virtual port of gpio_vport.h, so its pins are
+ * driven with gpio_write() and gpio_read() like native ones. Writes are
+ * batched: gpio_vport_flush() sends the levels of every pin of the chip in
+ * one transaction (2 bytes on a PCF8574, 4 on a MCP23017), instead of one
+ * read-modify-write per pin. With the chip INT line wired to a native pin,
+ * the inputs are read once per interrupt and the other pin reads come from
+ * the cache.
+ *
+ * The component does not depend on an I2C driver: the application passes
+ * the two bus transactions it needs, usually thin wrappers around
+ * i2c_master_transmit() and i2c_master_transmit_receive().
+ *
+ * @code
+ * static gpio_expander_t exp;
+ * gpio_expander_config_t config = {
+ *     .type = GPIO_EXPANDER_MCP23017, .addr = 0x20,
+ *     .bus = &my_i2c_bus, .bus_ctx = dev, .int_pin = D4,
+ * };
+ * gpio_expander_init(&exp, &config);
+ * gpio_t led = {.pin = GPIO_EXPANDER_PIN(&exp, 3), ._mode = GPIO_MODE_OUTPUT};
+ * gpio_init_impl(&led);
+ * gpio_write(&led, GPIO_STATE_HIGH);
+ * gpio_vport_flush(&exp.port);
+ * @endcode
+ *
+ * Only available when CONFIG_GPIO_DRIVERS_VPINS is enabled.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_EXPANDER_H
+#define GPIO_EXPANDER_H
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+#include "gpio_vport.h"
+
+/**
+ * @brief Supported expander chips.
+ */
+typedef enum
+{
+  GPIO_EXPANDER_PCF8574,  /**< 8 quasi-bidirectional pins */
+  GPIO_EXPANDER_MCP23017, /**< 16 pins, ports A (0-7) and B (8-15) */
+} gpio_expander_type_t;
+
+/**
+ * @brief I2C transactions provided by the application.
+ */
+typedef struct
+{
+  /**
+   * @brief Write bytes to a device.
+   *
+   * @param ctx Bus context of the expander configuration.
+   * @param addr 7-bit device address.
+   * @param data Bytes to write.
+   * @param len Number of bytes.
+   * @return
+   * - **ESP_OK** on success
+   * - Bus errors
+   */
+  esp_err_t (*write)(void *ctx, uint8_t addr, const uint8_t *data,
+                     size_t len);
+
+  /**
+   * @brief Write bytes to a device, then read bytes back (repeated start).
+   *
+   * @param ctx Bus context of the expander configuration.
+   * @param addr 7-bit device address.
+   * @param out Bytes to write, NULL when @p out_len is 0.
+   * @param out_len Number of bytes to write.
+   * @param in Where to store the bytes read.
+   * @param in_len Number of bytes to read.
+   * @return
+   * - **ESP_OK** on success
+   * - Bus errors
+   */
+  esp_err_t (*write_read)(void *ctx, uint8_t addr, const uint8_t *out,
+                          size_t out_len, uint8_t *in, size_t in_len);
+} gpio_expander_bus_t;
+
+/**
+ * @brief Expander configuration.
+ */
+typedef struct
+{
+  gpio_expander_type_t type;      /**< Chip */
+  uint8_t addr;                   /**< 7-bit I2C address */
+  const gpio_expander_bus_t *bus; /**< Bus transactions */
+  void *bus_ctx;                  /**< Argument of the bus transactions */
+  gpio_pinout_t int_pin;          /**< Native pin on INT, DISABLE if none */
+} gpio_expander_config_t;
+
+/**
+ * @brief An expander and its virtual port.
+ */
+typedef struct
+{
+  gpio_vport_t port;             /**< Virtual port, first member */
+  gpio_expander_config_t config; /**< Configuration */
+  gpio_t int_line;               /**< Native input on the INT line */
+} gpio_expander_t;
+
+/**
+ * @brief Virtual pin number of pin @p bit of an expander.
+ */
+#define GPIO_EXPANDER_PIN(self, bit) GPIO_VPIN(&(self)->port, bit)
+
+/**
+ * @brief Set up an expander and register its virtual port.
+ *
+ * Every pin starts as an input. When an INT pin is given, it is set up as a
+ * native input (falling edge, pull-up) that invalidates the input cache.
+ *
+ * @param self Expander, kept alive while its pins are used.
+ * @param config Configuration.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if there are not enough free virtual pins
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ * - Bus errors
+ */
+esp_err_t gpio_expander_init(gpio_expander_t *self,
+                             const gpio_expander_config_t *config);
+
+#endif  // GPIO_EXPANDER_H
@@ -0,0 +1,60 @@
+/**
+ * @file gpio_fast_isr.h
+ * @brief Generated per-pin ISR trampolines for latency-critical inputs.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * The ISR service behind gpio_isr_handler_add() scans the interrupt status,
+ * then looks up the handler and argument of each firing pin in a table. For
+ * the few pins where that matters, the board header named by
+ * CONFIG_GPIO_DRIVERS_FAST_ISR_BOARD lists them with an X-macro:
+ *
+ * @code
+ * void encoder_isr(void *arg);
+ * extern encoder_t s_encoder;
+ *
+ * #define GPIO_FAST_ISR_PINS(X)                                             \
+ *   X(D4, encoder_isr, &s_encoder)                                          \
+ *   X(D5, encoder_isr, &s_encoder)
+ * @endcode
+ *
+ * and the driver is built with one IRAM trampoline per entry, which clears
+ * the status bit of its pin and calls its handler with its argument, both
+ * compile-time constants. gpio_fast_isr_install() hooks them in front of the
+ * ISR service, on the same (shared) GPIO interrupt: the entry tests the
+ * listed status bits only, so the handler is reached without any lookup.
+ *
+ * The board header must be on the include path of this component, e.g. with
+ * `idf_build_set_property(INCLUDE_DIRECTORIES <dir> APPEND)` in the project
+ * CMakeLists.txt. The pins are named by a gpio_pinout_t or gpio_num_t
+ * constant, or a plain number. Configure them as edge-triggered inputs
+ * without an ISR handler (gpio_set_config_input(pin, NULL, NULL)). Their
+ * edges bypass the ISR service, so they are not counted by
+ * CONFIG_GPIO_DRIVERS_METRICS nor recorded by CONFIG_GPIO_DRIVERS_EDGE_EVENTS.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_FAST_ISR_H
+#define GPIO_FAST_ISR_H
+
+#include <esp_err.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Hook the generated trampolines on the GPIO interrupt.
+ *
+ * Installs the ISR service first, if it is not already, so the trampolines
+ * always run before it. Call it once, before the listed pins can fire.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the board header lists an invalid pin
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_FAST_ISR is disabled
+ * - **ESP_ERR_NOT_FOUND** if the GPIO interrupt cannot be shared
+ * - **ESP_ERR_INVALID_STATE** if the trampolines are already installed
+ */
+esp_err_t gpio_fast_isr_install(void);
+
+#endif  // GPIO_FAST_ISR_H
@@ -0,0 +1,125 @@
+/**
+ * @file gpio_filter.h
+ * @brief Majority-vote filtering of noisy inputs, all pins at once.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Industrial inputs pick up spikes from motors, relays and long cables: one
+ * read of a pin can be wrong even though its level is steady. A filter takes
+ * several snapshots of every input (gpio_drv_ll_read()) in a row and
+ * keeps, for each pin, the level most of them agree on. The pins are never
+ * handled one by one:
+ *
+ * - the snapshots are added up in bit-sliced counters, bit N of plane B
+ *   holding bit B of the count of highs of GPIO N, so one snapshot costs a
+ *   few 64-bit ANDs and XORs whatever the number of pins;
+ * - the counts are compared with the thresholds the same way, and give the
+ *   filtered bitmap with hysteresis: a low pin needs more highs to rise than
+ *   a high pin needs to stay high;
+ * - an optional debounce keeps each output until its filtered level has
+ *   differed for a number of updates in a row, with vertical counters.
+ *
+ * gpio_filter_t::levels is the bitmap to act on, gpio_filter_t::changed the
+ * pins that toggled in the last update (rising: changed & levels). Feed them
+ * to the control logic and to the change detection, e.g. the telemetry:
+ *
+ * @code
+ * gpio_filter_t filter;
+ * gpio_filter_init(&filter, inputs, 5, 1, 240, 3);
+ * ...
+ * gpio_filter_sample(&filter);
+ * if (filter.changed)
+ *   gpio_telemetry_encode(&enc, now_us, filter.levels, buf, size, &len);
+ * @endcode
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_FILTER_H
+#define GPIO_FILTER_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Bits of the bit-sliced counters.
+ */
+#define GPIO_FILTER_COUNT_BITS 4
+
+/**
+ * @brief Most snapshots per update, and longest debounce, in updates.
+ */
+#define GPIO_FILTER_SAMPLES_MAX ((1 << GPIO_FILTER_COUNT_BITS) - 1)
+
+/**
+ * @brief State of one filter.
+ */
+typedef struct
+{
+  uint64_t pin_mask; /**< Pins filtered (bit N is GPIO N) */
+  uint64_t state;    /**< Voted levels, before the debounce */
+  uint64_t levels;   /**< Filtered levels */
+  uint64_t changed;  /**< Pins of levels that toggled in the last update */
+  uint64_t debounce_count[GPIO_FILTER_COUNT_BITS]; /**< Updates each state
+                                                        differed, bit-sliced */
+  uint32_t spacing; /**< Cycles between two snapshots */
+  uint8_t samples;  /**< Snapshots per update */
+  uint8_t rise;     /**< Highs for a low pin to rise */
+  uint8_t hold;     /**< Highs for a high pin to stay high */
+  uint8_t debounce; /**< Updates a new state must last */
+  bool started;     /**< An update was done */
+} gpio_filter_t;
+
+/**
+ * @brief Set up a filter.
+ *
+ * With no hysteresis a pin follows the majority, and keeps its level on a
+ * tie. Each step of @p hysteresis moves both thresholds one snapshot away
+ * from the middle: with 5 snapshots and a hysteresis of 1, a low pin rises
+ * on 4 highs and a high pin falls on 4 lows.
+ *
+ * @param self Filter to set up.
+ * @param pin_mask Pins to filter (bit N is GPIO N).
+ * @param samples Snapshots per update, 1 to GPIO_FILTER_SAMPLES_MAX.
+ * @param hysteresis Up to (samples - 1) / 2.
+ * @param spacing Cycles between two snapshots of gpio_filter_sample(); they
+ * should span more than the longest spike.
+ * @param debounce Updates a new level must last, up to
+ * GPIO_FILTER_SAMPLES_MAX; 0 or 1 for none.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_filter_init(gpio_filter_t *self, uint64_t pin_mask,
+                           uint32_t samples, uint32_t hysteresis,
+                           uint32_t spacing, uint32_t debounce);
+
+/**
+ * @brief Update a filter from snapshots taken by the caller.
+ *
+ * The first update sets the levels to the majority, without hysteresis or
+ * debounce. Callable from ISRs (IRAM).
+ *
+ * @param self Filter.
+ * @param snapshots gpio_filter_t::samples input snapshots, bit N is GPIO N.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_filter_update(gpio_filter_t *self, const uint64_t *snapshots);
+
+/**
+ * @brief Take the snapshots of the inputs and update a filter.
+ *
+ * Reads both input registers gpio_filter_t::samples times, spaced by
+ * gpio_filter_t::spacing cycles. Callable from ISRs (IRAM).
+ *
+ * @param self Filter.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_filter_sample(gpio_filter_t *self);
+
+#endif  // GPIO_FILTER_H
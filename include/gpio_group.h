@@ -0,0 +1,111 @@
+/**
+ * @file gpio_group.h
+ * @brief Logical groups of GPIOs written and read as a single N-bit value.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A group maps logical bit i of a value to the i-th pin of a pin list (a
+ * relay bank, an LED bar, an address bus...). All the remapping work is done
+ * once in gpio_group_init(), so writing a value is a table-assisted scatter
+ * plus one set/clear register write per bank, and reading is a single input
+ * snapshot plus a gather.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_GROUP_H
+#define GPIO_GROUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Maximum number of pins in a group (one bit of a uint32_t each).
+ */
+#define GPIO_GROUP_MAX_PINS 32
+
+/**
+ * @brief Number of 4-bit lanes of the scatter lookup table.
+ */
+#define GPIO_GROUP_LUT_LANES (GPIO_GROUP_MAX_PINS / 4)
+
+/**
+ * @brief Configuration used to build a GPIO group.
+ */
+typedef struct
+{
+  const gpio_pinout_t *pins; /**< Pins in logical bit order, bit 0 first */
+  uint8_t pin_count;         /**< Number of entries in pins */
+  uint32_t active_low_mask;  /**< Logical bits whose pin is active-low */
+  bool time_critical;        /**< Warn if the pins straddle both banks */
+} gpio_group_config_t;
+
+/**
+ * @brief Structure representing a GPIO group.
+ *
+ * Every 64-bit mask holds GPIO N in bit N: bank 0 (GPIO 0-31) in the low word
+ * and bank 1 (GPIO 32-39) in the high word.
+ */
+typedef struct
+{
+  uint8_t pin_count;                       /**< Number of pins in the group */
+  uint8_t bit_to_pin[GPIO_GROUP_MAX_PINS]; /**< Logical bit to GPIO number */
+  uint64_t pin_mask;    /**< Every pin of the group, per bank */
+  uint64_t invert_mask; /**< Active-low pins of the group, per bank */
+  uint64_t scatter_lut[GPIO_GROUP_LUT_LANES][16]; /**< Nibble to pin mask */
+} gpio_group_t;
+
+/**
+ * @brief Build a GPIO group, precomputing its masks and lookup tables.
+ *
+ * The pins themselves are not configured, see gpio_group_set_config_output().
+ * A time-critical group mixing GPIO 0-31 and GPIO 32-39 logs a warning, as
+ * its writes need stores to both register banks.
+ *
+ * @param self Pointer to the GPIO group object.
+ * @param config Pins and polarity of the group.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_group_init(gpio_group_t *self, const gpio_group_config_t *config);
+
+/**
+ * @brief Configure every pin of the group as output with a single gpio_config.
+ *
+ * The inputs stay enabled, so gpio_group_read() returns the levels on the
+ * pins, and the pins are part of the sleep snapshots (gpio_sleep.h).
+ *
+ * @param self Pointer to the GPIO group object.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the group has an input-only pin
+ * - The error of gpio_config() otherwise
+ */
+esp_err_t gpio_group_set_config_output(gpio_group_t *self);
+
+/**
+ * @brief Write an N-bit logical value to the group.
+ *
+ * Bit i of @p value drives the i-th pin of the group, honouring its
+ * active-low polarity. Bits above the group size are ignored.
+ *
+ * @param self Pointer to the GPIO group object.
+ * @param value Logical value to write.
+ * @return
+ * - **ESP_OK** on success
+ */
+esp_err_t gpio_group_write(gpio_group_t *self, uint32_t value);
+
+/**
+ * @brief Read the N-bit logical value of the group.
+ *
+ * @param self Pointer to the GPIO group object.
+ * @return
+ * - Logical value, bit i being the (polarity corrected) i-th pin
+ */
+uint32_t gpio_group_read(gpio_group_t *self);
+
+#endif  // GPIO_GROUP_H
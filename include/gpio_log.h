@@ -0,0 +1,98 @@
+/**
+ * @file gpio_log.h
+ * @brief Deferred logging usable from ISR handlers and hot paths.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A log call only stores the tag, the format string pointer and up to four
+ * integer arguments in a lock-free ring; the text is formatted and written
+ * with esp_log_write() later, by a low-priority task. The format string is
+ * not copied, so it must be a string literal or otherwise outlive the flush,
+ * and its conversions must all take 32-bit integers (%d, %u, %x...).
+ *
+ * Only available when CONFIG_GPIO_DRIVERS_DEFERRED_LOG is enabled; otherwise
+ * GPIO_LOG_DEFERRED() discards its message.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_LOG_H
+#define GPIO_LOG_H
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+/**
+ * @brief Maximum number of integer arguments of a deferred log entry.
+ */
+#define GPIO_LOG_MAX_ARGS 4
+
+#define GPIO_LOG_NARGS(...) GPIO_LOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define GPIO_LOG_NARGS_(_0, _1, _2, _3, _4, n, ...) n
+
+#if CONFIG_GPIO_DRIVERS_DEFERRED_LOG
+/**
+ * @brief Queue a log message, from any context, with up to four integer
+ * arguments.
+ *
+ * Entries above LOG_LOCAL_LEVEL compile out, as with ESP_LOGx.
+ */
+#define GPIO_LOG_DEFERRED(level, tag, format, ...)                            \
+  do                                                                          \
+  {                                                                           \
+    if (LOG_LOCAL_LEVEL >= (level))                                           \
+      gpio_log_write((level), (tag), (format),                                \
+                     GPIO_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__);             \
+  } while (0)
+#else
+#define GPIO_LOG_DEFERRED(level, tag, format, ...)                            \
+  do                                                                          \
+  {                                                                           \
+  } while (0)
+#endif
+
+/**
+ * @brief Start the task that flushes the deferred log.
+ *
+ * Not needed on the `linux` target, where gpio_log_flush() is called
+ * directly.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NO_MEM** if the task cannot be created
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_DEFERRED_LOG is disabled
+ */
+esp_err_t gpio_log_init(void);
+
+/**
+ * @brief Queue a log message. Use GPIO_LOG_DEFERRED() instead.
+ *
+ * Never blocks: when the ring is full the message is dropped and counted.
+ *
+ * @param level Log level.
+ * @param tag Log tag, kept by pointer.
+ * @param format printf format of 32-bit integer arguments, kept by pointer.
+ * @param nargs Number of integer arguments that follow (at most 4).
+ */
+void gpio_log_write(esp_log_level_t level, const char *tag, const char *format,
+                    int nargs, ...);
+
+/**
+ * @brief Write the queued messages with esp_log_write().
+ *
+ * Call from task context only. Reports the messages dropped since the last
+ * flush.
+ *
+ * @return Number of messages written.
+ */
+uint32_t gpio_log_flush(void);
+
+/**
+ * @brief Number of messages dropped because the ring was full.
+ */
+uint32_t gpio_log_get_dropped(void);
+
+#endif  // GPIO_LOG_H
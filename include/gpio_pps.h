@@ -0,0 +1,98 @@
+/**
+ * @file gpio_pps.h
+ * @brief Pulse-per-second discipline of the driver timestamps.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A GPS receiver marks each second with an edge on its PPS output.
+ * gpio_pps_init() sets up that pin as a driver input whose ISR timestamps
+ * the edge with the CPU cycle counter, read first thing, and esp_timer.
+ * Each pulse then feeds a fixed-point phase-locked loop, run by the next
+ * call that needs it, which tracks:
+ *
+ * - the phase: the cycle count of the last second boundary;
+ * - the frequency: the cycles in one true second, i.e. the drift of the
+ *   local crystal, resolved to a fraction of a cycle per second.
+ *
+ * gpio_pps_to_ns() turns a raw driver timestamp (the esp_timer time of
+ * gpio_edge_event_t, GPIO_DRV_TIME_US) into nanoseconds on the disciplined
+ * timescale, where second N starts at the N-th pulse after the first. The
+ * conversion is a few multiplies, whatever the time since the last pulse.
+ *
+ * Edges more than about 250 ppm away from a whole number of seconds are
+ * rejected as glitches; missing pulses are bridged with the tracked
+ * frequency. The CPU frequency must stay fixed (hold an ESP_PM_CPU_FREQ_MAX
+ * lock with dynamic frequency scaling).
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_PPS_H
+#define GPIO_PPS_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief State of the discipline loop.
+ */
+typedef struct
+{
+  uint32_t pulses;   /**< PPS edges captured */
+  uint32_t accepted; /**< Edges fed to the loop */
+  uint32_t rejected; /**< Edges rejected as glitches */
+  uint32_t overruns; /**< Edges lost because none was processed for long */
+  int64_t second;    /**< Disciplined second of the last accepted edge */
+  int32_t drift_ppb; /**< Local clock rate error (positive: fast) */
+  int32_t offset_ns; /**< Phase error of the last accepted edge */
+  bool locked;       /**< Enough edges in a row to trust the timescale */
+} gpio_pps_stats_t;
+
+/**
+ * @brief Set up the PPS input and start capturing its edges.
+ *
+ * Configures @p pin as an input (pull-up on) with the PPS ISR handler, and
+ * installs the ISR service if needed. Calling it again starts the
+ * discipline over, on the same or another pin. Not thread-safe.
+ *
+ * @param pin GPIO wired to the PPS output.
+ * @param edge GPIO_INTR_POSEDGE or GPIO_INTR_NEGEDGE, the edge on the second
+ * boundary.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_pps_init(gpio_pinout_t pin, gpio_int_type_t edge);
+
+/**
+ * @brief Convert a raw driver timestamp to the disciplined timescale.
+ *
+ * Processes the pending PPS edges first. The result is as fine as
+ * @p time_us, within a microsecond, plus the loop phase error.
+ *
+ * @param time_us esp_timer time, in microseconds.
+ * @param ns Where to store the disciplined time, in nanoseconds.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** until two PPS edges have been captured
+ */
+esp_err_t gpio_pps_to_ns(int64_t time_us, int64_t *ns);
+
+/**
+ * @brief Get the state of the discipline loop.
+ *
+ * Processes the pending PPS edges first.
+ *
+ * @param stats Where to store the state.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_pps_get_stats(gpio_pps_stats_t *stats);
+
+#endif  // GPIO_PPS_H
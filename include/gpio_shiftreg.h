@@ -0,0 +1,118 @@
+/**
+ * @file gpio_shiftreg.h
+ * @brief 74HC595 and 74HC165 shift-register chains as virtual pins.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * Registers a chain of shift registers as a virtual port of gpio_vport.h,
+ * so each bit is a pin driven with gpio_write() or read with gpio_read().
+ * The chain is bit-banged on native pins straight through the W1TS/W1TC
+ * registers:
+ *
+ * - a 74HC595 chain (outputs) is shifted out and latched by
+ *   gpio_vport_flush(), only when its shadow changed. Bit N is output N
+ *   counting from QA of the chip nearest the MCU;
+ * - a 74HC165 chain (inputs) is loaded and shifted in, with its group, by
+ *   gpio_vport_refresh(). Pin reads return the last sample: refresh the chain
+ *   (or call gpio_vport_invalidate() for the next read to do it) whenever a
+ *   new sample is wanted. Bit N is the N-th bit shifted in after the load.
+ *
+ * Chains sharing their clock and latch lines, each with its own data line,
+ * form a group shifted as parallel lanes: one store per clock edge drives
+ * every data line, so four 64-bit chains take about the time of one. A
+ * 74HC595 group is always shifted whole (shifting one chain alone would
+ * latch garbage into the others), when any of its chains changed.
+ *
+ * The chain is shifted inside a critical section, a few microseconds for 64
+ * bits, so both cores may flush it. Only available when
+ * CONFIG_GPIO_DRIVERS_VPINS is enabled.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SHIFTREG_H
+#define GPIO_SHIFTREG_H
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+#include "gpio_vport.h"
+
+/**
+ * @brief Supported shift registers.
+ */
+typedef enum
+{
+  GPIO_SHIFTREG_74HC595, /**< Serial-in, parallel-out (outputs) */
+  GPIO_SHIFTREG_74HC165, /**< Parallel-in, serial-out (inputs) */
+} gpio_shiftreg_type_t;
+
+/**
+ * @brief Most chains in a group sharing their clock and latch lines.
+ */
+#define GPIO_SHIFTREG_LANES_MAX 8
+
+/**
+ * @brief Shift-register chain configuration.
+ */
+typedef struct
+{
+  gpio_shiftreg_type_t type; /**< Chip of the chain */
+  gpio_pinout_t data;        /**< SER (74HC595) or QH (74HC165) */
+  gpio_pinout_t clock;       /**< SRCLK (74HC595) or CLK (74HC165) */
+  gpio_pinout_t latch;       /**< RCLK (74HC595) or SH/LD (74HC165) */
+  uint8_t length;            /**< Bits of the chain, 1 to 64 */
+} gpio_shiftreg_config_t;
+
+/**
+ * @brief A shift-register chain and its virtual port.
+ */
+typedef struct gpio_shiftreg
+{
+  gpio_vport_t port;             /**< Virtual port, first member */
+  gpio_shiftreg_config_t config; /**< Configuration */
+  struct gpio_shiftreg *next;    /**< Next registered chain */
+} gpio_shiftreg_t;
+
+/**
+ * @brief Virtual pin number of bit @p bit of a chain.
+ */
+#define GPIO_SHIFTREG_PIN(self, bit) GPIO_VPIN(&(self)->port, bit)
+
+/**
+ * @brief Set up a chain, configure its native pins and register its virtual
+ * port.
+ *
+ * A 74HC595 chain is cleared (every output low); the 74HC165 inputs are
+ * sampled on the first pin read.
+ *
+ * @param self Chain, kept alive while its pins are used.
+ * @param config Configuration.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if there are not enough free virtual pins, or
+ *   GPIO_SHIFTREG_LANES_MAX chains already share the clock and latch lines
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ */
+esp_err_t gpio_shiftreg_init(gpio_shiftreg_t *self,
+                             const gpio_shiftreg_config_t *config);
+
+/**
+ * @brief Shift out the group of a 74HC595 chain if any of its chains
+ * changed since the last flush.
+ *
+ * gpio_vport_flush() only looks at its own chain; this looks at every chain
+ * of the group, so one call covers the lanes.
+ *
+ * @param self Any chain of the group.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if @p self is not a registered 74HC595 chain
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ */
+esp_err_t gpio_shiftreg_flush(gpio_shiftreg_t *self);
+
+#endif  // GPIO_SHIFTREG_H
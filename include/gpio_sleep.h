@@ -0,0 +1,94 @@
+/**
+ * @file gpio_sleep.h
+ * @brief Snapshot and restore of the pin configuration across sleep.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A snapshot is a compact image of every pin configured through the driver
+ * (direction, pulls, output levels, interrupt types, hold state). Keep it in
+ * RTC memory before deep sleep and restore it on wake instead of running
+ * gpio_init_impl() for each pin:
+ *
+ * @code
+ * RTC_DATA_ATTR static gpio_snapshot_t s_snapshot;
+ *
+ * if (gpio_snapshot_restore(&s_snapshot) == ESP_OK)
+ *   gpio_attach_impl(&button);  // ISR routing only
+ * else
+ *   gpio_init_impl(&button);    // Cold boot
+ * ...
+ * gpio_snapshot_save(&s_snapshot);
+ * esp_deep_sleep_start();
+ * @endcode
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_SLEEP_H
+#define GPIO_SLEEP_H
+
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Marks a valid snapshot; RTC memory holds anything else after a
+ * power-on reset.
+ */
+#define GPIO_SNAPSHOT_MAGIC 0x47504931UL
+
+/**
+ * @brief Number of bytes of packed interrupt types, two pins per byte.
+ */
+#define GPIO_SNAPSHOT_INTR_BYTES ((GPIO_NUM_MAX + 1) / 2)
+
+/**
+ * @brief Configuration of every pin configured through the driver.
+ */
+typedef struct
+{
+  uint32_t magic;      /**< GPIO_SNAPSHOT_MAGIC when valid */
+  uint64_t inputs;     /**< Pins configured as inputs */
+  uint64_t outputs;    /**< Pins configured as outputs */
+  uint64_t pull_ups;   /**< Pins with the pull-up enabled */
+  uint64_t pull_downs; /**< Pins with the pull-down enabled */
+  uint64_t holds;      /**< Held pins */
+  uint64_t isrs;       /**< Inputs that had an ISR handler */
+  uint64_t latches;    /**< Inputs latching edges for gpio_poll_edges() */
+  uint64_t levels;     /**< Output register */
+  uint8_t intr_types[GPIO_SNAPSHOT_INTR_BYTES]; /**< 4 bits per pin */
+} gpio_snapshot_t;
+
+/**
+ * @brief Capture the configuration of every pin configured through the
+ * driver.
+ *
+ * @param snapshot Where to store the snapshot, typically in RTC memory.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_snapshot_save(gpio_snapshot_t *snapshot);
+
+/**
+ * @brief Apply a snapshot to the pins.
+ *
+ * Output levels are written first, so outputs come up at their saved level.
+ * Pins sharing a configuration are then set up by one gpio_config() call,
+ * with no logging, and the held pins are held again. ISR handlers are not
+ * part of the snapshot: attach the GPIO objects with gpio_attach_impl().
+ * If masking a latching input or holding a pin fails, the pins configured
+ * stay tracked, but that pin and the ones after it are not tracked as
+ * latched or held.
+ *
+ * @param snapshot Snapshot taken by gpio_snapshot_save().
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_STATE** if the snapshot is not valid (cold boot)
+ * - The first error of gpio_config(), gpio_intr_disable() or gpio_hold_en()
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_snapshot_restore(const gpio_snapshot_t *snapshot);
+
+#endif  // GPIO_SLEEP_H
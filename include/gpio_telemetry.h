@@ -0,0 +1,164 @@
+/**
+ * @file gpio_telemetry.h
+ * @brief Compact pin-state telemetry frames and their decoder.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * The encoder turns a stream of pin level snapshots, or of edge events, into
+ * frames that only carry what changed:
+ *
+ * - a keyframe holds the time, the reported pin mask and every level, and is
+ *   sent first and then every `keyframe_us` so a receiver can join the
+ *   stream or recover from a lost frame;
+ * - a delta frame holds the time since the previous frame and the mask of
+ *   the pins that toggled;
+ * - nothing is sent while no pin changes.
+ *
+ * Every field is a varint and the masks are packed onto the reported pins
+ * (8 reported pins take one byte, whatever their GPIO numbers), so a delta
+ * frame is usually 3 bytes. The decoder is plain C, for the gateway or host
+ * side:
+ *
+ * @code
+ * gpio_telemetry_enc_t enc;
+ * gpio_telemetry_init(&enc, (1ULL << D12) | (1ULL << D14), 1000000);
+ * ...
+ * uint8_t frame[GPIO_TELEMETRY_FRAME_MAX];
+ * size_t len;
+ * if (gpio_telemetry_poll(&enc, frame, sizeof(frame), &len) == ESP_OK && len)
+ *   send(frame, len);
+ * @endcode
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_TELEMETRY_H
+#define GPIO_TELEMETRY_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio_events.h"
+
+/**
+ * @brief Largest frame, in bytes.
+ */
+#define GPIO_TELEMETRY_FRAME_MAX 30
+
+/**
+ * @brief Encoder state of one telemetry stream.
+ */
+typedef struct
+{
+  uint64_t pin_mask;    /**< Pins reported */
+  uint64_t levels;      /**< Levels sent so far */
+  int64_t last_us;      /**< Time of the last frame */
+  int64_t key_us;       /**< Time of the last keyframe */
+  uint32_t keyframe_us; /**< Keyframe period */
+  bool started;         /**< A keyframe was sent */
+} gpio_telemetry_enc_t;
+
+/**
+ * @brief Decoder state of one telemetry stream.
+ */
+typedef struct
+{
+  uint64_t pin_mask; /**< Pins reported, from the last keyframe */
+  uint64_t levels;   /**< Levels after the last decoded frame */
+  int64_t time_us;   /**< Time of the last decoded frame */
+  bool synced;       /**< A keyframe was decoded */
+} gpio_telemetry_dec_t;
+
+/**
+ * @brief Set up an encoder.
+ *
+ * The levels of the reported pins are read now, with gpio_read_mask(): an
+ * edge event updates its own pin only, so the keyframes of
+ * gpio_telemetry_encode_event() start from them. Set up the pins first.
+ *
+ * @param enc Encoder to set up.
+ * @param pin_mask Pins to report (bit N is GPIO N).
+ * @param keyframe_us Time between two keyframes, in microseconds.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_telemetry_init(gpio_telemetry_enc_t *enc, uint64_t pin_mask,
+                              uint32_t keyframe_us);
+
+/**
+ * @brief Encode a snapshot of the pin levels.
+ *
+ * @param enc Encoder.
+ * @param time_us Time of the snapshot.
+ * @param levels Pin levels (bit N is GPIO N); pins not reported are ignored.
+ * @param buf Output buffer.
+ * @param size Size of @p buf, at least GPIO_TELEMETRY_FRAME_MAX.
+ * @param len Bytes written, 0 when there is nothing to send.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_SIZE** if @p buf is too small
+ */
+esp_err_t gpio_telemetry_encode(gpio_telemetry_enc_t *enc, int64_t time_us,
+                                uint64_t levels, uint8_t *buf, size_t size,
+                                size_t *len);
+
+/**
+ * @brief Encode an edge event of gpio_events.h.
+ *
+ * The event updates the level of its pin only, the others keep the levels
+ * read by gpio_telemetry_init() or set by the previous frames; events of
+ * pins not reported are skipped.
+ *
+ * @param enc Encoder.
+ * @param event Edge event.
+ * @param buf Output buffer.
+ * @param size Size of @p buf, at least GPIO_TELEMETRY_FRAME_MAX.
+ * @param len Bytes written, 0 when there is nothing to send.
+ * @return Same as gpio_telemetry_encode().
+ */
+esp_err_t gpio_telemetry_encode_event(gpio_telemetry_enc_t *enc,
+                                      const gpio_edge_event_t *event,
+                                      uint8_t *buf, size_t size, size_t *len);
+
+/**
+ * @brief Read the reported pins now and encode them.
+ *
+ * @param enc Encoder.
+ * @param buf Output buffer.
+ * @param size Size of @p buf, at least GPIO_TELEMETRY_FRAME_MAX.
+ * @param len Bytes written, 0 when there is nothing to send.
+ * @return Same as gpio_telemetry_encode().
+ */
+esp_err_t gpio_telemetry_poll(gpio_telemetry_enc_t *enc, uint8_t *buf,
+                              size_t size, size_t *len);
+
+/**
+ * @brief Set up a decoder; it waits for a keyframe.
+ *
+ * @param dec Decoder to set up.
+ */
+void gpio_telemetry_decoder_init(gpio_telemetry_dec_t *dec);
+
+/**
+ * @brief Decode one frame, updating the levels and time of the decoder.
+ *
+ * @param dec Decoder.
+ * @param buf Received bytes, starting with a frame.
+ * @param len Bytes available in @p buf.
+ * @param used Bytes of the frame, to skip to the next one.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_INVALID_SIZE** if the frame is truncated
+ * - **ESP_ERR_INVALID_STATE** for a delta frame before the first keyframe;
+ *   @p used is still set so it can be skipped
+ * - **ESP_ERR_INVALID_CRC** if the frame is malformed
+ */
+esp_err_t gpio_telemetry_decode(gpio_telemetry_dec_t *dec, const uint8_t *buf,
+                                size_t len, size_t *used);
+
+#endif  // GPIO_TELEMETRY_H
@@ -0,0 +1,123 @@
+/**
+ * @file gpio_timestamp.h
+ * @brief 64-bit cycle timestamps consistent across both cores.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * The cycle counter (CCOUNT) is the cheapest clock of the chip, but each core
+ * has its own, started when the core was: two ISRs on different cores cannot
+ * compare their counts. It is also 32 bits wide and wraps every 17 s at
+ * 240 MHz. esp_timer is shared and 64 bits wide, but takes hundreds of
+ * cycles to read and only resolves microseconds.
+ *
+ * With CONFIG_GPIO_DRIVERS_TIMESTAMP, gpio_ts_now() extends the counter of
+ * the calling core to 64 bits and adds the offset of that core, giving the
+ * CPU cycles since esp_timer started: one timescale for both cores, as fine
+ * as the counter. gpio_ts_init() measures the offset of each core against
+ * esp_timer, on the core (through esp_ipc), then an esp_timer callback
+ * measures it again every CONFIG_GPIO_DRIVERS_TIMESTAMP_SYNC_MS:
+ *
+ * - each measure reads esp_timer many times at spread sub-microsecond
+ *   phases and keeps the best, so its truncation cancels out and both cores
+ *   agree within a few cycles;
+ * - a timescale only moves forward by a measure, so gpio_ts_now() is
+ *   monotonic on each core; it steps only if the counter was not read for a
+ *   whole wrap or the CPU frequency changed, which the statistics count;
+ * - the cores still disagree by those few cycles, enough for a stamp taken
+ *   after one on the other core to read earlier. gpio_ts_now() keeps the
+ *   latest stamp handed out, with a 64-bit compare-and-swap (a critical
+ *   section on the ESP32), and raises a stamp behind it to it: stamps taken
+ *   one after the other never decrease, whatever the cores, and may be
+ *   equal. A raised stamp is late by the skew, counted as held by
+ *   gpio_ts_get_stats(). A step resets the latest stamp.
+ *
+ * The edge events of gpio_events.h are then stamped with gpio_ts_now(): the
+ * events of both cores sort in time order, to the cycle. The CPU frequency
+ * must stay fixed (hold an ESP_PM_CPU_FREQ_MAX lock with dynamic frequency
+ * scaling).
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_TIMESTAMP_H
+#define GPIO_TIMESTAMP_H
+
+#include <esp_err.h>
+#include <stdint.h>
+
+/**
+ * @brief Cores whose timescale is reported by gpio_ts_get_stats().
+ */
+#define GPIO_TS_MAX_CORES 2
+
+/**
+ * @brief State of the timestamp calibration.
+ */
+typedef struct
+{
+  uint32_t mhz;   /**< CPU cycles per microsecond of the timescale */
+  uint32_t syncs; /**< Calibrations of every core */
+  uint32_t steps; /**< Timescales moved by more than the measure error */
+  uint32_t held;  /**< Stamps raised to a later one of another core */
+  int32_t error[GPIO_TS_MAX_CORES]; /**< Last measure minus the timescale of
+                                         each core, in cycles */
+} gpio_ts_stats_t;
+
+/**
+ * @brief Calibrate every core and start the periodic calibration.
+ *
+ * Until then, gpio_ts_now() falls back to esp_timer. Call it again after
+ * changing the CPU frequency.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_TIMESTAMP is disabled
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_ts_init(void);
+
+/**
+ * @brief Calibrate every core now.
+ *
+ * Runs on each core in turn, with its interrupts masked for about 20 us.
+ * Not callable from an ISR.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_TIMESTAMP is disabled
+ * - **ESP_ERR_INVALID_STATE** if gpio_ts_init() was not called
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_ts_sync(void);
+
+/**
+ * @brief Current time, in CPU cycles since esp_timer started.
+ *
+ * Callable from ISRs (IRAM) and from either core. Never less than a stamp
+ * returned before on either core, unless a calibration stepped. Without
+ * CONFIG_GPIO_DRIVERS_TIMESTAMP, or before gpio_ts_init(), it is
+ * esp_timer_get_time() times the CPU frequency.
+ */
+uint64_t gpio_ts_now(void);
+
+/**
+ * @brief Split a timestamp into esp_timer microseconds and cycles.
+ *
+ * @param ts Timestamp from gpio_ts_now().
+ * @param cycles Where to store the cycles past the microsecond, or NULL.
+ * @return esp_timer time of the timestamp, in microseconds.
+ */
+int64_t gpio_ts_to_us(uint64_t ts, uint32_t *cycles);
+
+/**
+ * @brief Get the state of the calibration.
+ *
+ * @param stats Where to store the state.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_TIMESTAMP is disabled
+ */
+esp_err_t gpio_ts_get_stats(gpio_ts_stats_t *stats);
+
+#endif  // GPIO_TIMESTAMP_H
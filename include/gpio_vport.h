@@ -0,0 +1,180 @@
+/**
+ * @file gpio_vport.h
+ * @brief Virtual pins backed by external ports (expanders, shift registers).
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * A virtual port is a bank of up to 64 pins reached over a bus. Once
+ * registered, its pins get numbers from GPIO_VPIN_BASE up, so a gpio_t whose
+ * `pin` is GPIO_VPIN(port, bit) works with gpio_init_impl(), gpio_write(),
+ * gpio_read(), gpio_toggle() and the handle functions like a native pin:
+ *
+ * - writes only update a shadow of the outputs; gpio_vport_flush() sends
+ *   every change since the previous flush in one bus transaction;
+ * - reads return a cache of the inputs, refreshed from the bus when a port
+ *   interrupt line invalidated it (or on every read for ports without one).
+ *
+ * Virtual pins cannot have ISR handlers, and their reads may run a bus
+ * transaction: do not call them from ISRs.
+ *
+ * Only available when CONFIG_GPIO_DRIVERS_VPINS is enabled; otherwise
+ * gpio_vport_register() returns ESP_ERR_NOT_SUPPORTED.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_VPORT_H
+#define GPIO_VPORT_H
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Number of the first virtual pin, past every native pin mask bit.
+ */
+#define GPIO_VPIN_BASE 64
+
+/**
+ * @brief Pin number of bit @p bit of a registered virtual port.
+ */
+#define GPIO_VPIN(port, bit) ((gpio_pinout_t)((port)->base + (bit)))
+
+typedef struct gpio_vport gpio_vport_t;
+
+/**
+ * @brief Bus operations of a virtual port backend.
+ */
+typedef struct
+{
+  /**
+   * @brief Send the output levels and the directions to the port.
+   *
+   * @param port Virtual port.
+   * @param levels Output levels, bit N being pin N of the port.
+   * @param outputs Pins driven as outputs; the others are inputs.
+   * @return
+   * - **ESP_OK** on success
+   * - Bus errors
+   */
+  esp_err_t (*write)(gpio_vport_t *port, uint64_t levels, uint64_t outputs);
+
+  /**
+   * @brief Read the input levels of the port.
+   *
+   * @param port Virtual port.
+   * @param levels Where to store the levels, bit N being pin N of the port.
+   * @return
+   * - **ESP_OK** on success
+   * - Bus errors
+   */
+  esp_err_t (*read)(gpio_vport_t *port, uint64_t *levels);
+} gpio_vport_ops_t;
+
+/**
+ * @brief Bus transactions and cache use of a virtual port.
+ */
+typedef struct
+{
+  uint32_t writes;     /**< gpio_write/gpio_toggle calls on its pins */
+  uint32_t flushes;    /**< Bus write transactions */
+  uint32_t reads;      /**< Bus read transactions */
+  uint32_t cache_hits; /**< Pin reads served from the input cache */
+} gpio_vport_stats_t;
+
+/**
+ * @brief A virtual port, set up by its backend.
+ */
+struct gpio_vport
+{
+  const gpio_vport_ops_t *ops; /**< Backend bus operations */
+  uint64_t output_capable;     /**< Pins that can be outputs */
+  uint64_t input_capable;      /**< Pins that can be inputs */
+  uint8_t width;               /**< Number of pins, 1 to 64 */
+  bool cached;                 /**< Inputs kept until invalidated */
+
+  uint8_t base;                /**< First virtual pin, set by register */
+  uint64_t shadow;             /**< Output levels written so far */
+  uint64_t outputs;            /**< Pins configured as outputs */
+  uint64_t sent_shadow;        /**< Output levels of the last flush */
+  uint64_t sent_outputs;       /**< Directions of the last flush */
+  bool sent;                   /**< A flush reached the port */
+  uint64_t inputs;             /**< Input cache */
+  uint32_t inputs_valid;       /**< Input cache up to date (atomic) */
+  gpio_vport_stats_t stats;
+};
+
+/**
+ * @brief Give a range of virtual pin numbers to a port set up by a backend.
+ *
+ * @param port Virtual port, with ops, capabilities and width set.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - **ESP_ERR_NO_MEM** if CONFIG_GPIO_DRIVERS_VPIN_COUNT pins are taken
+ * - **ESP_ERR_NOT_SUPPORTED** if CONFIG_GPIO_DRIVERS_VPINS is disabled
+ */
+esp_err_t gpio_vport_register(gpio_vport_t *port);
+
+/**
+ * @brief Send the outputs and directions changed since the last flush, in
+ * one bus write; nothing is sent if they did not change.
+ *
+ * @param port Virtual port.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - Bus errors, the changes then stay pending
+ */
+esp_err_t gpio_vport_flush(gpio_vport_t *port);
+
+/**
+ * @brief Flush every registered virtual port.
+ *
+ * @return
+ * - **ESP_OK** on success
+ * - The first error of gpio_vport_flush()
+ */
+esp_err_t gpio_vport_flush_all(void);
+
+/**
+ * @brief Read the inputs of the port into its cache now.
+ *
+ * @param port Virtual port.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ * - Bus errors
+ */
+esp_err_t gpio_vport_refresh(gpio_vport_t *port);
+
+/**
+ * @brief Mark the input cache stale, e.g. from the ISR of the port interrupt
+ * line; the next pin read refreshes it. ISR safe.
+ *
+ * @param port Virtual port.
+ */
+void gpio_vport_invalidate(gpio_vport_t *port);
+
+/**
+ * @brief Get the virtual port of a pin.
+ *
+ * @param pin Virtual pin number.
+ * @return The port, NULL if the pin is not a registered virtual pin.
+ */
+gpio_vport_t *gpio_vport_from_pin(gpio_pinout_t pin);
+
+/**
+ * @brief Get the bus counters of a virtual port.
+ *
+ * @param port Virtual port.
+ * @param stats Where to store the counters.
+ * @return
+ * - **ESP_OK** on success
+ * - **ESP_ERR_INVALID_ARG** if the parameters are invalid
+ */
+esp_err_t gpio_vport_get_stats(gpio_vport_t *port, gpio_vport_stats_t *stats);
+
+#endif  // GPIO_VPORT_H
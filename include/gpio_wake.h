@@ -0,0 +1,125 @@
+/**
+ * @file gpio_wake.h
+ * @brief Sleep until an input pattern appears.
+ * @author Marcos Henrique Silveira Barbosa
+ *
+ * The chip sleeps until the inputs of a pattern match their expected levels.
+ * Wake-ups on a mismatch are rejected right away: in light sleep before the
+ * caller runs again, in deep sleep from the wake stub, before the bootloader
+ * and the application start.
+ *
+ * Deep sleep is not available on the `linux` target, where light sleep runs
+ * on the simulator.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_WAKE_H
+#define GPIO_WAKE_H
+
+#include <esp_attr.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+
+/**
+ * @brief Input pattern to wait for.
+ */
+typedef struct
+{
+  uint64_t pin_mask; /**< Inputs checked, registered by gpio_init_impl() */
+  uint64_t levels;   /**< Expected level of each checked input */
+} gpio_wake_pattern_t;
+
+/**
+ * @brief Check an input snapshot against a pattern.
+ */
+static inline bool gpio_wake_pattern_match(const gpio_wake_pattern_t *pattern,
+                                           uint64_t inputs)
+{
+  return ((inputs ^ pattern->levels) & pattern->pin_mask) == 0;
+}
+
+/**
+ * @brief ext1 wake-up condition: any of the pins high, or all of them low.
+ */
+typedef struct
+{
+  uint64_t pin_mask; /**< Pins of the condition (bit N is GPIO N) */
+  bool any_high;     /**< Any pin high if true, all pins low otherwise */
+} gpio_wake_ext1_t;
+
+/**
+ * @brief ext1 condition to sleep on until the inputs may match a pattern.
+ *
+ * ext1 cannot express a pattern with both levels, and re-arming on one
+ * that holds already wakes the chip again at once. The condition returned
+ * is false for @p inputs but must hold before the pattern can match: one of
+ * the inputs expected high and now low rises or, when every input expected
+ * high is, all the inputs expected low and now high fall. Inlined, so the
+ * wake stub can use it from RTC memory.
+ *
+ * @param pattern Pattern to wait for.
+ * @param inputs Input snapshot, not matching @p pattern.
+ * @return The condition, with no pins if @p inputs match.
+ */
+FORCE_INLINE_ATTR gpio_wake_ext1_t
+gpio_wake_ext1_next(const gpio_wake_pattern_t *pattern, uint64_t inputs)
+{
+  uint64_t to_rise = pattern->pin_mask & pattern->levels & ~inputs;
+  if (to_rise)
+    return (gpio_wake_ext1_t){.pin_mask = to_rise, .any_high = true};
+
+  return (gpio_wake_ext1_t){
+      .pin_mask = pattern->pin_mask & ~pattern->levels & inputs,
+      .any_high = false,
+  };
+}
+
+/**
+ * @brief Light-sleep until the inputs match a pattern.
+ *
+ * Every checked input is armed as a wake-up source on the level opposite to
+ * its current one, so any change wakes the chip; on a mismatch the inputs
+ * are re-armed and the chip goes back to sleep at once. The wake-up level is
+ * the interrupt type of the pin, so the CPU interrupts of the inputs are
+ * masked while armed. Before returning, their interrupt types are restored
+ * without what they latched during the sleep, and the inputs with an ISR
+ * handler are unmasked again.
+ *
+ * @param pattern Pattern to wait for.
+ * @param rejected Where to store the wake-ups rejected on a mismatch, or NULL.
+ * @return
+ * - **ESP_OK** once the inputs match
+ * - **ESP_ERR_INVALID_ARG** if a checked pin is not a registered input
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_wake_light_sleep(const gpio_wake_pattern_t *pattern,
+                                uint32_t *rejected);
+
+/**
+ * @brief Deep-sleep until the inputs match a pattern. Does not return,
+ * unless they match already.
+ *
+ * The checked inputs are switched to their RTC function, with their pulls,
+ * and the chip sleeps on the ext1 condition of gpio_wake_ext1_next() (RTC
+ * GPIOs only). With CONFIG_GPIO_DRIVERS_WAKE_STUB, the wake stub checks the
+ * full pattern and, on a mismatch, re-arms ext1 on the next condition and
+ * puts the chip back to sleep.
+ *
+ * @param pattern Pattern to wait for.
+ * @return
+ * - **ESP_OK** without sleeping if the inputs match already
+ * - **ESP_ERR_INVALID_ARG** if the pattern cannot be a wake-up source
+ * - **ESP_FAIL** on other errors
+ */
+esp_err_t gpio_wake_deep_sleep(const gpio_wake_pattern_t *pattern);
+
+/**
+ * @brief Number of deep-sleep wake-ups rejected by the wake stub since the
+ * last power-on.
+ */
+uint32_t gpio_wake_get_rejected(void);
+
+#endif  // GPIO_WAKE_H
@@ -0,0 +1,281 @@
+/**
+ * @file gpio_drivers_ll.h
+ * @brief Low-level register access shared by the GPIO driver modules.
+ *
+ * The ESP32 splits its GPIO matrix in two banks: GPIO 0-31 live in the
+ * `out`/`in`/`status` registers and GPIO 32-39 in the `out1`/`in1`/`status1`
+ * registers. Every helper here works on 64-bit pin masks where bit N is
+ * GPIO N, so callers never have to care about the split.
+ *
+ * On the `linux` target the registers are those of the host simulator
+ * (gpio_sim.h), so register accesses advance its virtual clock, and the
+ * driver critical sections map to the simulator ones instead of a spinlock.
+ * GPIO_DRV_CYCLES() is the cycle counter of the calling core: on the chip,
+ * the counters of both cores are not synchronized (see gpio_timestamp.h).
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_DRIVERS_LL_H
+#define GPIO_DRIVERS_LL_H
+
+#include <esp_attr.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include "gpio_sim.h"
+
+#define GPIO_DRV_REG_OUT_W1TS(v) gpio_sim_reg_write(GPIO_SIM_REG_OUT_W1TS, (v))
+#define GPIO_DRV_REG_OUT_W1TC(v) gpio_sim_reg_write(GPIO_SIM_REG_OUT_W1TC, (v))
+#define GPIO_DRV_REG_OUT1_W1TS(v) gpio_sim_reg_write(GPIO_SIM_REG_OUT1_W1TS, (v))
+#define GPIO_DRV_REG_OUT1_W1TC(v) gpio_sim_reg_write(GPIO_SIM_REG_OUT1_W1TC, (v))
+#define GPIO_DRV_REG_OUT() gpio_sim_reg_read(GPIO_SIM_REG_OUT)
+#define GPIO_DRV_REG_OUT1() gpio_sim_reg_read(GPIO_SIM_REG_OUT1)
+#define GPIO_DRV_REG_IN() gpio_sim_reg_read(GPIO_SIM_REG_IN)
+#define GPIO_DRV_REG_IN1() gpio_sim_reg_read(GPIO_SIM_REG_IN1)
+#define GPIO_DRV_REG_STATUS() gpio_sim_reg_read(GPIO_SIM_REG_STATUS)
+#define GPIO_DRV_REG_STATUS1() gpio_sim_reg_read(GPIO_SIM_REG_STATUS1)
+#define GPIO_DRV_REG_STATUS_W1TC(v)                                           \
+  gpio_sim_reg_write(GPIO_SIM_REG_STATUS_W1TC, (v))
+#define GPIO_DRV_REG_STATUS1_W1TC(v)                                          \
+  gpio_sim_reg_write(GPIO_SIM_REG_STATUS1_W1TC, (v))
+#define GPIO_DRV_CYCLES() gpio_sim_cycles()
+#define GPIO_DRV_CPU_MHZ() gpio_sim_get_cpu_freq()
+#define GPIO_DRV_IRQ_MASK() gpio_sim_irq_mask()
+#define GPIO_DRV_IRQ_RESTORE(state) gpio_sim_irq_restore(state)
+#define GPIO_DRV_TIME_US() gpio_sim_timer_us()
+#define GPIO_DRV_CORE_ID() ((int)gpio_sim_current_core())
+#define GPIO_DRV_RUN_ON_CORE(core, fn, arg)                                   \
+  gpio_sim_run_on_core((gpio_sim_core_t)(core), (fn), (arg))
+#define GPIO_DRV_SPIN(cycles) gpio_sim_advance(cycles)
+#define GPIO_DRV_CORES GPIO_SIM_CORE_MAX
+#define GPIO_DRV_CACHE_LINE 64
+
+typedef int gpio_drv_lock_t;
+#define GPIO_DRV_LOCK_INITIALIZER 0
+#define GPIO_DRV_ENTER_CRITICAL(lock) ((void)(lock), gpio_sim_critical_enter())
+#define GPIO_DRV_EXIT_CRITICAL(lock) ((void)(lock), gpio_sim_critical_exit())
+#else
+#include <esp_cpu.h>
+#include <esp_ipc.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <soc/gpio_struct.h>
+
+#define GPIO_DRV_REG_OUT_W1TS(v) (GPIO.out_w1ts = (v))
+#define GPIO_DRV_REG_OUT_W1TC(v) (GPIO.out_w1tc = (v))
+#define GPIO_DRV_REG_OUT1_W1TS(v) (GPIO.out1_w1ts.val = (v))
+#define GPIO_DRV_REG_OUT1_W1TC(v) (GPIO.out1_w1tc.val = (v))
+#define GPIO_DRV_REG_OUT() (GPIO.out)
+#define GPIO_DRV_REG_OUT1() (GPIO.out1.data)
+#define GPIO_DRV_REG_IN() (GPIO.in)
+#define GPIO_DRV_REG_IN1() (GPIO.in1.data)
+#define GPIO_DRV_REG_STATUS() (GPIO.status)
+#define GPIO_DRV_REG_STATUS1() (GPIO.status1.intr_st)
+#define GPIO_DRV_REG_STATUS_W1TC(v) (GPIO.status_w1tc = (v))
+#define GPIO_DRV_REG_STATUS1_W1TC(v) (GPIO.status1_w1tc.val = (v))
+#define GPIO_DRV_CYCLES() esp_cpu_get_cycle_count()
+#define GPIO_DRV_CPU_MHZ() esp_rom_get_cpu_ticks_per_us()
+#define GPIO_DRV_IRQ_MASK() portSET_INTERRUPT_MASK_FROM_ISR()
+#define GPIO_DRV_IRQ_RESTORE(state) portCLEAR_INTERRUPT_MASK_FROM_ISR(state)
+#define GPIO_DRV_TIME_US() esp_timer_get_time()
+#define GPIO_DRV_CORE_ID() esp_cpu_get_core_id()
+#define GPIO_DRV_RUN_ON_CORE(core, fn, arg)                                   \
+  esp_ipc_call_blocking((core), (fn), (arg))
+#define GPIO_DRV_SPIN(cycles)                                                 \
+  do                                                                          \
+  {                                                                           \
+    uint32_t spin_start_ = esp_cpu_get_cycle_count();                         \
+    while (esp_cpu_get_cycle_count() - spin_start_ < (cycles))                \
+      ;                                                                       \
+  } while (0)
+#define GPIO_DRV_CORES portNUM_PROCESSORS
+#define GPIO_DRV_CACHE_LINE 32
+
+typedef portMUX_TYPE gpio_drv_lock_t;
+#define GPIO_DRV_LOCK_INITIALIZER portMUX_INITIALIZER_UNLOCKED
+#define GPIO_DRV_ENTER_CRITICAL(lock) portENTER_CRITICAL_SAFE(lock)
+#define GPIO_DRV_EXIT_CRITICAL(lock) portEXIT_CRITICAL_SAFE(lock)
+#endif
+
+#define GPIO_DRV_BANK_WIDTH 32
+#define GPIO_DRV_BANK0_MASK 0x00000000FFFFFFFFULL
+#define GPIO_DRV_BANK1_MASK 0x000000FF00000000ULL
+
+/**
+ * @brief Read the cycle counter of the calling core.
+ */
+static inline uint32_t IRAM_ATTR gpio_drv_ll_cycles(void)
+{
+  return GPIO_DRV_CYCLES();
+}
+
+/**
+ * @brief Mask interrupts on the calling core.
+ *
+ * @return Previous interrupt state, to be given to gpio_drv_ll_irq_restore().
+ */
+static inline uint32_t IRAM_ATTR gpio_drv_ll_irq_mask(void)
+{
+  return GPIO_DRV_IRQ_MASK();
+}
+
+/**
+ * @brief Restore the interrupt state saved by gpio_drv_ll_irq_mask().
+ */
+static inline void IRAM_ATTR gpio_drv_ll_irq_restore(uint32_t state)
+{
+  GPIO_DRV_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Issue the W1TS/W1TC stores of gpio_drv_ll_write() without masking
+ * interrupts, for callers already in a critical section.
+ */
+static inline void IRAM_ATTR gpio_drv_ll_store(uint64_t set_mask,
+                                               uint64_t clr_mask)
+{
+  uint32_t set0 = (uint32_t)set_mask;
+  uint32_t set1 = (uint32_t)(set_mask >> GPIO_DRV_BANK_WIDTH);
+  uint32_t clr0 = (uint32_t)clr_mask;
+  uint32_t clr1 = (uint32_t)(clr_mask >> GPIO_DRV_BANK_WIDTH);
+
+  if (set0)
+    GPIO_DRV_REG_OUT_W1TS(set0);
+  if (set1)
+    GPIO_DRV_REG_OUT1_W1TS(set1);
+  if (clr0)
+    GPIO_DRV_REG_OUT_W1TC(clr0);
+  if (clr1)
+    GPIO_DRV_REG_OUT1_W1TC(clr1);
+}
+
+/**
+ * @brief Drive the pins in @p set_mask high and the pins in @p clr_mask low.
+ *
+ * Uses the W1TS/W1TC registers, so pins outside both masks are untouched and
+ * no read-modify-write is needed. The stores are always issued in the same
+ * order (bank 0 set, bank 1 set, bank 0 clear, bank 1 clear) so pins changing
+ * in the same direction on both banks are one store apart, and stores with an
+ * empty mask are skipped. Interrupts are masked only around the stores.
+ *
+ * @return Cycles spent issuing the stores (the worst-case skew between the
+ * first and the last pin to change) when CONFIG_GPIO_DRIVERS_SKEW_TRACE is
+ * enabled, 0 otherwise.
+ */
+static inline uint32_t IRAM_ATTR gpio_drv_ll_write(uint64_t set_mask,
+                                                   uint64_t clr_mask)
+{
+  uint32_t skew = 0;
+
+  uint32_t irq = gpio_drv_ll_irq_mask();
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+  skew = gpio_drv_ll_cycles();
+#endif
+  gpio_drv_ll_store(set_mask, clr_mask);
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+  skew = gpio_drv_ll_cycles() - skew;
+#endif
+  gpio_drv_ll_irq_restore(irq);
+
+  return skew;
+}
+
+/**
+ * @brief Snapshot the input level of every GPIO.
+ */
+static inline uint64_t IRAM_ATTR gpio_drv_ll_read(void)
+{
+  uint64_t bank1 = GPIO_DRV_REG_IN1();
+  return (bank1 << GPIO_DRV_BANK_WIDTH) | GPIO_DRV_REG_IN();
+}
+
+/**
+ * @brief Snapshot the output register of every GPIO.
+ */
+static inline uint64_t IRAM_ATTR gpio_drv_ll_read_outputs(void)
+{
+  uint64_t bank1 = GPIO_DRV_REG_OUT1();
+  return (bank1 << GPIO_DRV_BANK_WIDTH) | GPIO_DRV_REG_OUT();
+}
+
+/**
+ * @brief Drive a single pin with one store to its bank's W1TS or W1TC register.
+ */
+static inline void IRAM_ATTR gpio_drv_ll_write_pin(uint32_t pin, uint32_t level)
+{
+  if (pin < GPIO_DRV_BANK_WIDTH)
+  {
+    if (level)
+      GPIO_DRV_REG_OUT_W1TS(1UL << pin);
+    else
+      GPIO_DRV_REG_OUT_W1TC(1UL << pin);
+  }
+  else
+  {
+    if (level)
+      GPIO_DRV_REG_OUT1_W1TS(1UL << (pin - GPIO_DRV_BANK_WIDTH));
+    else
+      GPIO_DRV_REG_OUT1_W1TC(1UL << (pin - GPIO_DRV_BANK_WIDTH));
+  }
+}
+
+/**
+ * @brief Read the input level of a single pin from its bank only.
+ */
+static inline uint32_t IRAM_ATTR gpio_drv_ll_read_pin(uint32_t pin)
+{
+  if (pin < GPIO_DRV_BANK_WIDTH)
+    return (GPIO_DRV_REG_IN() >> pin) & 1;
+
+  return (GPIO_DRV_REG_IN1() >> (pin - GPIO_DRV_BANK_WIDTH)) & 1;
+}
+
+/**
+ * @brief Read the output register bit of a single pin from its bank only.
+ */
+static inline uint32_t IRAM_ATTR gpio_drv_ll_read_output_pin(uint32_t pin)
+{
+  if (pin < GPIO_DRV_BANK_WIDTH)
+    return (GPIO_DRV_REG_OUT() >> pin) & 1;
+
+  return (GPIO_DRV_REG_OUT1() >> (pin - GPIO_DRV_BANK_WIDTH)) & 1;
+}
+
+/**
+ * @brief Snapshot the interrupt status latch of the pins in @p mask.
+ *
+ * Only the banks @p mask touches are read: with a constant mask, a single
+ * register read when every pin is in the same bank.
+ */
+static inline uint64_t IRAM_ATTR gpio_drv_ll_intr_status(uint64_t mask)
+{
+  uint64_t status = 0;
+
+  if (mask & GPIO_DRV_BANK0_MASK)
+    status |= GPIO_DRV_REG_STATUS();
+  if (mask & GPIO_DRV_BANK1_MASK)
+    status |= (uint64_t)GPIO_DRV_REG_STATUS1() << GPIO_DRV_BANK_WIDTH;
+
+  return status & mask;
+}
+
+/**
+ * @brief Clear the interrupt status latch of the pins in @p mask.
+ */
+static inline void IRAM_ATTR gpio_drv_ll_intr_clear(uint64_t mask)
+{
+  uint32_t mask0 = (uint32_t)mask;
+  uint32_t mask1 = (uint32_t)(mask >> GPIO_DRV_BANK_WIDTH);
+
+  if (mask0)
+    GPIO_DRV_REG_STATUS_W1TC(mask0);
+  if (mask1)
+    GPIO_DRV_REG_STATUS1_W1TC(mask1);
+}
+
+#endif  // GPIO_DRIVERS_LL_H
@@ -0,0 +1,314 @@
+/**
+ * @file gpio_drivers_priv.h
+ * @brief Internal hooks shared between the GPIO driver modules.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_DRIVERS_PRIV_H
+#define GPIO_DRIVERS_PRIV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio_drivers.h"
+#include "sdkconfig.h"
+
+#ifndef CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL
+#define CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL 3
+#endif
+
+#if CONFIG_GPIO_DRIVERS_DEFERRED_LOG
+#include "gpio_log.h"
+
+// Driver logs only store a few integers and are written later by the flush
+// task, so the configuration paths can run on hot paths and in ISRs
+#define GPIO_DRV_LOG(level, tag, format, ...)                                 \
+  GPIO_LOG_DEFERRED(level, tag, format, ##__VA_ARGS__)
+#else
+#include <esp_log.h>
+
+#define GPIO_DRV_LOG(level, tag, format, ...)                                 \
+  ESP_LOG_LEVEL_LOCAL(level, tag, format, ##__VA_ARGS__)
+#endif
+
+// Levels above CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL leave no code nor string
+#if CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL >= 1
+#define GPIO_DRV_LOGE(tag, format, ...)                                       \
+  GPIO_DRV_LOG(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#else
+#define GPIO_DRV_LOGE(tag, format, ...) ((void)(tag))
+#endif
+
+#if CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL >= 2
+#define GPIO_DRV_LOGW(tag, format, ...)                                       \
+  GPIO_DRV_LOG(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#else
+#define GPIO_DRV_LOGW(tag, format, ...) ((void)(tag))
+#endif
+
+#if CONFIG_GPIO_DRIVERS_LOG_MAX_LEVEL >= 3
+#define GPIO_DRV_LOGI(tag, format, ...)                                       \
+  GPIO_DRV_LOG(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#else
+#define GPIO_DRV_LOGI(tag, format, ...) ((void)(tag))
+#endif
+
+#if CONFIG_GPIO_DRIVERS_FAST_ISR
+// The trampolines and the ISR service share the GPIO interrupt
+#define GPIO_DRV_ISR_FLAG_SHARED ESP_INTR_FLAG_SHARED
+#else
+#define GPIO_DRV_ISR_FLAG_SHARED 0
+#endif
+
+#if CONFIG_GPIO_DRIVERS_EVLOG
+// The event log erases and writes flash with the cache off for up to
+// hundreds of ms: the GPIO interrupt must stay enabled meanwhile, or the
+// edges merge in the status register. Its whole path, from the ISR service
+// to gpio_isr_dispatch() and the handlers, is then in IRAM and DRAM
+#define GPIO_DRV_ISR_FLAG_IRAM ESP_INTR_FLAG_IRAM
+#else
+#define GPIO_DRV_ISR_FLAG_IRAM 0
+#endif
+
+#define GPIO_DRV_ISR_FLAGS (GPIO_DRV_ISR_FLAG_SHARED | GPIO_DRV_ISR_FLAG_IRAM)
+
+/**
+ * @brief Install the ISR service with GPIO_DRV_ISR_FLAGS, if no one did.
+ */
+esp_err_t gpio_drv_isr_service_install(void);
+
+#if CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Forget the installed ISR service, as a reboot would, after
+ * gpio_sim_reset() removed it, so the host benchmarks install it again.
+ */
+void gpio_drv_isr_service_reset(void);
+#endif
+
+#if CONFIG_GPIO_DRIVERS_SKEW_TRACE
+/**
+ * @brief Account the skew, in cycles, of one multi-pin register write.
+ */
+void gpio_drv_skew_record(uint32_t cycles);
+#else
+#define gpio_drv_skew_record(cycles) ((void)(cycles))
+#endif
+
+#if CONFIG_GPIO_DRIVERS_METRICS
+#include "gpio_drivers_ll.h"
+
+/**
+ * @brief Per-core copy of the counters of one pin, alone in its cache line so
+ * the cores never write to the same line.
+ */
+typedef union
+{
+  gpio_metrics_t counters;
+  uint8_t line[GPIO_DRV_CACHE_LINE];
+} __attribute__((aligned(GPIO_DRV_CACHE_LINE))) gpio_drv_metrics_slot_t;
+
+extern gpio_drv_metrics_slot_t gpio_drv_metrics[GPIO_DRV_CORES][GPIO_NUM_MAX];
+
+/**
+ * @brief Count one operation of a pin on the calling core.
+ *
+ * No atomic: each core owns its slot. An ISR preempting the increment of the
+ * same counter on the same core may make it miss one count.
+ */
+#define gpio_drv_metric_inc(pin, field)                                       \
+  do                                                                          \
+  {                                                                           \
+    if ((unsigned)(pin) < GPIO_NUM_MAX)                                       \
+      gpio_drv_metrics[GPIO_DRV_CORE_ID()][(pin)].counters.field++;           \
+  } while (0)
+#else
+#define gpio_drv_metric_inc(pin, field) ((void)0)
+#endif
+
+/**
+ * @brief Pin configuration applied by the driver, one bit per GPIO.
+ */
+typedef struct
+{
+  uint64_t inputs;     /**< Pins configured as inputs */
+  uint64_t outputs;    /**< Pins configured as outputs */
+  uint64_t pull_ups;   /**< Pins with the pull-up enabled */
+  uint64_t pull_downs; /**< Pins with the pull-down enabled */
+  uint64_t holds;      /**< Pins held by gpio_set_hold() */
+  uint64_t isrs;       /**< Inputs with an ISR handler added */
+  uint64_t latches;    /**< Inputs latching edges for gpio_poll_edges() */
+  uint8_t intr_type[GPIO_NUM_MAX]; /**< gpio_int_type_t of each pin */
+} gpio_drv_config_t;
+
+/**
+ * @brief Configure pins as outputs with one gpio_config() call, and track
+ * them for the sleep snapshots.
+ *
+ * @param pin_mask Pins to configure (bit N is GPIO N).
+ * @param readback Keep the input enabled too, so the input register reads
+ * back the driven levels.
+ * @return
+ * - **ESP_OK** on success
+ * - The error of gpio_config() otherwise
+ */
+esp_err_t gpio_drv_config_outputs(uint64_t pin_mask, bool readback);
+
+/**
+ * @brief Copy the pin configuration applied by the driver.
+ */
+void gpio_drv_get_config(gpio_drv_config_t *config);
+
+/**
+ * @brief Replace the pin configuration tracked by the driver, after the pins
+ * were set up behind its back (snapshot restore).
+ */
+void gpio_drv_set_config(const gpio_drv_config_t *config);
+
+#if CONFIG_GPIO_DRIVERS_DEFERRED_LOG
+/**
+ * @brief Occupancy of the deferred log ring, sampled at each flush.
+ */
+void gpio_drv_log_pool_stats(gpio_pool_stats_t *stats);
+#endif
+
+#if CONFIG_GPIO_DRIVERS_DEBOUNCE
+/**
+ * @brief Account an edge of an input in its debounce, from its ISR.
+ *
+ * @return true if the edge falls in the debounce window and must be dropped.
+ */
+bool gpio_drv_debounce(uint32_t pin);
+#endif
+
+#if CONFIG_GPIO_DRIVERS_EDGE_EVENTS
+/**
+ * @brief Record an edge of an input, from its ISR.
+ */
+void gpio_drv_event_push(uint32_t pin, uint32_t level);
+
+/**
+ * @brief Occupancy of the edge event ring, sampled at each pop.
+ */
+void gpio_drv_event_pool_stats(gpio_pool_stats_t *stats);
+#endif
+
+#if CONFIG_GPIO_DRIVERS_EVLOG && CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Forget the mounted event log partition and its RAM page, as a
+ * reboot would, so the host benchmarks can mount a fresh one.
+ */
+void gpio_drv_evlog_unmount(void);
+#endif
+
+/**
+ * @brief Operations of a pin backend, on the pin numbers it owns.
+ *
+ * gpio_drivers.c routes each pin number to its backend: the native GPIOs
+ * (the simulator registers on the host), and the virtual pins with
+ * CONFIG_GPIO_DRIVERS_VPINS. With one backend built the calls are direct;
+ * with several, a table indexed by pin range picks the backend.
+ */
+typedef struct
+{
+  /** Set up a pin object, see gpio_init_impl() and gpio_attach_impl() */
+  esp_err_t (*init)(gpio_t *self, bool log, bool configure);
+  /** Drive a pin, ESP_ERR_INVALID_ARG if the backend has no such pin */
+  esp_err_t (*write)(uint32_t pin, uint32_t level);
+  /** Read a pin, 0 if the backend has no such pin */
+  uint32_t (*read)(uint32_t pin);
+  /** Toggle a pin, nothing if the backend has no such pin */
+  void (*toggle)(uint32_t pin);
+} gpio_drv_backend_t;
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+#define GPIO_DRV_BACKENDS 2
+#else
+#define GPIO_DRV_BACKENDS 1
+#endif
+
+#if CONFIG_GPIO_DRIVERS_FAST_ISR
+#include "gpio_drivers_ll.h"
+
+// X-macro callbacks of GPIO_DRV_FAST_ISR_DEFINE(), for entries
+// X(pin, handler, arg) of a list like GPIO_FAST_ISR_PINS
+#define GPIO_DRV_FAST_ISR_TRAMPOLINE(pin, handler, arg)                       \
+  static inline void IRAM_ATTR gpio_drv_fast_isr_##pin(void)                  \
+  {                                                                           \
+    gpio_drv_ll_intr_clear(1ULL << (pin));                                    \
+    handler(arg);                                                             \
+  }
+#define GPIO_DRV_FAST_ISR_BIT(pin, handler, arg) | (1ULL << (pin))
+#define GPIO_DRV_FAST_ISR_CALL(pin, handler, arg)                             \
+  if (status & (1ULL << (pin)))                                               \
+    gpio_drv_fast_isr_##pin();
+
+/**
+ * @brief Define the trampolines of an X-macro pin list, the mask of its
+ * pins, `<name>_mask`, and the interrupt entry `<name>` running them.
+ *
+ * One list per translation unit: the trampolines are named after the pins.
+ */
+#define GPIO_DRV_FAST_ISR_DEFINE(name, LIST)                                  \
+  LIST(GPIO_DRV_FAST_ISR_TRAMPOLINE)                                          \
+  static const uint64_t name##_mask = 0 LIST(GPIO_DRV_FAST_ISR_BIT);          \
+  static void IRAM_ATTR name(void *unused)                                    \
+  {                                                                           \
+    (void)unused;                                                             \
+    uint64_t status = gpio_drv_ll_intr_status(name##_mask);                   \
+    LIST(GPIO_DRV_FAST_ISR_CALL)                                              \
+  }
+
+/**
+ * @brief Register an entry defined by GPIO_DRV_FAST_ISR_DEFINE() on the
+ * GPIO interrupt, after the ISR service.
+ */
+esp_err_t gpio_drv_fast_isr_register(void (*entry)(void *), uint64_t mask);
+#endif
+
+#if CONFIG_GPIO_DRIVERS_VPINS
+#include "gpio_vport.h"
+
+#define GPIO_DRV_IS_VPIN(pin) ((unsigned)(pin) >= GPIO_VPIN_BASE)
+
+/**
+ * @brief Backend of the virtual pins, from GPIO_VPIN_BASE up.
+ */
+extern const gpio_drv_backend_t gpio_drv_vport_backend;
+
+/**
+ * @brief Snapshot the output levels and directions of a virtual port.
+ *
+ * @return true if they differ from the last flush.
+ */
+bool gpio_drv_vport_pending(gpio_vport_t *port, uint64_t *levels,
+                            uint64_t *outputs);
+
+/**
+ * @brief Record a flush of a virtual port done outside gpio_vport_flush().
+ */
+void gpio_drv_vport_sent(gpio_vport_t *port, uint64_t levels,
+                         uint64_t outputs);
+
+/**
+ * @brief Store the inputs of a virtual port read outside
+ * gpio_vport_refresh(), marking its cache valid.
+ */
+void gpio_drv_vport_received(gpio_vport_t *port, uint64_t levels);
+
+#if CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Forget every registered virtual port, as a reboot would, so the
+ * host benchmarks can register fresh ones.
+ */
+void gpio_drv_vport_reset(void);
+
+/**
+ * @brief Forget every shift-register chain, with gpio_drv_vport_reset().
+ */
+void gpio_drv_shiftreg_reset(void);
+#endif
+#endif
+
+#endif  // GPIO_DRIVERS_PRIV_H
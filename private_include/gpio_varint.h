@@ -0,0 +1,87 @@
+/**
+ * @file gpio_varint.h
+ * @brief Variable-length integer coding shared by the driver encoders.
+ *
+ * LEB128: seven bits per byte, least significant group first, the high bit
+ * set on every byte but the last. Small values, such as the time deltas of
+ * close edges, take one or two bytes instead of eight.
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ */
+
+#ifndef GPIO_VARINT_H
+#define GPIO_VARINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Longest encoding of a 64-bit value, in bytes.
+ */
+#define GPIO_VARINT_MAX 10
+
+/**
+ * @brief Encode a value.
+ *
+ * @param buf Output, with room for GPIO_VARINT_MAX bytes.
+ * @param value Value to encode.
+ * @return Number of bytes written.
+ */
+static inline size_t gpio_varint_put(uint8_t *buf, uint64_t value)
+{
+  size_t len = 0;
+
+  while (value >= 0x80)
+  {
+    buf[len++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buf[len++] = (uint8_t)value;
+
+  return len;
+}
+
+/**
+ * @brief Decode a value.
+ *
+ * @param buf Encoded bytes.
+ * @param len Bytes available in @p buf.
+ * @param value Where to store the value.
+ * @return Number of bytes read, 0 if the encoding is truncated or too long.
+ */
+static inline size_t gpio_varint_get(const uint8_t *buf, size_t len,
+                                     uint64_t *value)
+{
+  uint64_t result = 0;
+
+  for (size_t i = 0; i < len && i < GPIO_VARINT_MAX; i++)
+  {
+    result |= (uint64_t)(buf[i] & 0x7F) << (7 * i);
+    if (!(buf[i] & 0x80))
+    {
+      *value = result;
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Map a signed value to an unsigned one, small magnitudes first.
+ */
+static inline uint64_t gpio_varint_zigzag(int64_t value)
+{
+  return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+/**
+ * @brief Inverse of gpio_varint_zigzag().
+ */
+static inline int64_t gpio_varint_unzigzag(uint64_t value)
+{
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+#endif  // GPIO_VARINT_H